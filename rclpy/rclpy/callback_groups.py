@@ -12,9 +12,11 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
-from threading import Lock
+from typing import Optional
 import weakref
 
+from rclpy.impl.implementation_singleton import rclpy_implementation as _rclpy
+
 
 class CallbackGroup:
     """
@@ -25,11 +27,16 @@ class CallbackGroup:
     This class should not be instantiated.
     Instead, classes should extend it and implement :meth:`can_execute`,
     :meth:`beginning_execution`, and :meth:`ending_execution`.
+
+    The groups provided by rclpy keep their execution state in a native object, which the
+    native executor cores claim and release directly instead of calling these methods.
     """
 
     def __init__(self) -> None:
         super().__init__()
         self.entities: set = set()
+        # Native execution state, None for groups implementing the methods in Python
+        self._state: Optional[_rclpy.CallbackGroupState] = None
 
     def add_entity(self, entity) -> None:
         """
@@ -80,6 +87,10 @@ class CallbackGroup:
 class ReentrantCallbackGroup(CallbackGroup):
     """Allow callbacks to be executed in parallel without restriction."""
 
+    def __init__(self):
+        super().__init__()
+        self._state = _rclpy.CallbackGroupState(False)
+
     def can_execute(self, entity):
         return True
 
@@ -95,23 +106,14 @@ class MutuallyExclusiveCallbackGroup(CallbackGroup):
 
     def __init__(self):
         super().__init__()
-        self._active_entity = None
-        self._lock = Lock()
+        # Claimed atomically with the id of the executing entity, no lock is needed
+        self._state = _rclpy.CallbackGroupState(True)
 
     def can_execute(self, entity):
-        with self._lock:
-            assert weakref.ref(entity) in self.entities
-            return self._active_entity is None
+        return self._state.can_execute()
 
     def beginning_execution(self, entity):
-        with self._lock:
-            assert weakref.ref(entity) in self.entities
-            if self._active_entity is None:
-                self._active_entity = entity
-                return True
-        return False
+        return self._state.beginning_execution(entity)
 
     def ending_execution(self, entity):
-        with self._lock:
-            assert self._active_entity == entity
-            self._active_entity = None
+        self._state.ending_execution(entity)
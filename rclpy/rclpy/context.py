@@ -48,11 +48,31 @@ class Context(ContextManager['Context']):
         self._callbacks = []
         self._logging_initialized = False
         self.__context = None
+        self.__intra_process_manager = None
+        self.__shared_subscription_manager = None
 
     @property
     def handle(self):
         return self.__context
 
+    @property
+    def intra_process_manager(self):
+        """Get the manager of the intra-process communication of the context."""
+        from rclpy.intra_process_manager import IntraProcessManager
+        with self._lock:
+            if self.__intra_process_manager is None:
+                self.__intra_process_manager = IntraProcessManager()
+            return self.__intra_process_manager
+
+    @property
+    def shared_subscription_manager(self):
+        """Get the manager of the subscriptions of the context sharing a middleware reader."""
+        from rclpy.shared_subscription import SharedSubscriptionManager
+        with self._lock:
+            if self.__shared_subscription_manager is None:
+                self.__shared_subscription_manager = SharedSubscriptionManager()
+            return self.__shared_subscription_manager
+
     def destroy(self):
         self.__context.destroy_when_not_in_use()
 
@@ -91,6 +91,7 @@ class EventHandler(Waitable):
 
         self._ready_to_take_data = False
         self._event_index = None
+        self._in_events_queue = False
 
     # Start Waitable API
     def is_ready(self, wait_set):
@@ -103,7 +104,7 @@ class EventHandler(Waitable):
 
     def take_data(self):
         """Take stuff from lower level so the wait set doesn't immediately wake again."""
-        if self._ready_to_take_data:
+        if self._ready_to_take_data or self._in_events_queue:
             self._ready_to_take_data = False
             with self.__event:
                 return self.__event.take_event()
@@ -124,6 +125,18 @@ class EventHandler(Waitable):
         with self.__event:
             self._event_index = wait_set.add_event(self.__event)
 
+    def add_to_events_queue(self, events_queue, waitable_id):
+        """Push the identifier to the events queue when the event occurs."""
+        with self.__event:
+            events_queue.add_event(self.__event, waitable_id)
+        self._in_events_queue = True
+        return True
+
+    def remove_from_events_queue(self, events_queue, waitable_id):
+        """Stop pushing to the events queue, the event is waited on with a wait set again."""
+        events_queue.remove(waitable_id)
+        self._in_events_queue = False
+
     def __enter__(self):
         """Mark event as in-use to prevent destruction while waiting on it."""
         self.__event.__enter__()
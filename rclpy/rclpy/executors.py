@@ -14,17 +14,21 @@
 
 from concurrent.futures import ThreadPoolExecutor
 from contextlib import ExitStack
+from functools import partial
 import inspect
 import os
 from threading import Condition
+from threading import current_thread
 from threading import Lock
 from threading import RLock
+from threading import Thread
 import time
 from types import TracebackType
 from typing import Any
 from typing import Callable
 from typing import ContextManager
 from typing import Coroutine
+from typing import Dict
 from typing import Generator
 from typing import List
 from typing import Optional
@@ -36,7 +40,11 @@ from typing import TypeVar
 from typing import Union
 
 import warnings
+import weakref
 
+from rclpy.callback_groups import CallbackGroup
+from rclpy.callback_groups import MutuallyExclusiveCallbackGroup
+from rclpy.callback_groups import ReentrantCallbackGroup
 from rclpy.client import Client
 from rclpy.clock import Clock
 from rclpy.clock import ClockType
@@ -111,6 +119,39 @@ async def await_or_execute(callback: Union[Callable, Coroutine], *args) -> Any:
         return callback(*args)
 
 
+async def _await_and_release(callback: Callable, msg, *args) -> Any:
+    """Await a coroutine callback with a loaned message and release the message afterwards."""
+    try:
+        return await callback(msg, *args)
+    finally:
+        msg.release()
+
+
+def _get_default_num_threads() -> int:
+    """Get the number of CPUs the process may run on, or 2 if the OS doesn't tell."""
+    # On Linux, it will try to use the number of CPU this process has access to.
+    # Other platforms, os.sched_getaffinity() doesn't exist so we use the number of CPUs.
+    if hasattr(os, 'sched_getaffinity'):
+        num_threads = len(os.sched_getaffinity(0))
+    else:
+        num_threads = os.cpu_count()
+    # The calls above may still return None if they aren't supported
+    if num_threads is None:
+        num_threads = 2
+    return num_threads
+
+
+def _get_native_group_state(group: CallbackGroup) -> Optional[_rclpy.CallbackGroupState]:
+    """
+    Get the native execution state of a callback group provided by rclpy.
+
+    :return: The state, or ``None`` if the group may implement its methods in Python.
+    """
+    if type(group) in (MutuallyExclusiveCallbackGroup, ReentrantCallbackGroup):
+        return group._state
+    return None
+
+
 class TimeoutException(Exception):
     """Signal that a timeout occurred."""
 
@@ -366,7 +407,25 @@ class Executor(ContextManager['Executor']):
     def _take_subscription(self, sub):
         try:
             with sub.handle:
-                msg_info = sub.handle.take_message(sub.msg_type, sub.raw)
+                if sub.loaned_messages:
+                    msg_info = sub.handle.take_loaned_message(sub.msg_type)
+                elif sub.reused_message is not None:
+                    info = sub.handle.take_message_into(sub.reused_message)
+                    msg_info = None if info is None else (sub.reused_message, info)
+                elif sub.lazy:
+                    msg_info = sub.handle.take_message(sub.msg_type, True)
+                    if msg_info is not None:
+                        msg_info = (_rclpy.LazyMessage(msg_info[0], sub.msg_type), msg_info[1])
+                elif sub.columns is not None:
+                    rows, timestamps = sub.columns
+                    n = sub.handle.take_messages_into_array(rows, timestamps)
+                    msg_info = (rows[:n], timestamps[:n]) if n else None
+                elif sub.array_views:
+                    msg_info = sub.handle.take_message_with_array_views(sub.msg_type)
+                elif sub.max_batch_size is None:
+                    msg_info = sub.handle.take_message(sub.msg_type, sub.raw)
+                else:
+                    msg_info = sub.handle.take_messages(sub.msg_type, sub.max_batch_size, sub.raw)
                 if msg_info is None:
                     return None
 
@@ -376,7 +435,12 @@ class Executor(ContextManager['Executor']):
                     msg_tuple = msg_info
 
                 async def _execute():
-                    await await_or_execute(sub.callback, *msg_tuple)
+                    try:
+                        await await_or_execute(sub.callback, *msg_tuple)
+                    finally:
+                        if sub.loaned_messages:
+                            # Return the loan, the message is only valid during the callback
+                            msg_info[0].release()
 
                 return _execute
         except InvalidHandle:
@@ -568,7 +632,9 @@ class Executor(ContextManager['Executor']):
             services: List[Service] = []
             waitables: List[Waitable] = []
             for node in nodes_to_use:
-                subscriptions.extend(filter(self.can_execute, node.subscriptions))
+                # Shared subscriptions are executed through the waitable of their group
+                subscriptions.extend(
+                    sub for sub in node.subscriptions if not sub.shared and self.can_execute(sub))
                 timers.extend(filter(self.can_execute, node.timers))
                 clients.extend(filter(self.can_execute, node.clients))
                 services.extend(filter(self.can_execute, node.services))
@@ -591,43 +657,44 @@ class Executor(ContextManager['Executor']):
             # Construct a wait set
             wait_set = None
             with ExitStack() as context_stack:
-                sub_handles = []
+                # Entities in the same order as their index in the wait set
+                subs_waited = []
                 for sub in subscriptions:
                     try:
                         context_stack.enter_context(sub.handle)
-                        sub_handles.append(sub.handle)
+                        subs_waited.append(sub)
                     except InvalidHandle:
                         entity_count.num_subscriptions -= 1
 
-                client_handles = []
+                clients_waited = []
                 for cli in clients:
                     try:
                         context_stack.enter_context(cli.handle)
-                        client_handles.append(cli.handle)
+                        clients_waited.append(cli)
                     except InvalidHandle:
                         entity_count.num_clients -= 1
 
-                service_handles = []
+                services_waited = []
                 for srv in services:
                     try:
                         context_stack.enter_context(srv.handle)
-                        service_handles.append(srv.handle)
+                        services_waited.append(srv)
                     except InvalidHandle:
                         entity_count.num_services -= 1
 
-                timer_handles = []
+                timers_waited = []
                 for tmr in timers:
                     try:
                         context_stack.enter_context(tmr.handle)
-                        timer_handles.append(tmr.handle)
+                        timers_waited.append(tmr)
                     except InvalidHandle:
                         entity_count.num_timers -= 1
 
-                guard_handles = []
+                guards_waited = []
                 for gc in guards:
                     try:
                         context_stack.enter_context(gc.handle)
-                        guard_handles.append(gc.handle)
+                        guards_waited.append(gc)
                     except InvalidHandle:
                         entity_count.num_guard_conditions -= 1
 
@@ -650,16 +717,16 @@ class Executor(ContextManager['Executor']):
                     self._context.handle)
 
                 wait_set.clear_entities()
-                for sub_handle in sub_handles:
-                    wait_set.add_subscription(sub_handle)
-                for cli_handle in client_handles:
-                    wait_set.add_client(cli_handle)
-                for srv_capsule in service_handles:
-                    wait_set.add_service(srv_capsule)
-                for tmr_handle in timer_handles:
-                    wait_set.add_timer(tmr_handle)
-                for gc_handle in guard_handles:
-                    wait_set.add_guard_condition(gc_handle)
+                for sub in subs_waited:
+                    wait_set.add_subscription(sub.handle)
+                for cli in clients_waited:
+                    wait_set.add_client(cli.handle)
+                for srv in services_waited:
+                    wait_set.add_service(srv.handle)
+                for tmr in timers_waited:
+                    wait_set.add_timer(tmr.handle)
+                for gc in guards_waited:
+                    wait_set.add_guard_condition(gc.handle)
                 for waitable in waitables:
                     waitable.add_to_wait_set(wait_set)
 
@@ -671,16 +738,19 @@ class Executor(ContextManager['Executor']):
                     raise ExternalShutdownException()
 
                 # get ready entities
-                subs_ready = wait_set.get_ready_entities('subscription')
-                guards_ready = wait_set.get_ready_entities('guard_condition')
-                timers_ready = wait_set.get_ready_entities('timer')
-                clients_ready = wait_set.get_ready_entities('client')
-                services_ready = wait_set.get_ready_entities('service')
+                (
+                    subs_ready_indices, guards_ready_indices, timers_ready_indices,
+                    clients_ready_indices, services_ready_indices, _
+                ) = wait_set.get_ready_indices()
+                subs_ready = {subs_waited[i] for i in subs_ready_indices}
+                guards_ready = {guards_waited[i] for i in guards_ready_indices}
+                timers_ready = {timers_waited[i] for i in timers_ready_indices}
+                clients_ready = {clients_waited[i] for i in clients_ready_indices}
+                services_ready = {services_waited[i] for i in services_ready_indices}
 
                 # Mark all guards as triggered before yielding since they're auto-taken
-                for gc in guards:
-                    if gc.handle.pointer in guards_ready:
-                        gc._executor_triggered = True
+                for gc in guards_ready:
+                    gc._executor_triggered = True
 
                 # Check waitables before wait set is destroyed
                 for node in nodes_to_use:
@@ -695,7 +765,7 @@ class Executor(ContextManager['Executor']):
             # Process ready entities one node at a time
             for node in nodes_to_use:
                 for tmr in node.timers:
-                    if tmr.handle.pointer in timers_ready:
+                    if tmr in timers_ready:
                         # Check timer is ready to workaround rcl issue with cancelled timers
                         if tmr.handle.is_timer_ready():
                             if tmr.callback_group.can_execute(tmr):
@@ -704,7 +774,7 @@ class Executor(ContextManager['Executor']):
                                 yield handler, tmr, node
 
                 for sub in node.subscriptions:
-                    if sub.handle.pointer in subs_ready:
+                    if sub in subs_ready:
                         if sub.callback_group.can_execute(sub):
                             handler = self._make_handler(sub, node, self._take_subscription)
                             yielded_work = True
@@ -718,14 +788,14 @@ class Executor(ContextManager['Executor']):
                             yield handler, gc, node
 
                 for client in node.clients:
-                    if client.handle.pointer in clients_ready:
+                    if client in clients_ready:
                         if client.callback_group.can_execute(client):
                             handler = self._make_handler(client, node, self._take_client)
                             yielded_work = True
                             yield handler, client, node
 
                 for srv in node.services:
-                    if srv.handle.pointer in services_ready:
+                    if srv in services_ready:
                         if srv.callback_group.can_execute(srv):
                             handler = self._make_handler(srv, node, self._take_service)
                             yielded_work = True
@@ -734,7 +804,7 @@ class Executor(ContextManager['Executor']):
             # Check timeout timer
             if (
                 timeout_nsec == 0 or
-                (timeout_timer is not None and timeout_timer.handle.pointer in timers_ready)
+                (timeout_timer is not None and timeout_timer in timers_ready)
             ):
                 raise TimeoutException()
         if self._is_shutdown:
@@ -835,15 +905,7 @@ class MultiThreadedExecutor(Executor):
     ) -> None:
         super().__init__(context=context)
         if num_threads is None:
-            # On Linux, it will try to use the number of CPU this process has access to.
-            # Other platforms, os.sched_getaffinity() doesn't exist so we use the number of CPUs.
-            if hasattr(os, 'sched_getaffinity'):
-                num_threads = len(os.sched_getaffinity(0))
-            else:
-                num_threads = os.cpu_count()
-            # The calls above may still return None if they aren't supported
-            if num_threads is None:
-                num_threads = 2
+            num_threads = _get_default_num_threads()
         if num_threads == 1:
             warnings.warn(
                 'MultiThreadedExecutor is used with a single thread.\n'
@@ -887,3 +949,1198 @@ class MultiThreadedExecutor(Executor):
     ) -> None:
         future.add_done_callback(lambda x: self.wake())
         self._spin_once_impl(timeout_sec, future.done)
+
+
+class StaticSingleThreadedExecutor(Executor):
+    """
+    Runs callbacks in the thread that calls :meth:`Executor.spin` using a persistent wait set.
+
+    Instead of building a new wait set on every iteration, this executor keeps a single wait set
+    alive and attaches entities to it once.
+    The wait set is only updated when nodes are added or removed or when the entities of a node
+    change, so a steady-state spin costs one wait plus the dispatch of the ready callbacks.
+
+    Entities are left out of the wait set while their callback group can't execute them, e.g.
+    while a coroutine callback of a mutually exclusive group waits on something, so that their
+    data doesn't keep waking up the executor meanwhile.
+
+    :param context: The context to be associated with, or ``None`` for the default global context.
+    """
+
+    # Node properties holding the entities which are attached to the wait set
+    _ATTACHED_ENTITY_KINDS = ('subscriptions', 'guards', 'timers', 'clients', 'services')
+
+    def __init__(self, *, context: Optional[Context] = None) -> None:
+        super().__init__(context=context)
+        self._wait_set: Optional[_rclpy.WaitSet] = None
+        # Set when nodes or the entities of a node may have changed
+        self._entities_changed = True
+        # Entities attached to the wait set, in the order of their index in the wait set
+        self._attached: Dict[str, List[WaitableEntityType]] = {
+            kind: [] for kind in self._ATTACHED_ENTITY_KINDS}
+        self._waitables: List[Waitable] = []
+        # Map an entity to the node it belongs to
+        self._entity_nodes: Dict[WaitableEntityType, Optional['Node']] = {}
+        # Set when entities were left out of the wait set because their callback group was busy
+        self._entities_left_out = False
+
+    def add_node(self, node: 'Node') -> bool:
+        self._entities_changed = True
+        return super().add_node(node)
+
+    def remove_node(self, node: 'Node') -> None:
+        self._entities_changed = True
+        super().remove_node(node)
+
+    def wake(self) -> None:
+        # Nodes wake the executor when their entities are created or destroyed
+        self._entities_changed = True
+        super().wake()
+
+    def shutdown(self, timeout_sec: Optional[float] = None) -> bool:
+        if not super().shutdown(timeout_sec):
+            return False
+        with self._shutdown_lock:
+            for waitable in self._waitables:
+                waitable.__exit__(None, None, None)
+            self._waitables = []
+            if self._wait_set is not None:
+                # Detaches all entities, possibly after the wait that is in progress
+                self._wait_set.destroy_when_not_in_use()
+                self._wait_set = None
+        return True
+
+    def _create_wait_set(self) -> _rclpy.WaitSet:
+        with self._context.handle:
+            return _rclpy.WaitSet(0, 0, 0, 0, 0, 0, self._context.handle)
+
+    def _can_wait_on(self, entity: WaitableEntityType) -> bool:
+        """Whether an entity is waited on, entities of busy callback groups are left out."""
+        if entity.callback_group.can_execute(entity):
+            return True
+        self._entities_left_out = True
+        return False
+
+    def _group_execution_ended(self) -> None:
+        """Wait on the entities left out while a callback group was busy again."""
+        if self._entities_left_out:
+            self._entities_changed = True
+
+    def _attach_entity(self, kind: str, entity: WaitableEntityType) -> None:
+        self._wait_set.attach(entity.handle)
+
+    def _detach_entity(self, kind: str, entity: WaitableEntityType) -> None:
+        self._wait_set.detach(entity.handle)
+
+    def _update_entities(self) -> None:
+        """Attach new entities to the wait set and detach the ones that went away."""
+        self._entities_changed = False
+        self._entities_left_out = False
+        if self._wait_set is None:
+            self._wait_set = self._create_wait_set()
+
+        nodes = self.get_nodes()
+        entity_nodes: Dict[WaitableEntityType, Optional['Node']] = {
+            self._guard: None, self._sigint_gc: None}
+        for kind in self._ATTACHED_ENTITY_KINDS:
+            current = []
+            for node in nodes:
+                for entity in getattr(node, kind):
+                    if kind == 'subscriptions' and entity.shared:
+                        # Executed through the waitable of their group
+                        continue
+                    entity_nodes[entity] = node
+                    if self._can_wait_on(entity):
+                        current.append(entity)
+            if kind == 'guards':
+                current += [self._guard, self._sigint_gc]
+
+            attached = self._attached[kind]
+            current_set = set(current)
+            for entity in [entity for entity in attached if entity not in current_set]:
+                self._detach_entity(kind, entity)
+                attached.remove(entity)
+            attached_set = set(attached)
+            for entity in current:
+                if entity not in attached_set:
+                    try:
+                        self._attach_entity(kind, entity)
+                    except InvalidHandle:
+                        # The entity is being destroyed
+                        continue
+                    attached.append(entity)
+                    attached_set.add(entity)
+
+        entity_count = NumberOfEntities(
+            len(self._attached['subscriptions']), len(self._attached['guards']),
+            len(self._attached['timers']), len(self._attached['clients']),
+            len(self._attached['services']))
+
+        # Waitables are added to the wait set on every wait, keep them in use meanwhile
+        current_waitables = []
+        for node in nodes:
+            for waitable in node.waitables:
+                entity_nodes[waitable] = node
+                current_waitables.append(waitable)
+        current_set = set(current_waitables)
+        for waitable in self._waitables:
+            if waitable not in current_set:
+                waitable.__exit__(None, None, None)
+        previous_set = set(self._waitables)
+        self._waitables = []
+        for waitable in current_waitables:
+            if waitable not in previous_set:
+                try:
+                    waitable.__enter__()
+                except InvalidHandle:
+                    continue
+            self._waitables.append(waitable)
+            entity_count += waitable.get_num_entities()
+        self._entity_nodes = entity_nodes
+
+        # Storage is only reallocated if the capacity changed
+        self._wait_set.resize(
+            entity_count.num_subscriptions,
+            entity_count.num_guard_conditions,
+            entity_count.num_timers,
+            entity_count.num_clients,
+            entity_count.num_services,
+            entity_count.num_events)
+
+    async def _execute_entity(self, entity: WaitableEntityType, take_from_wait_list: Callable):
+        with self._work_tracker:
+            try:
+                call_coroutine = take_from_wait_list(entity)
+                if call_coroutine is not None:
+                    await call_coroutine()
+            finally:
+                entity.callback_group.ending_execution(entity)
+                self._group_execution_ended()
+
+    def _dispatch(
+        self,
+        entity: WaitableEntityType,
+        take_from_wait_list: Callable
+    ) -> bool:
+        """
+        Take data from a ready entity and execute its callback right away.
+
+        :return: ``True`` if the callback was executed.
+        """
+        if not entity.callback_group.beginning_execution(entity):
+            # The data stays in the queue until the callback group is free, stop waiting on it
+            # meanwhile
+            self._entities_changed = True
+            return False
+        task = Task(self._execute_entity, (entity, take_from_wait_list), executor=self)
+        task()
+        if not task.done():
+            # A coroutine callback is waiting on something, resume it in later spins
+            with self._tasks_lock:
+                self._tasks.append((task, entity, self._entity_nodes.get(entity)))
+            if not entity.callback_group.can_execute(entity):
+                # Stop waiting on the entities of the group until the task is done
+                self._entities_changed = True
+        elif task.exception() is not None:
+            raise task.exception()
+        return True
+
+    def _execute_pending_tasks(self) -> bool:
+        """
+        Run or resume tasks that are not done yet.
+
+        :return: ``True`` if any task completed.
+        """
+        with self._tasks_lock:
+            tasks = list(self._tasks)
+        if not tasks:
+            return False
+        completed = False
+        for task, entity, node in tasks:
+            if not task.executing() and not task.done():
+                task()
+                if task.done():
+                    completed = True
+                    if task.exception() is not None:
+                        raise task.exception()
+        with self._tasks_lock:
+            self._tasks = [t_e_n for t_e_n in self._tasks if not t_e_n[0].done()]
+        return completed
+
+    def _dispatch_attached(self, wait_set: _rclpy.WaitSet, attached: Tuple[List, ...]) -> bool:
+        """
+        Execute the callbacks of the ready attached entities after a wait.
+
+        :param wait_set: The wait set that was waited on.
+        :param attached: The attached subscriptions, guards, timers, clients and services, in
+            the order of their index in the wait set.
+        :return: ``True`` if any callback was executed.
+        """
+        subs, guards, timers, clients, services = attached
+        (
+            subs_ready, guards_ready, timers_ready, clients_ready, services_ready, _
+        ) = wait_set.get_ready_indices()
+
+        # Attached entities come first in the wait set, indices past them belong to waitables
+        work_done = False
+        for i in timers_ready:
+            # Check timer is ready to workaround rcl issue with cancelled timers
+            if i < len(timers) and timers[i].handle.is_timer_ready():
+                work_done |= self._dispatch(timers[i], self._take_timer)
+        for i in subs_ready:
+            if i < len(subs):
+                work_done |= self._dispatch(subs[i], self._take_subscription)
+        for i in guards_ready:
+            if i < len(guards) and guards[i] not in (self._guard, self._sigint_gc):
+                work_done |= self._dispatch(guards[i], self._take_guard_condition)
+        for i in clients_ready:
+            if i < len(clients):
+                work_done |= self._dispatch(clients[i], self._take_client)
+        for i in services_ready:
+            if i < len(services):
+                work_done |= self._dispatch(services[i], self._take_service)
+        return work_done
+
+    def _wait_and_dispatch(self, timeout_nsec: int) -> bool:
+        """
+        Wait once for entities to become ready and execute their callbacks.
+
+        :return: ``True`` if any callback was executed.
+        """
+        with self._shutdown_lock:
+            # Don't attach entities to a new wait set after shutdown released the old one
+            if self._is_shutdown:
+                return False
+            if self._entities_changed:
+                self._update_entities()
+            wait_set = self._wait_set
+            # Copies, so the indices stay valid if another thread updates the entities
+            attached = tuple(list(self._attached[kind]) for kind in self._ATTACHED_ENTITY_KINDS)
+
+        with ExitStack() as context_stack:
+            try:
+                context_stack.enter_context(wait_set)
+            except InvalidHandle:
+                # The executor was shut down from another thread
+                return False
+            wait_set.rebuild()
+            waitables = [wt for wt in self._waitables if self._can_wait_on(wt)]
+            for waitable in waitables:
+                waitable.add_to_wait_set(wait_set)
+            wait_set.wait(timeout_nsec)
+            if self._is_shutdown:
+                return False
+            if not self._context.ok():
+                # The wake-up of the shutdown is consumed, waiting again could block forever
+                raise ExternalShutdownException()
+
+            waitables_ready = [wt for wt in waitables if wt.is_ready(wait_set)]
+            # Shutting down meanwhile destroys the wait set once it's no longer in use
+            work_done = self._dispatch_attached(wait_set, attached)
+
+        for waitable in waitables_ready:
+            work_done |= self._dispatch(waitable, self._take_waitable)
+        return work_done
+
+    def _spin_once_impl(
+        self,
+        timeout_sec: Optional[float] = None,
+        wait_condition: Callable[[], bool] = lambda: False
+    ) -> None:
+        timeout_nsec = timeout_sec_to_nsec(timeout_sec)
+        end = None
+        if timeout_nsec > 0:
+            end = time.monotonic() + timeout_sec
+
+        # Wait again if only the executor was woken up, until some work got done
+        while not self._is_shutdown and not wait_condition():
+            if self._execute_pending_tasks():
+                return
+            if self._wait_and_dispatch(timeout_nsec) or timeout_nsec == 0:
+                return
+            if end is not None:
+                timeout_left = end - time.monotonic()
+                if timeout_left <= 0:
+                    return
+                timeout_nsec = timeout_sec_to_nsec(timeout_left)
+
+    def spin_once(self, timeout_sec: Optional[float] = None) -> None:
+        self._spin_once_impl(timeout_sec)
+
+    def spin_once_until_future_complete(
+        self,
+        future: Future,
+        timeout_sec: Optional[float] = None
+    ) -> None:
+        future.add_done_callback(lambda x: self.wake())
+        self._spin_once_impl(timeout_sec, future.done)
+
+
+class NativeSingleThreadedExecutor(StaticSingleThreadedExecutor):
+    """
+    Runs callbacks in the thread that calls :meth:`Executor.spin` from native code.
+
+    Like :class:`StaticSingleThreadedExecutor` entities are attached to a persistent wait set
+    once.
+    Each entity is registered together with its callback in a native executor core, which waits
+    on the wait set, takes the data of the ready entities and calls their callbacks in a single
+    call, without going through the Python bookkeeping of the other executors.
+    The GIL is released while waiting, while looking up the ready entities and while taking
+    their data, it's only held to convert the taken data and to run the callbacks.
+
+    Callbacks that are coroutine functions are scheduled as tasks, and the callbacks of
+    waitables are executed like in :class:`StaticSingleThreadedExecutor`.
+    The callback of an entity is looked up when the entity is added to the executor.
+
+    :param context: The context to be associated with, or ``None`` for the default global context.
+    """
+
+    def __init__(self, *, context: Optional[Context] = None) -> None:
+        super().__init__(context=context)
+        self._core: Optional[_rclpy.ExecutorCore] = None
+
+    def shutdown(self, timeout_sec: Optional[float] = None) -> bool:
+        if not super().shutdown(timeout_sec):
+            return False
+        with self._shutdown_lock:
+            if self._core is not None:
+                # Drops the references to the callbacks, possibly after the current dispatch
+                self._core.destroy_when_not_in_use()
+                self._core = None
+        return True
+
+    def _create_wait_set(self) -> _rclpy.WaitSet:
+        wait_set = super()._create_wait_set()
+        self._core = _rclpy.ExecutorCore(wait_set)
+        return wait_set
+
+    def _schedule_coroutine(self, entity: WaitableEntityType, callback: Callable, *args) -> None:
+        """Execute a coroutine callback as a task, the entity is busy until the task is done."""
+        async def execute():
+            with self._work_tracker:
+                try:
+                    return await callback(*args)
+                finally:
+                    entity.callback_group.ending_execution(entity)
+                    self._group_execution_ended()
+
+        task = Task(execute, executor=self)
+        task()
+        if not task.done():
+            with self._tasks_lock:
+                self._tasks.append((task, entity, self._entity_nodes.get(entity)))
+            if not entity.callback_group.can_execute(entity):
+                # Stop waiting on the entities of the group until the task is done
+                self._entities_changed = True
+        elif task.exception() is not None:
+            raise task.exception()
+
+    def _attach_entity(self, kind: str, entity: WaitableEntityType) -> None:
+        if kind == 'guards' and entity in (self._guard, self._sigint_gc):
+            # Only wake up the wait
+            self._core.add_guard_condition(entity.handle, None, None, None)
+            return
+
+        group = entity.callback_group
+        # The core claims the native state of the group itself, without calling into Python
+        state = _get_native_group_state(group)
+        group_args = {}
+        begin = end = None
+        if state is None:
+            begin = partial(group.beginning_execution, entity)
+            end = partial(group.ending_execution, entity)
+        elif state.exclusive:
+            group_args = {'group': state, 'entity': entity}
+
+        if kind == 'clients':
+            self._core.add_client(
+                entity.handle, entity.srv_type.Response,
+                partial(self._handle_response, entity), begin, end, **group_args)
+            return
+
+        callback = entity.callback
+        is_coroutine = inspect.iscoroutinefunction(callback)
+        if is_coroutine:
+            callback = partial(self._schedule_coroutine, entity, callback)
+
+        if kind == 'subscriptions':
+            with_info = entity._callback_type is Subscription.CallbackType.WithMessageInfo
+            if is_coroutine and entity.loaned_messages:
+                callback = partial(
+                    self._schedule_coroutine, entity, _await_and_release, entity.callback)
+            self._core.add_subscription(
+                entity.handle, entity.msg_type, entity.raw, with_info,
+                callback, begin, end, is_coroutine, entity.max_batch_size or 0,
+                entity.loaned_messages, entity.reused_message, entity.lazy, entity.columns,
+                entity.array_views, **group_args)
+        elif kind == 'timers':
+            self._core.add_timer(entity.handle, callback, begin, end, is_coroutine, **group_args)
+        elif kind == 'guards':
+            self._core.add_guard_condition(
+                entity.handle, callback, begin, end, is_coroutine, **group_args)
+        elif kind == 'services':
+            if is_coroutine:
+                # The native core can't await the response, send it once the task is done
+                callback = partial(self._schedule_coroutine, entity, self._handle_request, entity)
+            self._core.add_service(
+                entity.handle, entity.srv_type.Request, entity.srv_type.Response,
+                callback, begin, end, is_coroutine, **group_args)
+
+    def _detach_entity(self, kind: str, entity: WaitableEntityType) -> None:
+        self._core.remove(entity.handle)
+
+    def _handle_response(self, client: Client, header, response) -> None:
+        try:
+            sequence = header.request_id.sequence_number
+            future = client.get_pending_request(sequence)
+        except KeyError:
+            # The request was cancelled
+            pass
+        else:
+            future._set_executor(self)
+            future.set_result(response)
+
+    async def _handle_request(self, srv: Service, request, header) -> None:
+        response = await srv.callback(request, srv.srv_type.Response())
+        srv.send_response(response, header)
+
+    def _wait_and_dispatch(self, timeout_nsec: int) -> bool:
+        with self._shutdown_lock:
+            # Don't attach entities to a new wait set after shutdown released the old one
+            if self._is_shutdown:
+                return False
+            if self._entities_changed:
+                self._update_entities()
+            wait_set = self._wait_set
+            core = self._core
+
+        with ExitStack() as context_stack:
+            try:
+                context_stack.enter_context(wait_set)
+                context_stack.enter_context(core)
+            except InvalidHandle:
+                # The executor was shut down from another thread
+                return False
+            core.prepare_wait()
+            waitables = [wt for wt in self._waitables if self._can_wait_on(wt)]
+            for waitable in waitables:
+                waitable.add_to_wait_set(wait_set)
+            with self._work_tracker:
+                work_done = core.wait_and_dispatch(timeout_nsec) > 0
+            if self._is_shutdown:
+                return work_done
+            if not self._context.ok():
+                raise ExternalShutdownException()
+            waitables_ready = [wt for wt in waitables if wt.is_ready(wait_set)]
+
+        for waitable in waitables_ready:
+            work_done |= self._dispatch(waitable, self._take_waitable)
+        return work_done
+
+
+class NativeMultiThreadedExecutor(StaticSingleThreadedExecutor):
+    """
+    Runs callbacks in a pool of native worker threads.
+
+    The thread that calls :meth:`Executor.spin` waits on a wait set and hands the ready
+    entities to a native executor core, which queues them to its worker threads.
+    Each worker has its own queue and steals from the queues of the other workers when its own
+    is empty, so callbacks don't go through Python queues and futures.
+    Workers only hold the GIL to take the data of an entity and run its callback, so the
+    throughput scales with the number of threads on free-threaded Python builds.
+
+    Callback groups are enforced by the core: the entities of a
+    :class:`~rclpy.callback_groups.MutuallyExclusiveCallbackGroup` are executed one at a time,
+    and the ones of a :class:`~rclpy.callback_groups.ReentrantCallbackGroup` concurrently.
+    The core claims the native state of these groups without calling into Python.
+    Other callback groups are treated as mutually exclusive and bypass
+    :meth:`CallbackGroup.can_execute`, so they must not be used by other executors.
+    Callbacks that are coroutine functions keep their entity busy until they are done, and are
+    resumed by the thread that spins.
+
+    :param num_threads: number of worker threads.
+        If ``None``, the number of threads will be automatically set by querying the underlying OS
+        for the CPU affinity of the process space.
+        If the OS doesn't provide this information, defaults to 2.
+    :param context: The context to be associated with, or ``None`` for the default global context.
+    """
+
+    # The methods of the core registering each kind of entity and the take function of the kind
+    _CORE_ENTITY_KINDS = {
+        'subscriptions': ('add_subscription', '_take_subscription'),
+        'guards': ('add_guard_condition', '_take_guard_condition'),
+        'timers': ('add_timer', '_take_timer'),
+        'clients': ('add_client', '_take_client'),
+        'services': ('add_service', '_take_service'),
+    }
+
+    def __init__(
+        self,
+        num_threads: Optional[int] = None,
+        *, context: Optional[Context] = None
+    ) -> None:
+        super().__init__(context=context)
+        self._num_threads = _get_default_num_threads() if num_threads is None else num_threads
+        self._core: Optional[_rclpy.MultiThreadedExecutorCore] = None
+        self._next_id = 0
+        # Identifiers of the entities and waitables registered with the core
+        self._entity_ids: Dict[WaitableEntityType, int] = {}
+        self._waitable_ids: Dict[Waitable, int] = {}
+        # The states standing in for the callback groups without a native one
+        self._group_states: weakref.WeakKeyDictionary = weakref.WeakKeyDictionary()
+
+    def shutdown(self, timeout_sec: Optional[float] = None) -> bool:
+        if not super().shutdown(timeout_sec):
+            return False
+        with self._shutdown_lock:
+            if self._core is not None:
+                # Joins the workers, possibly after the wait that is in progress
+                self._core.destroy_when_not_in_use()
+                self._core = None
+            self._entity_ids = {}
+            self._waitable_ids = {}
+        return True
+
+    def _create_wait_set(self) -> _rclpy.WaitSet:
+        wait_set = super()._create_wait_set()
+        self._core = _rclpy.MultiThreadedExecutorCore(
+            wait_set, self._guard.handle, self._num_threads)
+        return wait_set
+
+    def _get_next_id(self) -> int:
+        self._next_id += 1
+        return self._next_id
+
+    def _can_wait_on(self, entity: WaitableEntityType) -> bool:
+        # The core leaves out the entities of busy callback groups itself
+        return True
+
+    def _get_group_state(
+        self,
+        entity: WaitableEntityType
+    ) -> Optional[_rclpy.CallbackGroupState]:
+        group = entity.callback_group
+        state = _get_native_group_state(group)
+        if state is None:
+            state = self._group_states.get(group)
+            if state is None:
+                state = self._group_states[group] = _rclpy.CallbackGroupState(True)
+        # Entities of reentrant groups don't need to claim anything
+        return state if state.exclusive else None
+
+    def _attach_entity(self, kind: str, entity: WaitableEntityType) -> None:
+        add_function, take_function = self._CORE_ENTITY_KINDS[kind]
+        entity_id = self._get_next_id()
+        if kind == 'guards' and entity in (self._guard, self._sigint_gc):
+            # Only wake up the wait
+            self._core.add_guard_condition(entity.handle, entity_id, None, None)
+        else:
+            handler = partial(
+                self._execute_in_worker, entity_id, entity, getattr(self, take_function))
+            getattr(self._core, add_function)(
+                entity.handle, entity_id, handler, self._get_group_state(entity))
+        self._entity_ids[entity] = entity_id
+
+    def _detach_entity(self, kind: str, entity: WaitableEntityType) -> None:
+        self._core.remove(self._entity_ids.pop(entity))
+
+    def _update_entities(self) -> None:
+        super()._update_entities()
+        current_set = set(self._waitables)
+        for waitable in [wt for wt in self._waitable_ids if wt not in current_set]:
+            self._core.remove(self._waitable_ids.pop(waitable))
+        for waitable in self._waitables:
+            if waitable not in self._waitable_ids:
+                waitable_id = self._get_next_id()
+                handler = partial(
+                    self._execute_in_worker, waitable_id, waitable, self._take_waitable)
+                self._core.add_external(
+                    waitable_id, handler, self._get_group_state(waitable))
+                self._waitable_ids[waitable] = waitable_id
+
+    def _execute_in_worker(
+        self,
+        entity_id: int,
+        entity: WaitableEntityType,
+        take_from_wait_list: Callable
+    ) -> bool:
+        """
+        Take the data of an entity and execute its callback, called in a worker thread.
+
+        :return: ``False`` if a coroutine callback goes on as a task, which ends the execution
+            of the entity once it is done.
+        """
+        with self._work_tracker:
+            call_coroutine = take_from_wait_list(entity)
+            if call_coroutine is None:
+                return True
+            task = Task(call_coroutine, executor=self)
+            task()
+            if task.done():
+                if task.exception() is not None:
+                    raise task.exception()
+                return True
+
+        # The thread that spins resumes the task
+        task.add_done_callback(lambda _: self._end_execution(entity_id))
+        with self._tasks_lock:
+            self._tasks.append((task, entity, self._entity_nodes.get(entity)))
+        return False
+
+    def _end_execution(self, entity_id: int) -> None:
+        core = self._core
+        if core is None:
+            return
+        with ExitStack() as context_stack:
+            try:
+                context_stack.enter_context(core)
+            except InvalidHandle:
+                # The executor was shut down from another thread
+                return
+            core.end_execution(entity_id)
+
+    def _wait_and_dispatch(self, timeout_nsec: int) -> bool:
+        """
+        Wait once for entities to become ready and queue them to the workers.
+
+        :return: ``True`` if any entity was queued.
+        """
+        with self._shutdown_lock:
+            # Don't register entities with a new core after shutdown released the old one
+            if self._is_shutdown:
+                return False
+            if self._entities_changed:
+                self._update_entities()
+            wait_set = self._wait_set
+            core = self._core
+            waitables = list(self._waitable_ids.items())
+
+        with ExitStack() as context_stack:
+            try:
+                context_stack.enter_context(wait_set)
+                context_stack.enter_context(core)
+            except InvalidHandle:
+                # The executor was shut down from another thread
+                return False
+            core.prepare_wait()
+            # Waitables that are busy are left out, like the entities of the core
+            waitables = [
+                (waitable, waitable_id) for waitable, waitable_id in waitables
+                if core.can_schedule(waitable_id)]
+            for waitable, _ in waitables:
+                waitable.add_to_wait_set(wait_set)
+            num_scheduled = core.wait_and_schedule(timeout_nsec)
+            if self._is_shutdown:
+                return False
+            if not self._context.ok():
+                raise ExternalShutdownException()
+
+            for waitable, waitable_id in waitables:
+                if waitable.is_ready(wait_set) and core.schedule(waitable_id):
+                    num_scheduled += 1
+        return num_scheduled > 0
+
+
+class EventsExecutor(StaticSingleThreadedExecutor):
+    """
+    Runs callbacks in the thread that calls :meth:`Executor.spin` as their entities get events.
+
+    Instead of waiting on a wait set, subscriptions, services, clients and guard conditions are
+    given a listener callback, which the middleware calls when they receive data.
+    The callback pushes an identifier of the entity to a native queue without needing the GIL,
+    and this executor pops the identifiers from the queue and executes the callbacks of their
+    entities, once per message, request or response received.
+    The cost of a spin thus depends on the number of events, not on the number of entities.
+
+    Timers are kept by the executor, which waits on the queue until the next one is due.
+    Waitables which can't push to the queue, see :meth:`Waitable.add_to_events_queue`, are
+    polled with a wait set every :attr:`WAITABLE_POLL_PERIOD_SEC`.
+    Guard conditions only push to the queue when triggered through rclpy, so the executor
+    checks at least every :attr:`MAX_WAIT_SEC` whether the context was shut down, e.g. by a
+    signal.
+
+    If the callback group of an entity is busy, its events are kept and retried on the next
+    spin.
+
+    :param context: The context to be associated with, or ``None`` for the default global context.
+    """
+
+    WAITABLE_POLL_PERIOD_SEC = 0.01
+    MAX_WAIT_SEC = 0.1
+
+    # Identifier the executor guard condition pushes, entities get the following ones
+    _WAKE_ID = 0
+
+    _TAKE_FUNCTIONS = {
+        'subscriptions': '_take_subscription',
+        'guards': '_take_guard_condition',
+        'clients': '_take_client',
+        'services': '_take_service',
+        'waitables': '_take_waitable',
+    }
+
+    _ADD_FUNCTIONS = {
+        'subscriptions': 'add_subscription',
+        'guards': 'add_guard_condition',
+        'clients': 'add_client',
+        'services': 'add_service',
+    }
+
+    def __init__(self, *, context: Optional[Context] = None) -> None:
+        super().__init__(context=context)
+        self._events_queue: Optional[_rclpy.EventsQueue] = None
+        self._next_id = self._WAKE_ID + 1
+        # Identifier and kind of the entities added to the queue or to the timers
+        self._entity_ids: Dict[WaitableEntityType, Tuple[int, str]] = {}
+        self._id_entities: Dict[int, Tuple[WaitableEntityType, str]] = {}
+        self._timers: List[Timer] = []
+        # Events of entities whose callback group was busy, as (identifier, count)
+        self._deferred: List[Tuple[int, int]] = []
+
+    def shutdown(self, timeout_sec: Optional[float] = None) -> bool:
+        if not super().shutdown(timeout_sec):
+            return False
+        with self._shutdown_lock:
+            if self._events_queue is not None:
+                # Lets the waitables be waited on with a wait set again, by other executors
+                for entity, (entity_id, kind) in self._entity_ids.items():
+                    if kind == 'waitables':
+                        entity.remove_from_events_queue(self._events_queue, entity_id)
+                # Unsets the listener callbacks, possibly after the wait that is in progress
+                self._events_queue.destroy_when_not_in_use()
+                self._events_queue = None
+            self._entity_ids = {}
+            self._id_entities = {}
+            self._timers = []
+            self._deferred = []
+        return True
+
+    def _add_entity(self, kind: str, entity: WaitableEntityType) -> None:
+        entity_id = self._next_id
+        self._next_id += 1
+        if kind == 'timers':
+            self._timers.append(entity)
+        elif kind == 'waitables':
+            if not entity.add_to_events_queue(self._events_queue, entity_id):
+                entity.__enter__()
+                self._waitables.append(entity)
+        else:
+            with entity.handle:
+                getattr(self._events_queue, self._ADD_FUNCTIONS[kind])(entity.handle, entity_id)
+        self._entity_ids[entity] = (entity_id, kind)
+        self._id_entities[entity_id] = (entity, kind)
+
+    def _remove_entity(self, entity: WaitableEntityType) -> None:
+        entity_id, kind = self._entity_ids.pop(entity)
+        del self._id_entities[entity_id]
+        if kind == 'timers':
+            self._timers.remove(entity)
+        elif entity in self._waitables:
+            self._waitables.remove(entity)
+            entity.__exit__(None, None, None)
+        elif kind == 'waitables':
+            entity.remove_from_events_queue(self._events_queue, entity_id)
+        else:
+            self._events_queue.remove(entity_id)
+
+    def _update_entities(self) -> None:
+        """Add new entities to the queue and remove the ones that went away."""
+        self._entities_changed = False
+        if self._events_queue is None:
+            self._events_queue = _rclpy.EventsQueue()
+            with self._guard.handle:
+                self._events_queue.add_guard_condition(self._guard.handle, self._WAKE_ID)
+
+        current: Dict[WaitableEntityType, Tuple[str, 'Node']] = {}
+        for node in self.get_nodes():
+            for kind in self._ATTACHED_ENTITY_KINDS + ('waitables',):
+                for entity in getattr(node, kind):
+                    if kind == 'subscriptions' and entity.shared:
+                        # Executed through the waitable of their group
+                        continue
+                    current[entity] = (kind, node)
+
+        for entity in [entity for entity in self._entity_ids if entity not in current]:
+            self._remove_entity(entity)
+        for entity, (kind, _) in current.items():
+            if entity not in self._entity_ids:
+                try:
+                    self._add_entity(kind, entity)
+                except InvalidHandle:
+                    # The entity is being destroyed
+                    continue
+        self._entity_nodes = {entity: node for entity, (_, node) in current.items()}
+
+        if self._waitables:
+            if self._wait_set is None:
+                self._wait_set = self._create_wait_set()
+            entity_count = NumberOfEntities()
+            for waitable in self._waitables:
+                entity_count += waitable.get_num_entities()
+            self._wait_set.resize(
+                entity_count.num_subscriptions,
+                entity_count.num_guard_conditions,
+                entity_count.num_timers,
+                entity_count.num_clients,
+                entity_count.num_services,
+                entity_count.num_events)
+
+    def _get_wait_timeout(self, timeout_nsec: int) -> int:
+        """Bound a timeout by the next timer call and the polling of waitables."""
+        bounds = [timeout_sec_to_nsec(self.MAX_WAIT_SEC)]
+        if timeout_nsec >= 0:
+            bounds.append(timeout_nsec)
+        if self._waitables:
+            bounds.append(timeout_sec_to_nsec(self.WAITABLE_POLL_PERIOD_SEC))
+        for timer in self._timers:
+            try:
+                with timer.handle:
+                    time_until_next_call = timer.handle.time_until_next_call()
+            except InvalidHandle:
+                continue
+            if time_until_next_call is not None:
+                bounds.append(max(time_until_next_call, 0))
+        return min(bounds)
+
+    def _dispatch_events(self, events: List[Tuple[int, int]]) -> bool:
+        """
+        Execute the callbacks of the entities that got events.
+
+        Events of entities whose callback group is busy are deferred to the next spin.
+
+        :param events: The (identifier, count) of the events, in the order they occurred.
+        :return: ``True`` if any callback was executed.
+        """
+        work_done = False
+        for entity_id, count in events:
+            entity_kind = self._id_entities.get(entity_id)
+            if entity_kind is None:
+                # The executor was woken up or the entity was removed meanwhile
+                continue
+            entity, kind = entity_kind
+            if kind == 'waitables':
+                # Waitables take all the data available at once
+                count = 1
+            take_from_wait_list = getattr(self, self._TAKE_FUNCTIONS[kind])
+            for executed in range(count):
+                if not self._dispatch(entity, take_from_wait_list):
+                    self._deferred.append((entity_id, count - executed))
+                    break
+                work_done = True
+        return work_done
+
+    def _dispatch_timers(self) -> bool:
+        work_done = False
+        for timer in list(self._timers):
+            try:
+                with timer.handle:
+                    is_ready = timer.handle.is_timer_ready()
+            except InvalidHandle:
+                continue
+            if is_ready:
+                work_done |= self._dispatch(timer, self._take_timer)
+        return work_done
+
+    def _dispatch_waitables(self) -> bool:
+        """Poll the waitables that can't push to the queue and execute the ready ones."""
+        wait_set = self._wait_set
+        if not self._waitables or wait_set is None:
+            return False
+        with ExitStack() as context_stack:
+            try:
+                context_stack.enter_context(wait_set)
+            except InvalidHandle:
+                # The executor was shut down from another thread
+                return False
+            wait_set.rebuild()
+            for waitable in self._waitables:
+                waitable.add_to_wait_set(wait_set)
+            wait_set.wait(0)
+            waitables_ready = [wt for wt in self._waitables if wt.is_ready(wait_set)]
+
+        work_done = False
+        for waitable in waitables_ready:
+            work_done |= self._dispatch(waitable, self._take_waitable)
+        return work_done
+
+    def _wait_and_dispatch(self, timeout_nsec: int) -> bool:
+        """
+        Wait once for events and execute the callbacks of their entities.
+
+        :return: ``True`` if any callback was executed.
+        """
+        with self._shutdown_lock:
+            # Don't add entities to a new queue after shutdown released the old one
+            if self._is_shutdown:
+                return False
+            if self._entities_changed:
+                self._update_entities()
+            events_queue = self._events_queue
+
+        # Events of busy callback groups are retried first, don't wait if any was executed
+        events, self._deferred = self._deferred, []
+        work_done = self._dispatch_events(events)
+        if work_done:
+            timeout_nsec = 0
+        with ExitStack() as context_stack:
+            try:
+                context_stack.enter_context(events_queue)
+            except InvalidHandle:
+                # The executor was shut down from another thread
+                return False
+            events = events_queue.wait(self._get_wait_timeout(timeout_nsec))
+        if self._is_shutdown:
+            return False
+        if not self._context.ok():
+            raise ExternalShutdownException()
+
+        work_done |= self._dispatch_timers()
+        work_done |= self._dispatch_events(events)
+        work_done |= self._dispatch_waitables()
+        return work_done
+
+
+def _get_node_load(node: 'Node') -> int:
+    """Get the number of entities of a node, which the shards of a ShardedExecutor balance."""
+    return (
+        len(node.subscriptions) + len(node.timers) + len(node.clients) + len(node.services) +
+        len(node.guards) + len(node.waitables))
+
+
+class ShardedExecutor(Executor):
+    """
+    Runs the callbacks of each node in one of several independent shards.
+
+    Every shard is an executor of its own, by default a
+    :class:`StaticSingleThreadedExecutor`, with its own persistent wait set and its own thread
+    waiting on it with the GIL released.
+    A node only ever wakes up the shard it was assigned to, so a node with a lot of entities or
+    a slow callback doesn't delay the callbacks of the nodes of other shards, e.g. a high rate
+    controller node can be isolated from a chatty diagnostics node.
+
+    Nodes are assigned to the shard with the fewest entities, or to the shard passed to
+    :meth:`add_node`, in which case they stay there.
+    The other nodes are moved between shards whenever nodes are added or removed, or when
+    :meth:`rebalance` is called after nodes created or destroyed entities, so the shards
+    have about as many entities each.
+    Callbacks of a node which is moved may run in both shards for a moment, mutually exclusive
+    callback groups still execute one callback at a time.
+
+    The shards start spinning on the first call to :meth:`spin_once`, and the thread that
+    spins executes the tasks created with :meth:`create_task` and raises the exceptions raised
+    in the shards.
+    :meth:`Node.executor` is the shard of a node.
+
+    :param num_shards: number of shards.
+        If ``None``, the number of shards will be automatically set by querying the underlying OS
+        for the CPU affinity of the process space.
+        If the OS doesn't provide this information, defaults to 2.
+    :param shard_type: the type of the executors of the shards, which spin in a single thread.
+    :param context: The context to be associated with, or ``None`` for the default global context.
+    """
+
+    def __init__(
+        self,
+        num_shards: Optional[int] = None,
+        *, shard_type: Type[Executor] = StaticSingleThreadedExecutor,
+        context: Optional[Context] = None
+    ) -> None:
+        super().__init__(context=context)
+        if num_shards is None:
+            num_shards = _get_default_num_threads()
+        if num_shards < 1:
+            raise ValueError('the number of shards must be positive')
+        self._shards: List[Executor] = [
+            shard_type(context=self._context) for _ in range(num_shards)]
+        self._threads: List[Thread] = []
+        # Shard the nodes added with an explicit one were pinned to
+        self._pinned_shards: Dict['Node', int] = {}
+        self._exceptions: List[Exception] = []
+        self._exceptions_lock = Lock()
+
+    @property
+    def num_shards(self) -> int:
+        """Get the number of shards."""
+        return len(self._shards)
+
+    def wake(self) -> None:
+        """Wake the executor and all of its shards."""
+        super().wake()
+        for shard in self._shards:
+            shard.wake()
+
+    def get_nodes(self) -> List['Node']:
+        """Return nodes that have been added to the shards of this executor."""
+        with self._nodes_lock:
+            return [node for shard in self._shards for node in shard.get_nodes()]
+
+    def get_node_shard(self, node: 'Node') -> Optional[int]:
+        """
+        Get the shard a node is assigned to.
+
+        :return: The index of the shard, or ``None`` if the node wasn't added to this executor.
+        """
+        with self._nodes_lock:
+            for index, shard in enumerate(self._shards):
+                if node in shard.get_nodes():
+                    return index
+        return None
+
+    def add_node(self, node: 'Node', shard: Optional[int] = None) -> bool:
+        """
+        Add a node to a shard.
+
+        :param node: The node to add to the executor.
+        :param shard: The index of the shard to pin the node to, or ``None`` to let the executor
+            assign it to the shard with the fewest entities.
+            A node which was already added is moved to the shard it is pinned to.
+        :return: ``True`` if the node was added or moved, ``False`` otherwise.
+        """
+        with self._nodes_lock:
+            if shard is not None and not 0 <= shard < len(self._shards):
+                raise ValueError(f'shard {shard} does not exist')
+            current = self.get_node_shard(node)
+            if shard is None:
+                if current is not None:
+                    return False
+                loads = self._get_loads()
+                index = loads.index(min(loads))
+            else:
+                self._pinned_shards[node] = shard
+                if current == shard:
+                    return False
+                index = shard
+            # Removes the node from its current shard, if any
+            self._shards[index].add_node(node)
+            self.rebalance()
+            return True
+
+    def remove_node(self, node: 'Node') -> None:
+        """
+        Stop managing this node's callbacks.
+
+        :param node: The node to remove from the executor.
+        """
+        with self._nodes_lock:
+            self._pinned_shards.pop(node, None)
+            current = self.get_node_shard(node)
+            if current is not None:
+                self._shards[current].remove_node(node)
+                self.rebalance()
+
+    def _get_loads(self) -> List[int]:
+        return [sum(map(_get_node_load, shard.get_nodes())) for shard in self._shards]
+
+    def rebalance(self) -> None:
+        """
+        Move nodes from the shard with the most entities to the one with the fewest.
+
+        Nodes are moved as long as a move evens the number of entities of the shards, pinned
+        nodes are never moved.
+        """
+        with self._nodes_lock:
+            while True:
+                loads = self._get_loads()
+                heaviest = loads.index(max(loads))
+                lightest = loads.index(min(loads))
+                gap = loads[heaviest] - loads[lightest]
+                # Moving a node with fewer entities than the gap always narrows it, so this ends
+                movable = [
+                    node for node in self._shards[heaviest].get_nodes()
+                    if node not in self._pinned_shards and 0 < _get_node_load(node) < gap]
+                if not movable:
+                    return
+                self._shards[lightest].add_node(max(movable, key=_get_node_load))
+
+    def shutdown(self, timeout_sec: Optional[float] = None) -> bool:
+        # The timeout covers the whole shutdown, not each shard and thread
+        end = None
+        if timeout_sec is not None and timeout_sec >= 0:
+            end = time.monotonic() + timeout_sec
+
+        def timeout_left() -> Optional[float]:
+            return None if end is None else max(end - time.monotonic(), 0.0)
+
+        if not super().shutdown(timeout_sec):
+            return False
+        # The shards stop spinning once they are shut down
+        all_done = True
+        for shard in self._shards:
+            all_done &= shard.shutdown(timeout_left())
+        if not all_done:
+            return False
+        # Shut down from a callback, the shard stops once the callback returned
+        threads = [thread for thread in self._threads if thread is not current_thread()]
+        for thread in threads:
+            thread.join(timeout_left())
+        if any(thread.is_alive() for thread in threads):
+            return False
+        self._pinned_shards = {}
+        return True
+
+    def _run_shard(self, shard: Executor) -> None:
+        while self._context.ok() and not self._is_shutdown:
+            try:
+                shard.spin_once()
+            except ExternalShutdownException:
+                return
+            except Exception as e:
+                with self._exceptions_lock:
+                    self._exceptions.append(e)
+                # Let the thread that spins raise it
+                super().wake()
+
+    def _start_shards(self) -> None:
+        with self._shutdown_lock:
+            if self._threads or self._is_shutdown:
+                return
+            for index, shard in enumerate(self._shards):
+                thread = Thread(
+                    target=self._run_shard, args=(shard,), name=f'rclpy_shard_{index}',
+                    daemon=True)
+                thread.start()
+                self._threads.append(thread)
+
+    def _raise_shard_exception(self) -> None:
+        with self._exceptions_lock:
+            if not self._exceptions:
+                return
+            exception = self._exceptions.pop(0)
+        raise exception
+
+    def _spin_once_impl(
+        self,
+        timeout_sec: Optional[float] = None,
+        wait_condition: Callable[[], bool] = lambda: False
+    ) -> None:
+        self._start_shards()
+        self._raise_shard_exception()
+        try:
+            # The entities of the nodes are waited on by the shards, only wait for the tasks
+            handler, entity, node = self.wait_for_ready_callbacks(
+                timeout_sec, [], lambda: bool(self._exceptions) or wait_condition())
+        except ExternalShutdownException:
+            pass
+        except ShutdownException:
+            pass
+        except TimeoutException:
+            pass
+        except ConditionReachedException:
+            self._raise_shard_exception()
+        else:
+            handler()
+            if handler.exception() is not None:
+                raise handler.exception()
+
+            handler.result()  # raise any exceptions
+
+    def spin_once(self, timeout_sec: Optional[float] = None) -> None:
+        self._spin_once_impl(timeout_sec)
+
+    def spin_once_until_future_complete(
+        self,
+        future: Future,
+        timeout_sec: Optional[float] = None
+    ) -> None:
+        future.add_done_callback(lambda x: self.wake())
+        self._spin_once_impl(timeout_sec, future.done)
@@ -0,0 +1,250 @@
+# Copyright 2026 Open Source Robotics Foundation, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+from collections import deque
+import copy
+import threading
+import time
+from typing import Dict
+from typing import List
+from typing import TYPE_CHECKING
+
+import rclpy
+from rclpy.impl.implementation_singleton import rclpy_implementation as _rclpy
+from rclpy.qos import DurabilityPolicy
+from rclpy.qos import HistoryPolicy
+from rclpy.qos import qos_check_compatible
+from rclpy.qos import QoSCompatibility
+from rclpy.qos import QoSProfile
+from rclpy.waitable import NumberOfEntities
+from rclpy.waitable import Waitable
+
+if TYPE_CHECKING:
+    from rclpy.context import Context
+    from rclpy.publisher import Publisher
+    from rclpy.subscription import Subscription
+
+
+def check_intra_process_qos(qos_profile: QoSProfile) -> None:
+    """
+    Check that a QoS profile can be used with intra-process communication.
+
+    :raises: ValueError if the durability is not volatile or the history depth is zero, since
+        messages are only queued for the subscriptions that exist when they are published.
+    """
+    if qos_profile.durability == DurabilityPolicy.TRANSIENT_LOCAL:
+        raise ValueError('intra-process communication requires a volatile durability')
+    if qos_profile.history == HistoryPolicy.KEEP_LAST and qos_profile.depth == 0:
+        raise ValueError('intra-process communication requires a history depth')
+
+
+class IntraProcessSubscription(Waitable):
+    """
+    Waitable delivering the messages handed over within the process to a subscription.
+
+    Messages are queued following the history policy of the subscription and a guard condition
+    wakes up the executor waiting on the subscription.
+    It is used for intra-process communication and for subscriptions sharing a middleware
+    reader.
+    """
+
+    def __init__(self, subscription: 'Subscription', context: 'Context') -> None:
+        # Waitable init adds self to callback_group
+        super().__init__(subscription.callback_group)
+        self.subscription = subscription
+        qos_profile = subscription.qos_profile
+        keep_all = qos_profile.history == HistoryPolicy.KEEP_ALL or qos_profile.depth == 0
+        self._queue: deque = deque(maxlen=None if keep_all else qos_profile.depth)
+        self._lock = threading.Lock()
+        with context.handle:
+            self.__gc = _rclpy.GuardCondition(context.handle)
+        self._gc_index = None
+
+    def deliver(self, msg, info: dict) -> None:
+        """Queue a message and wake up the executor."""
+        with self._lock:
+            self._queue.append((msg, info))
+        with self.__gc:
+            self.__gc.trigger_guard_condition()
+
+    # Start Waitable API
+    def is_ready(self, wait_set):
+        """Return True if entities are ready in the wait set."""
+        if self._gc_index is None:
+            return False
+        return wait_set.is_ready('guard_condition', self._gc_index)
+
+    def take_data(self):
+        """Take stuff from lower level so the wait set doesn't immediately wake again."""
+        with self._lock:
+            if not self._queue:
+                return None
+            taken = self._queue.popleft()
+            if not self._queue:
+                return taken
+        # Wake up the executor again for the messages left
+        with self.__gc:
+            self.__gc.trigger_guard_condition()
+        return taken
+
+    async def execute(self, taken_data):
+        """Execute work after data has been taken from a ready wait set."""
+        if taken_data is None:
+            return
+        msg, info = taken_data
+        sub = self.subscription
+        if sub._callback_type is sub.CallbackType.MessageOnly:
+            await rclpy.executors.await_or_execute(sub.callback, msg)
+        else:
+            await rclpy.executors.await_or_execute(sub.callback, msg, info)
+
+    def get_num_entities(self):
+        """Return number of each type of entity used."""
+        return NumberOfEntities(num_gcs=1)
+
+    def add_to_wait_set(self, wait_set):
+        """Add entites to wait set."""
+        with self.__gc:
+            self._gc_index = wait_set.add_guard_condition(self.__gc)
+
+    def add_to_events_queue(self, events_queue, waitable_id):
+        """Push the identifier to the events queue when a message is delivered."""
+        with self.__gc:
+            events_queue.add_guard_condition(self.__gc, waitable_id)
+        return True
+
+    def __enter__(self):
+        """Mark the guard condition as in-use to prevent destruction while waiting on it."""
+        self.__gc.__enter__()
+
+    def __exit__(self, t, v, tb):
+        """Mark the guard condition as not-in-use to allow destruction after waiting on it."""
+        self.__gc.__exit__(t, v, tb)
+
+    def destroy(self):
+        self.__gc.destroy_when_not_in_use()
+
+
+class IntraProcessManager:
+    """
+    Deliver messages between the publishers and subscriptions of a context without rmw.
+
+    Publishers and subscriptions using intra-process communication are registered with the
+    manager of their context.
+    A message published by such a publisher is handed to the matching local subscriptions,
+    i.e. the ones on the same topic, of the same type and with a compatible QoS profile,
+    without being converted or serialized.
+    Every subscription gets its own copy of the message, so the publisher may modify or publish
+    the message again before it is received, and subscriptions don't see each other's changes.
+
+    Intra-process publishers always publish through rmw as well, for the other subscriptions, so
+    the subscriptions they deliver to ignore the messages with their publisher GID, as rclcpp
+    does, and keep getting the messages of the other publishers from rmw.
+    """
+
+    def __init__(self) -> None:
+        self._lock = threading.Lock()
+        self._topics: Dict[int, str] = {}
+        self._subscriptions: Dict[str, List[IntraProcessSubscription]] = {}
+        # The subscriptions each publisher delivers to
+        self._matches: Dict[int, List[IntraProcessSubscription]] = {}
+        self._publishers: Dict[int, 'Publisher'] = {}
+        self._gids: Dict[int, bytes] = {}
+
+    @staticmethod
+    def _match(publisher: 'Publisher', ipsub: IntraProcessSubscription) -> bool:
+        subscription = ipsub.subscription
+        if subscription.msg_type is not publisher.msg_type:
+            return False
+        compatibility, _ = qos_check_compatible(
+            publisher.qos_profile, subscription.qos_profile)
+        return compatibility != QoSCompatibility.ERROR
+
+    @staticmethod
+    def _ignore(ipsub: IntraProcessSubscription, gid: bytes, ignore: bool = True) -> None:
+        handle = ipsub.subscription.handle
+        with handle:
+            if ignore:
+                handle.ignore_publisher(gid)
+            else:
+                handle.unignore_publisher(gid)
+
+    def add_publisher(self, publisher: 'Publisher') -> None:
+        topic = publisher.topic_name
+        with publisher.handle:
+            gid = publisher.handle.get_gid()
+        with self._lock:
+            self._publishers[id(publisher)] = publisher
+            self._topics[id(publisher)] = topic
+            self._gids[id(publisher)] = gid
+            self._matches[id(publisher)] = [
+                ipsub for ipsub in self._subscriptions.get(topic, [])
+                if self._match(publisher, ipsub)]
+            for ipsub in self._matches[id(publisher)]:
+                self._ignore(ipsub, gid)
+
+    def remove_publisher(self, publisher: 'Publisher') -> None:
+        with self._lock:
+            self._publishers.pop(id(publisher), None)
+            self._topics.pop(id(publisher), None)
+            gid = self._gids.pop(id(publisher), None)
+            for ipsub in self._matches.pop(id(publisher), []):
+                self._ignore(ipsub, gid, ignore=False)
+
+    def add_subscription(self, ipsub: IntraProcessSubscription) -> None:
+        topic = ipsub.subscription.topic_name
+        with self._lock:
+            self._topics[id(ipsub)] = topic
+            self._subscriptions.setdefault(topic, []).append(ipsub)
+            for key, publisher in self._publishers.items():
+                if self._topics[key] == topic and self._match(publisher, ipsub):
+                    self._ignore(ipsub, self._gids[key])
+                    # Replaced rather than appended to, publish() iterates without the lock
+                    self._matches[key] = self._matches[key] + [ipsub]
+
+    def remove_subscription(self, ipsub: IntraProcessSubscription) -> None:
+        with self._lock:
+            topic = self._topics.pop(id(ipsub), None)
+            if topic is None:
+                return
+            self._subscriptions[topic].remove(ipsub)
+            if not self._subscriptions[topic]:
+                del self._subscriptions[topic]
+            for key, matches in self._matches.items():
+                if ipsub in matches:
+                    self._matches[key] = [match for match in matches if match is not ipsub]
+
+    def has_matches(self, publisher: 'Publisher') -> bool:
+        """Check if a publisher delivers its messages to local subscriptions."""
+        return bool(self._matches.get(id(publisher)))
+
+    def publish(self, publisher: 'Publisher', msg) -> int:
+        """
+        Deliver a message to the local subscriptions matching a publisher.
+
+        :return: The number of subscriptions the message was delivered to.
+        """
+        matches = self._matches.get(id(publisher), [])
+        if not matches:
+            return 0
+        now = time.time_ns()
+        info = {
+            'source_timestamp': now,
+            'received_timestamp': now,
+            'publication_sequence_number': None,
+            'reception_sequence_number': None,
+        }
+        for ipsub in matches:
+            ipsub.deliver(copy.deepcopy(msg), dict(info))
+        return len(matches)
@@ -12,6 +12,7 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+from contextlib import nullcontext
 import math
 import time
 
@@ -64,17 +65,21 @@ from rclpy.executors import Executor
 from rclpy.expand_topic_name import expand_topic_name
 from rclpy.guard_condition import GuardCondition
 from rclpy.impl.implementation_singleton import rclpy_implementation as _rclpy
+from rclpy.intra_process_manager import check_intra_process_qos
+from rclpy.intra_process_manager import IntraProcessSubscription
 from rclpy.logging import get_logger
 from rclpy.logging_service import LoggingService
 from rclpy.parameter import Parameter, PARAMETER_SEPARATOR_STRING
 from rclpy.parameter_service import ParameterService
 from rclpy.publisher import Publisher
+from rclpy.qos import DurabilityPolicy
 from rclpy.qos import qos_profile_parameter_events
 from rclpy.qos import qos_profile_services_default
 from rclpy.qos import QoSProfile
 from rclpy.qos_overriding_options import _declare_qos_parameters
 from rclpy.qos_overriding_options import QoSOverridingOptions
 from rclpy.service import Service
+from rclpy.shared_subscription import SharedSubscriptionGroup
 from rclpy.subscription import Subscription
 from rclpy.time_source import TimeSource
 from rclpy.timer import Rate
@@ -131,7 +136,8 @@ class Node:
         parameter_overrides: Optional[List[Parameter]] = None,
         allow_undeclared_parameters: bool = False,
         automatically_declare_parameters_from_overrides: bool = False,
-        enable_logger_service: bool = False
+        enable_logger_service: bool = False,
+        use_intra_process_comms: bool = False
     ) -> None:
         """
         Create a Node.
@@ -158,6 +164,8 @@ class Node:
         :param enable_logger_service: ``True`` if ROS2 services are created to allow external nodes
             to get and set logger levels of this node. Otherwise, logger levels are only managed
             locally. That is, logger levels cannot be changed remotely.
+        :param use_intra_process_comms: ``True`` if the publishers and subscriptions of the node
+            should use intra-process communication by default, see :func:`create_publisher`.
         """
         self.__handle = None
         self._context = get_default_context() if context is None else context
@@ -175,6 +183,8 @@ class Node:
             List[Callable[[List[Parameter]], SetParametersResult]] = []
         self._post_set_parameters_callbacks: List[Callable[[List[Parameter]], None]] = []
         self._rate_group = ReentrantCallbackGroup()
+        self._use_intra_process_comms = use_intra_process_comms
+        self._intra_process_subscriptions: Dict[Subscription, IntraProcessSubscription] = {}
         self._allow_undeclared_parameters = allow_undeclared_parameters
         self._parameter_overrides = {}
         self._descriptors = {}
@@ -1507,6 +1517,8 @@ class Node:
         event_callbacks: Optional[PublisherEventCallbacks] = None,
         qos_overriding_options: Optional[QoSOverridingOptions] = None,
         publisher_class: Type[Publisher] = Publisher,
+        use_intra_process_comms: Optional[bool] = None,
+        skip_unmatched: bool = False,
     ) -> Publisher:
         """
         Create a new publisher.
@@ -1520,9 +1532,33 @@ class Node:
         :param callback_group: The callback group for the publisher's event handlers.
             If ``None``, then the default callback group for the node is used.
         :param event_callbacks: User-defined callbacks for middleware events.
+        :param use_intra_process_comms: If ``True``, then messages published to subscriptions
+            of the same context using intra-process communication are handed to them as
+            copies, without being serialized, and are published through the middleware as well
+            for the other subscriptions.
+            Serialized and loaned messages are deserialized for the local subscriptions, and
+            :meth:`.Publisher.publish_columns` can't be used.
+            Only volatile durability is supported.
+            If ``None``, then the default of the node is used.
+        :param skip_unmatched: If ``True``, then messages published while no subscription is
+            matched with the publisher are dropped without being converted, by all the publish
+            methods.
+            The matched subscriptions are tracked from the publisher matched events of the
+            middleware, so ``event_callbacks`` can't have a matched callback as well.
+            Transient local durability is not supported, since late joining subscriptions would
+            miss the dropped messages.
         :return: The new publisher.
         """
         qos_profile = self._validate_qos_or_depth_parameter(qos_profile)
+        if skip_unmatched and qos_profile.durability == DurabilityPolicy.TRANSIENT_LOCAL:
+            raise ValueError('skip_unmatched cannot be used with transient local durability')
+        if skip_unmatched and event_callbacks is not None and event_callbacks.matched:
+            # The middleware has a single callback per event type of a publisher
+            raise ValueError('skip_unmatched cannot be used with a matched event callback')
+        if use_intra_process_comms is None:
+            use_intra_process_comms = self._use_intra_process_comms
+        if use_intra_process_comms:
+            check_intra_process_qos(qos_profile)
 
         callback_group = callback_group or self.default_callback_group
 
@@ -1549,20 +1585,26 @@ class Node:
         try:
             with self.handle:
                 publisher_object = _rclpy.Publisher(
-                    self.handle, msg_type, topic, qos_profile.get_c_qos_profile())
+                    self.handle, msg_type, topic, qos_profile.get_c_qos_profile(),
+                    skip_unmatched=skip_unmatched)
         except ValueError:
             failed = True
         if failed:
             self._validate_topic_or_service_name(topic)
 
+        intra_process_kwargs = {}
+        if use_intra_process_comms:
+            intra_process_kwargs['intra_process_manager'] = self._context.intra_process_manager
         try:
             publisher = publisher_class(
                 publisher_object, msg_type, topic, qos_profile,
                 event_callbacks=event_callbacks or PublisherEventCallbacks(),
-                callback_group=callback_group)
+                callback_group=callback_group, **intra_process_kwargs)
         except Exception:
             publisher_object.destroy_when_not_in_use()
             raise
+        if use_intra_process_comms:
+            self._context.intra_process_manager.add_publisher(publisher)
         self._publishers.append(publisher)
         self._wake_executor()
 
@@ -1581,7 +1623,15 @@ class Node:
         callback_group: Optional[CallbackGroup] = None,
         event_callbacks: Optional[SubscriptionEventCallbacks] = None,
         qos_overriding_options: Optional[QoSOverridingOptions] = None,
-        raw: bool = False
+        raw: bool = False,
+        max_batch_size: Optional[int] = None,
+        loaned_messages: bool = False,
+        reuse_message: bool = False,
+        lazy: bool = False,
+        columnar: bool = False,
+        array_views: bool = False,
+        use_intra_process_comms: Optional[bool] = None,
+        shared: bool = False
     ) -> Subscription:
         """
         Create a new subscription.
@@ -1599,8 +1649,83 @@ class Node:
         :param event_callbacks: User-defined callbacks for middleware events.
         :param raw: If ``True``, then received messages will be stored in raw binary
             representation.
+        :param max_batch_size: If not ``None``, all messages available when the subscription
+            is executed are taken at once, up to this many, and the callback is called with a
+            list of them.
+            A callback accepting message info gets a memoryview with one row of
+            ``(source_timestamp, received_timestamp, publication_sequence_number,
+            reception_sequence_number)`` per message instead.
+        :param loaned_messages: If ``True``, then messages are taken without copying them when
+            the middleware can loan them, and the callback is called with a loaned message.
+            Its ``get_member_view()`` exposes a member of primitive type as a read-only
+            memoryview, its ``message`` property converts it with the primitive arrays as
+            such views. It is released once the callback returns, but views keep the loan
+            until they are gone.
+            When the middleware can't loan messages they are taken into storage owned by the
+            loaned message instead.
+        :param reuse_message: If ``True``, then every message is taken into the same message
+            instance, updating its fields in place and reusing its nested messages and arrays,
+            instead of creating a new message each time.
+            The callback must not keep the message or any of its fields, they are overwritten
+            by the next message.
+        :param lazy: If ``True``, then the serialized message is taken and the callback is
+            called with a view of it which decodes a field the first time it is accessed, so
+            reading a few fields of a large message doesn't convert the rest of it.
+            Nested messages are views as well, and arrays and sequences of numbers are read-only
+            NumPy arrays over the serialized message.
+            The full message is obtained with ``view._deserialize()``.
+        :param columnar: If ``True``, then all messages available when the subscription is
+            executed are taken at once, up to ``max_batch_size``, directly into the rows of a
+            preallocated NumPy structured array of data type
+            :func:`rclpy.type_support.get_message_dtype`, without creating Python messages.
+            The callback is called with the filled rows, whose fields are accessible as columns,
+            e.g. ``rows['linear_acceleration']['x']``.
+            A callback accepting message info gets an array of the receive timestamps of the
+            rows, in nanoseconds, instead.
+            Both arrays are overwritten by the next batch.
+            Only message types whose fields all have a fixed size are supported.
+        :param array_views: If ``True``, then fields holding sequences of numeric types,
+            including the ones of nested messages, are read-only memoryviews over the storage
+            of the taken message instead of copies, e.g. ``numpy.asarray(msg.data)`` reads the
+            payload of an image without copying it.
+            Fixed size arrays of numeric types are read-only NumPy arrays over that storage.
+            The storage is kept alive as long as any of the views is.
+        :param use_intra_process_comms: If ``True``, then messages published by publishers of
+            the same context using intra-process communication are received as copies, without
+            being serialized, and the ones they publish through the middleware are ignored.
+            The message info holds the time of the publication, without sequence numbers.
+            Only volatile durability is supported, and none of the options changing the way
+            messages are taken can be used.
+            If ``None``, then the default of the node is used.
+        :param shared: If ``True``, then the subscription shares a single middleware reader with
+            the other shared subscriptions of the context on the same topic, with the same type
+            and the same QoS profile, so every message is received and converted once for all of
+            them.
+            The callback must not modify the message, the other subscriptions get it as well.
+            None of the options changing the way messages are taken can be used.
+            The reader and its event handlers are waited on by the nodes of all the
+            subscriptions of the group, and only the subscription creating the group can set
+            ``event_callbacks``.
         """
         qos_profile = self._validate_qos_or_depth_parameter(qos_profile)
+        if use_intra_process_comms is None:
+            use_intra_process_comms = self._use_intra_process_comms
+        if use_intra_process_comms:
+            check_intra_process_qos(qos_profile)
+            if (
+                raw or max_batch_size is not None or loaned_messages or reuse_message or
+                lazy or columnar or array_views
+            ):
+                raise ValueError(
+                    'intra-process communication cannot be used with options changing the way '
+                    'messages are taken')
+        if shared and (
+            use_intra_process_comms or raw or max_batch_size is not None or loaned_messages or
+            reuse_message or lazy or columnar or array_views
+        ):
+            raise ValueError(
+                'shared subscriptions cannot use intra-process communication or options changing '
+                'the way messages are taken')
 
         callback_group = callback_group or self.default_callback_group
 
@@ -1621,25 +1746,52 @@ class Node:
             Subscription, self, final_topic, qos_profile, qos_overriding_options)
 
         # this line imports the typesupport for the message module if not already done
-        failed = False
         check_is_valid_msg_type(msg_type)
-        try:
-            with self.handle:
-                subscription_object = _rclpy.Subscription(
-                    self.handle, msg_type, topic, qos_profile.get_c_qos_profile())
-        except ValueError:
-            failed = True
-        if failed:
-            self._validate_topic_or_service_name(topic)
+        shared_manager = self._context.shared_subscription_manager if shared else None
+        shared_group = None
+        # Keep the group from being destroyed until the subscription joined it
+        with shared_manager.lock if shared else nullcontext():
+            if shared:
+                shared_group = shared_manager.find_group(final_topic, msg_type, qos_profile)
+            if shared_group is not None:
+                if event_callbacks is not None:
+                    raise ValueError(
+                        'the event callbacks of shared subscriptions are set by the first '
+                        'subscription of the group')
+                subscription_object = shared_group.handle
+            else:
+                failed = False
+                try:
+                    with self.handle:
+                        subscription_object = _rclpy.Subscription(
+                            self.handle, msg_type, topic, qos_profile.get_c_qos_profile())
+                except ValueError:
+                    failed = True
+                if failed:
+                    self._validate_topic_or_service_name(topic)
 
-        try:
-            subscription = Subscription(
-                subscription_object, msg_type,
-                topic, callback, callback_group, qos_profile, raw,
-                event_callbacks=event_callbacks or SubscriptionEventCallbacks())
-        except Exception:
-            subscription_object.destroy_when_not_in_use()
-            raise
+            try:
+                subscription = Subscription(
+                    subscription_object, msg_type,
+                    topic, callback, callback_group, qos_profile, raw,
+                    # The event handlers of a shared reader are owned by its group
+                    event_callbacks=SubscriptionEventCallbacks(use_default_callbacks=False)
+                    if shared else event_callbacks or SubscriptionEventCallbacks(),
+                    max_batch_size=max_batch_size, loaned_messages=loaned_messages,
+                    reuse_message=reuse_message, lazy=lazy, columnar=columnar,
+                    array_views=array_views)
+            except Exception:
+                if shared_group is None:
+                    subscription_object.destroy_when_not_in_use()
+                raise
+            if shared:
+                if shared_group is None:
+                    shared_group = SharedSubscriptionGroup(
+                        subscription_object, msg_type, final_topic, qos_profile, self._context,
+                        shared_manager, event_callbacks or SubscriptionEventCallbacks())
+                    shared_manager.add_group(shared_group)
+                subscription._shared_group = shared_group
+                shared_group.add_subscription(subscription, self)
         callback_group.add_entity(subscription)
         self._subscriptions.append(subscription)
         self._wake_executor()
@@ -1647,6 +1799,12 @@ class Node:
         for event_handler in subscription.event_handlers:
             self.add_waitable(event_handler)
 
+        if use_intra_process_comms:
+            intra_process_subscription = IntraProcessSubscription(subscription, self._context)
+            self._intra_process_subscriptions[subscription] = intra_process_subscription
+            self.add_waitable(intra_process_subscription)
+            self._context.intra_process_manager.add_subscription(intra_process_subscription)
+
         return subscription
 
     def create_client(
@@ -1838,6 +1996,12 @@ class Node:
             self._subscriptions.remove(subscription)
             for event_handler in subscription.event_handlers:
                 self.__waitables.remove(event_handler)
+            intra_process_subscription = self._intra_process_subscriptions.pop(subscription, None)
+            if intra_process_subscription is not None:
+                self._context.intra_process_manager.remove_subscription(
+                    intra_process_subscription)
+                self.__waitables.remove(intra_process_subscription)
+                intra_process_subscription.destroy()
             try:
                 subscription.destroy()
             except InvalidHandle:
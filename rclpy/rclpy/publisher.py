@@ -12,7 +12,7 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
-from typing import TypeVar, Union
+from typing import Any, Callable, Iterable, Mapping, Optional, TYPE_CHECKING, TypeVar, Union
 
 from rclpy.callback_groups import CallbackGroup
 from rclpy.duration import Duration
@@ -20,6 +20,11 @@ from rclpy.event_handler import EventHandler
 from rclpy.event_handler import PublisherEventCallbacks
 from rclpy.impl.implementation_singleton import rclpy_implementation as _rclpy
 from rclpy.qos import QoSProfile
+from rclpy.serialization import deserialize_message
+from rclpy.type_support import get_message_dtype
+
+if TYPE_CHECKING:
+    from rclpy.intra_process_manager import IntraProcessManager
 
 MsgType = TypeVar('MsgType')
 
@@ -34,6 +39,7 @@ class Publisher:
         qos_profile: QoSProfile,
         event_callbacks: PublisherEventCallbacks,
         callback_group: CallbackGroup,
+        intra_process_manager: Optional['IntraProcessManager'] = None,
     ) -> None:
         """
         Create a container for a ROS publisher.
@@ -48,30 +54,183 @@ class Publisher:
         :param msg_type: The type of ROS messages the publisher will publish.
         :param topic: The name of the topic the publisher will publish to.
         :param qos_profile: The quality of service profile to apply to the publisher.
+        :param intra_process_manager: If not ``None``, messages are delivered to the local
+            subscriptions registered with this manager without going through rmw.
+            Serialized and loaned messages are deserialized for them, and
+            :meth:`publish_columns` can't be used.
         """
         self.__publisher = publisher_impl
         self.msg_type = msg_type
         self.topic = topic
         self.qos_profile = qos_profile
+        self._intra_process_manager = intra_process_manager
 
         self.event_handlers: EventHandler = event_callbacks.create_event_handlers(
             callback_group, publisher_impl, topic)
 
-    def publish(self, msg: Union[MsgType, bytes]) -> None:
+    def publish(self, msg: Union[MsgType, bytes, bytearray, memoryview]) -> None:
         """
         Send a message to the topic for the publisher.
 
-        :param msg: The ROS message to publish.
+        :param msg: The ROS message to publish, or a serialized message as any object
+            supporting the buffer protocol, which is published without copying it first.
         :raises: TypeError if the type of the passed message isn't an instance
-          of the provided type when the publisher was constructed.
+          of the provided type when the publisher was constructed, nor a buffer.
         """
         with self.handle:
             if isinstance(msg, self.msg_type):
                 self.__publisher.publish(msg)
-            elif isinstance(msg, bytes):
-                self.__publisher.publish_raw(msg)
+                self._deliver_locally([msg])
+                return
+            try:
+                memoryview(msg).release()
+            except TypeError:
+                raise TypeError(
+                    'Expected {} or a buffer, got {}'.format(self.msg_type, type(msg))) from None
+            self.__publisher.publish_raw(msg)
+            if self._has_local_matches():
+                self._deliver_locally([deserialize_message(msg, self.msg_type)])
+
+    def _has_local_matches(self) -> bool:
+        return (
+            self._intra_process_manager is not None and
+            self._intra_process_manager.has_matches(self))
+
+    def _deliver_locally(self, msgs: Iterable[MsgType]) -> None:
+        """
+        Deliver messages to the local subscriptions matching the publisher.
+
+        The messages are published through rmw as well, which the local subscriptions ignore:
+        the subscription count of rmw can't tell whether all the subscriptions it matched are
+        local while discovery is ongoing, so skipping rmw could drop the messages of remote
+        subscriptions.
+        """
+        if self._intra_process_manager is None:
+            return
+        for msg in msgs:
+            self._intra_process_manager.publish(self, msg)
+
+    def publish_lazy(self, build_message: Callable[[], MsgType]) -> bool:
+        """
+        Build and send a message only if a subscription is matched with the publisher.
+
+        :param build_message: A callable returning the message to publish, which is only called
+            if a subscription is matched.
+        :return: ``True`` if the message was built and published, ``False`` otherwise.
+        """
+        with self.handle:
+            if not self.__publisher.has_matched_subscriptions():
+                return False
+        self.publish(build_message())
+        return True
+
+    def publish_raw_many(self, msgs: Iterable[Union[bytes, bytearray, memoryview]]) -> None:
+        """
+        Send several serialized messages to the topic for the publisher.
+
+        The messages are published from their memory in order, with the GIL released.
+        They are deserialized for the local subscriptions of an intra-process publisher.
+
+        :param msgs: Serialized messages, as objects supporting the buffer protocol.
+        :raises: TypeError if one of the messages doesn't support the buffer protocol, in
+            which case none of them is published.
+        """
+        with self.handle:
+            if self._has_local_matches():
+                msgs = list(msgs)
+                local_msgs = [deserialize_message(msg, self.msg_type) for msg in msgs]
             else:
-                raise TypeError('Expected {}, got {}'.format(self.msg_type, type(msg)))
+                local_msgs = []
+            self.__publisher.publish_raw_many(msgs)
+            self._deliver_locally(local_msgs)
+
+    def publish_columns(self, columns: Union[Mapping[str, Any], Any]) -> None:
+        """
+        Send messages whose fields are given as columns, one message per row.
+
+        The C messages are filled from the columns and published in a single call, with the
+        GIL released, without creating Python messages.
+        Only message types whose fields all have a fixed size are supported.
+
+        :param columns: Either a dictionary of field names to array-likes holding the values of
+            the field for every message, e.g. ``{'linear.x': xs, 'angular.z': zs}``, fields of
+            nested messages being named by joining the names with dots, or a NumPy structured
+            array of data type :func:`rclpy.type_support.get_message_dtype` holding a message
+            per row.
+            Fields missing from the dictionary keep their default values.
+        :raises: ValueError if the message type doesn't have a fixed layout, if a column is not
+            a field of the message type, if the columns have different lengths or if the
+            publisher uses intra-process communication, since no Python message is created for
+            the local subscriptions.
+        :raises: TypeError if a structured array doesn't have the data type of the message type.
+        """
+        if self._intra_process_manager is not None:
+            raise ValueError('columns cannot be published with intra-process communication')
+        import numpy
+        dtype = get_message_dtype(self.msg_type)
+        if isinstance(columns, Mapping):
+            values = {}
+            for name, column in columns.items():
+                field_dtype = dtype
+                for part in name.split('.'):
+                    if field_dtype.names is None or part not in field_dtype.names:
+                        raise ValueError(f"'{name}' is not a field of {self.msg_type.__name__}")
+                    field_dtype = field_dtype[part]
+                values[name] = numpy.ascontiguousarray(column, field_dtype.base)
+            with self.handle:
+                self.__publisher.publish_columns(values)
+        else:
+            rows = numpy.ascontiguousarray(columns)
+            if rows.dtype != dtype:
+                raise TypeError(
+                    f'Expected an array of data type {dtype}, got {rows.dtype}')
+            with self.handle:
+                self.__publisher.publish_array(rows)
+
+    def borrow_loaned_message(self) -> _rclpy.LoanedMessage:
+        """
+        Borrow a message to be filled in place and published with :meth:`publish_loaned`.
+
+        If the middleware can loan messages the message lives in middleware memory, so filling
+        it and publishing it doesn't copy the data.
+        Otherwise the message is allocated by rclpy and publishing it does a regular publish.
+
+        Members of primitive types, including arrays and sequences of them, are exposed as
+        writable memoryviews with ``get_member_view()``, e.g.
+        ``numpy.frombuffer(msg.get_member_view('data'), numpy.uint8)``.
+        The views, and any array created from them, must be gone or released before the
+        message is published or released.
+        The message must be released if it is not published, e.g. by using it as a context
+        manager.
+
+        :return: The borrowed message.
+        """
+        with self.handle:
+            return self.__publisher.borrow_loaned_message(self.msg_type)
+
+    def publish_loaned(self, msg: _rclpy.LoanedMessage) -> None:
+        """
+        Publish a message returned by :meth:`borrow_loaned_message`.
+
+        The message is released and can no longer be accessed after it was published.
+        It is always published through rmw, local subscriptions of an intra-process publisher
+        get a copy of it.
+
+        :param msg: The borrowed message.
+        :raises: ValueError if the message was released or borrowed from another publisher.
+        :raises: BufferError if views of the message still exist.
+        """
+        with self.handle:
+            local_msg = msg.message if self._has_local_matches() else None
+            self.__publisher.publish_loaned(msg)
+            if local_msg is not None:
+                self._deliver_locally([local_msg])
+
+    @property
+    def can_loan_messages(self) -> bool:
+        """Whether borrowed messages live in middleware memory."""
+        with self.handle:
+            return self.__publisher.can_loan_messages()
 
     def get_subscription_count(self) -> int:
         """Get the amount of subscribers that this publisher has."""
@@ -88,6 +247,8 @@ class Publisher:
         return self.__publisher
 
     def destroy(self):
+        if self._intra_process_manager is not None:
+            self._intra_process_manager.remove_publisher(self)
         for handler in self.event_handlers:
             handler.destroy()
         self.__publisher.destroy_when_not_in_use()
@@ -12,6 +12,8 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+from typing import Iterable, List, Sequence, Tuple
+
 from rclpy.impl.implementation_singleton import rclpy_implementation as _rclpy
 from rclpy.type_support import check_for_type_support
 
@@ -29,14 +31,83 @@ def serialize_message(message) -> bytes:
     return _rclpy.rclpy_serialize(message, message_type)
 
 
-def deserialize_message(serialized_message: bytes, message_type):
+def serialize_message_into(message, buffer, offset: int = 0) -> int:
+    """
+    Serialize a ROS message into an existing buffer.
+
+    :param message: The ROS message to serialize.
+    :param buffer: A writable buffer, e.g. a bytearray or a memoryview.
+    :param offset: Where to write the serialized message in the buffer, in bytes.
+    :return: The size of the serialized message, or its negated size if it does not fit in
+        the buffer, in which case nothing is written.
+    """
+    message_type = type(message)
+    # this line imports the typesupport for the message module if not already done
+    check_for_type_support(message_type)
+    return _rclpy.rclpy_serialize_into(message, message_type, buffer, offset)
+
+
+def serialized_message_size(message) -> int:
+    """
+    Get the size of a ROS message once serialized.
+
+    The message is converted and serialized into a buffer reused by the calling thread to get
+    its size, so this costs about as much as serializing it.
+    To fill a buffer, call :func:`serialize_message_into` directly instead of sizing the buffer
+    first: it reports the size needed when the buffer is too small.
+
+    :param message: The ROS message.
+    :return: The size of the serialized message, in bytes.
+    """
+    message_type = type(message)
+    # this line imports the typesupport for the message module if not already done
+    check_for_type_support(message_type)
+    return _rclpy.rclpy_serialized_size(message, message_type)
+
+
+def deserialize_message(serialized_message, message_type):
     """
     Deserialize a ROS message.
 
-    :param serialized_message: The ROS message to deserialize.
+    :param serialized_message: The ROS message to deserialize, any object supporting the buffer
+        protocol such as bytes or a memoryview of a part of a larger buffer.
     :param message_type: The type of the serialized ROS message.
     :return: The deserialized ROS message.
     """
     # this line imports the typesupport for the message module if not already done
     check_for_type_support(message_type)
     return _rclpy.rclpy_deserialize(serialized_message, message_type)
+
+
+def serialize_messages(messages: Iterable, message_type) -> Tuple[bytes, memoryview]:
+    """
+    Serialize ROS messages of one type into a single buffer.
+
+    This is faster than serializing the messages one by one: the type support is looked up
+    once, a single C message is reused and the serialization runs with the GIL released.
+
+    :param messages: The ROS messages to serialize.
+    :param message_type: The type of the ROS messages.
+    :return: The serialized messages concatenated, and the offsets of the messages in it as
+        unsigned 64-bit integers: message ``i`` spans from ``offsets[i]`` to
+        ``offsets[i + 1]``.
+    """
+    # this line imports the typesupport for the message module if not already done
+    check_for_type_support(message_type)
+    return _rclpy.rclpy_serialize_batch(messages, message_type)
+
+
+def deserialize_messages(serialized_messages, offsets: Sequence[int], message_type) -> List:
+    """
+    Deserialize ROS messages of one type from a single buffer.
+
+    :param serialized_messages: The serialized messages, any object supporting the buffer
+        protocol.
+    :param offsets: The offsets of the messages in the buffer, as returned by
+        :func:`serialize_messages`.
+    :param message_type: The type of the serialized ROS messages.
+    :return: The deserialized ROS messages.
+    """
+    # this line imports the typesupport for the message module if not already done
+    check_for_type_support(message_type)
+    return _rclpy.rclpy_deserialize_batch(serialized_messages, offsets, message_type)
@@ -0,0 +1,208 @@
+# Copyright 2026 Open Source Robotics Foundation, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import threading
+from typing import Dict
+from typing import List
+from typing import Optional
+from typing import Tuple
+from typing import TYPE_CHECKING
+
+from rclpy.callback_groups import MutuallyExclusiveCallbackGroup
+from rclpy.event_handler import EventHandler
+from rclpy.event_handler import SubscriptionEventCallbacks
+from rclpy.impl.implementation_singleton import rclpy_implementation as _rclpy
+from rclpy.intra_process_manager import IntraProcessSubscription
+from rclpy.qos import HistoryPolicy
+from rclpy.qos import QoSProfile
+from rclpy.waitable import NumberOfEntities
+from rclpy.waitable import Waitable
+
+if TYPE_CHECKING:
+    from rclpy.context import Context
+    from rclpy.node import Node
+    from rclpy.subscription import Subscription
+
+
+class SharedSubscriptionGroup(Waitable):
+    """
+    Waitable taking the messages of a subscription shared by several Python subscriptions.
+
+    Every message is taken and converted once, then handed to a queue per Python subscription
+    of the group, which calls the callback of the subscription when executed.
+    The group and its event handlers are waited on by the nodes of all its subscriptions, so
+    the messages are taken as long as any of them is spun.
+    Being in a mutually exclusive callback group, the group is executed by one executor at a
+    time, which keeps the messages in order.
+    """
+
+    def __init__(
+        self,
+        subscription_impl: _rclpy.Subscription,
+        msg_type,
+        topic_name: str,
+        qos_profile: QoSProfile,
+        context: 'Context',
+        manager: 'SharedSubscriptionManager',
+        event_callbacks: SubscriptionEventCallbacks,
+    ) -> None:
+        """
+        Create a group for a subscription shared by several Python subscriptions.
+
+        :param event_callbacks: The callbacks for the middleware events of the subscription,
+            whose handlers are created once for the whole group.
+        """
+        super().__init__(MutuallyExclusiveCallbackGroup())
+        self.__subscription = subscription_impl
+        self.msg_type = msg_type
+        self.topic_name = topic_name
+        self.qos_profile = qos_profile
+        self._context = context
+        self._manager = manager
+        # The subscriptions of the group, with their queue and node, oldest first
+        self._members: List[Tuple['Subscription', IntraProcessSubscription, 'Node']] = []
+        keep_all = qos_profile.history == HistoryPolicy.KEEP_ALL or qos_profile.depth == 0
+        # Messages taken at once, older ones would be dropped from the queues anyway
+        self._max_take = None if keep_all else qos_profile.depth
+        self._sub_index = None
+        self.event_handlers: List[EventHandler] = event_callbacks.create_event_handlers(
+            self.callback_group, subscription_impl, topic_name)
+
+    @property
+    def handle(self):
+        return self.__subscription
+
+    def add_subscription(self, subscription: 'Subscription', node: 'Node') -> None:
+        """Add a subscription to the group, the callback of which gets the taken messages."""
+        queue = IntraProcessSubscription(subscription, self._context)
+        with self._manager.lock:
+            is_new_node = all(member[2] is not node for member in self._members)
+            self._members.append((subscription, queue, node))
+        node.add_waitable(queue)
+        if is_new_node:
+            node.add_waitable(self)
+            for handler in self.event_handlers:
+                node.add_waitable(handler)
+
+    def remove_subscription(self, subscription: 'Subscription') -> None:
+        """Remove a subscription from the group, destroying the group with its last one."""
+        with self._manager.lock:
+            index = next(
+                (i for i, member in enumerate(self._members) if member[0] is subscription),
+                None)
+            if index is None:
+                return
+            _, queue, node = self._members.pop(index)
+            is_last_of_node = all(member[2] is not node for member in self._members)
+            is_last = not self._members
+            if is_last:
+                self._manager._remove_group(self)
+        node.remove_waitable(queue)
+        queue.destroy()
+        if is_last_of_node:
+            node.remove_waitable(self)
+            for handler in self.event_handlers:
+                node.remove_waitable(handler)
+        if is_last:
+            for handler in self.event_handlers:
+                handler.destroy()
+            self.__subscription.destroy_when_not_in_use()
+
+    # Start Waitable API
+    def is_ready(self, wait_set):
+        """Return True if entities are ready in the wait set."""
+        if self._sub_index is None:
+            return False
+        return wait_set.is_ready('subscription', self._sub_index)
+
+    def take_data(self):
+        """Take the messages available so the wait set doesn't immediately wake again."""
+        taken = []
+        with self.__subscription:
+            while self._max_take is None or len(taken) < self._max_take:
+                msg_and_info = self.__subscription.take_message(self.msg_type, False)
+                if msg_and_info is None:
+                    break
+                taken.append(msg_and_info)
+        return taken
+
+    async def execute(self, taken_data):
+        """Hand the taken messages to the queues of the subscriptions of the group."""
+        with self._manager.lock:
+            queues = [queue for _, queue, _ in self._members]
+        for msg, info in taken_data:
+            for queue in queues:
+                queue.deliver(msg, dict(info))
+
+    def get_num_entities(self):
+        """Return number of each type of entity used."""
+        return NumberOfEntities(num_subs=1)
+
+    def add_to_wait_set(self, wait_set):
+        """Add entites to wait set."""
+        with self.__subscription:
+            self._sub_index = wait_set.add_subscription(self.__subscription)
+
+    def add_to_events_queue(self, events_queue, waitable_id):
+        """Push the identifier to the events queue when messages are received."""
+        with self.__subscription:
+            events_queue.add_subscription(self.__subscription, waitable_id)
+        return True
+
+    def __enter__(self):
+        """Mark the subscription as in-use to prevent destruction while waiting on it."""
+        self.__subscription.__enter__()
+
+    def __exit__(self, t, v, tb):
+        """Mark the subscription as not-in-use to allow destruction after waiting on it."""
+        self.__subscription.__exit__(t, v, tb)
+    # End Waitable API
+
+
+class SharedSubscriptionManager:
+    """
+    Share a subscription between the Python subscriptions of a context with the same topic.
+
+    Python subscriptions created with ``shared=True`` on the same topic, with the same type and
+    the same QoS profile form a :class:`SharedSubscriptionGroup`, so a single middleware reader
+    receives and converts every message once for all of them.
+    """
+
+    def __init__(self) -> None:
+        # Held while finding a group and adding a subscription to it, so it isn't destroyed
+        # meanwhile
+        self.lock = threading.RLock()
+        self._groups: Dict[str, List[SharedSubscriptionGroup]] = {}
+
+    def find_group(
+        self, topic_name: str, msg_type, qos_profile: QoSProfile
+    ) -> Optional[SharedSubscriptionGroup]:
+        """Get the group of the subscriptions with the given topic, type and QoS, if any."""
+        with self.lock:
+            for group in self._groups.get(topic_name, []):
+                if group.msg_type is msg_type and group.qos_profile == qos_profile:
+                    return group
+        return None
+
+    def add_group(self, group: SharedSubscriptionGroup) -> None:
+        with self.lock:
+            self._groups.setdefault(group.topic_name, []).append(group)
+
+    def _remove_group(self, group: SharedSubscriptionGroup) -> None:
+        with self.lock:
+            groups = self._groups.get(group.topic_name, [])
+            if group in groups:
+                groups.remove(group)
+            if not groups:
+                self._groups.pop(group.topic_name, None)
@@ -15,6 +15,7 @@
 from enum import Enum
 import inspect
 from typing import Callable
+from typing import Optional
 from typing import TypeVar
 
 from rclpy.callback_groups import CallbackGroup
@@ -22,6 +23,7 @@ from rclpy.event_handler import EventHandler
 from rclpy.event_handler import SubscriptionEventCallbacks
 from rclpy.impl.implementation_singleton import rclpy_implementation as _rclpy
 from rclpy.qos import QoSProfile
+from rclpy.type_support import get_message_dtype
 
 
 # For documentation only
@@ -44,6 +46,12 @@ class Subscription:
          qos_profile: QoSProfile,
          raw: bool,
          event_callbacks: SubscriptionEventCallbacks,
+         max_batch_size: Optional[int] = None,
+         loaned_messages: bool = False,
+         reuse_message: bool = False,
+         lazy: bool = False,
+         columnar: bool = False,
+         array_views: bool = False,
     ) -> None:
         """
         Create a container for a ROS subscription.
@@ -62,7 +70,43 @@ class Subscription:
         :param qos_profile: The quality of service profile to apply to the subscription.
         :param raw: If ``True``, then received messages will be stored in raw binary
             representation.
+        :param max_batch_size: If not ``None``, the callback is called with a list of up to
+            this many messages instead of a single message.
+        :param loaned_messages: If ``True``, then the callback is called with messages loaned
+            from the middleware, which are released when the callback returns. Views of the
+            payload of a message keep its loan until they are gone.
+        :param reuse_message: If ``True``, then every message is taken into the same message
+            instance, which the callback must not keep.
+        :param lazy: If ``True``, then the callback is called with a view of the serialized
+            message decoding its fields on access.
+        :param columnar: If ``True``, then up to ``max_batch_size`` messages are taken at once
+            into the rows of a NumPy structured array and the callback is called with the
+            filled rows.
+        :param array_views: If ``True``, then sequences of numeric types of the messages are
+            read-only memoryviews and fixed size arrays of them read-only NumPy arrays over the
+            taken C messages.
         """
+        if max_batch_size is not None and max_batch_size < 1:
+            raise ValueError('max_batch_size must be greater than zero')
+        if loaned_messages and (raw or max_batch_size is not None):
+            raise ValueError('loaned_messages can not be combined with raw or max_batch_size')
+        if reuse_message and (raw or max_batch_size is not None or loaned_messages):
+            raise ValueError(
+                'reuse_message can not be combined with raw, max_batch_size or loaned_messages')
+        if lazy and (raw or max_batch_size is not None or loaned_messages or reuse_message):
+            raise ValueError(
+                'lazy can not be combined with raw, max_batch_size, loaned_messages or '
+                'reuse_message')
+        if columnar and (max_batch_size is None or raw or loaned_messages or reuse_message or
+                         lazy):
+            raise ValueError(
+                'columnar requires max_batch_size and can not be combined with raw, '
+                'loaned_messages, reuse_message or lazy')
+        if array_views and (raw or max_batch_size is not None or loaned_messages or
+                            reuse_message or lazy):
+            raise ValueError(
+                'array_views can not be combined with raw, max_batch_size, loaned_messages, '
+                'reuse_message or lazy')
         self.__subscription = subscription_impl
         self.msg_type = msg_type
         self.topic = topic
@@ -72,6 +116,22 @@ class Subscription:
         self._executor_event = False
         self.qos_profile = qos_profile
         self.raw = raw
+        self.max_batch_size = max_batch_size
+        self.loaned_messages = loaned_messages
+        # The instance messages are taken into if they are reused
+        self.reused_message = msg_type() if reuse_message else None
+        self.lazy = lazy
+        self.array_views = array_views
+        # The arrays messages and their receive timestamps are taken into if columnar
+        self.columns = None
+        if columnar:
+            import numpy
+            self.columns = (
+                numpy.zeros(max_batch_size, get_message_dtype(msg_type)),
+                numpy.zeros(max_batch_size, numpy.int64))
+
+        # The group whose middleware reader the subscription shares, if any
+        self._shared_group = None
 
         self.event_handlers: EventHandler = event_callbacks.create_event_handlers(
             callback_group, subscription_impl, topic)
@@ -85,10 +145,20 @@ class Subscription:
     def handle(self):
         return self.__subscription
 
+    @property
+    def shared(self) -> bool:
+        """Whether the subscription shares its middleware reader with other subscriptions."""
+        return self._shared_group is not None
+
     def destroy(self):
         for handler in self.event_handlers:
             handler.destroy()
-        self.handle.destroy_when_not_in_use()
+        if self._shared_group is not None:
+            # The group destroys the reader with its last subscription
+            self._shared_group.remove_subscription(self)
+            self._shared_group = None
+        else:
+            self.handle.destroy_when_not_in_use()
 
     @property
     def topic_name(self):
@@ -13,6 +13,7 @@
 # limitations under the License.
 
 from rclpy.exceptions import NoTypeSupportImportedException
+from rclpy.impl.implementation_singleton import rclpy_implementation as _rclpy
 
 
 def check_for_type_support(msg_or_srv_type):
@@ -47,6 +48,22 @@ def check_is_valid_msg_type(msg_type):
         ) from None
 
 
+def get_message_dtype(msg_type):
+    """
+    Get the NumPy structured data type matching the C struct of a message type.
+
+    Only message types whose fields are all primitive values, fixed size arrays of them or
+    nested messages of such types are supported.
+    An array of this data type has the memory layout of an array of C messages.
+
+    :param msg_type: The message type.
+    :return: The ``numpy.dtype``.
+    :raises ValueError: If the fields of the message type don't have a fixed size.
+    """
+    check_for_type_support(msg_type)
+    return _rclpy.rclpy_get_message_dtype(msg_type)
+
+
 def check_is_valid_srv_type(srv_type):
     check_for_type_support(srv_type)
     try:
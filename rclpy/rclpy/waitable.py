@@ -98,3 +98,31 @@ class Waitable:
     def add_to_wait_set(self, wait_set):
         """Add entities to wait set."""
         raise NotImplementedError('Must be implemented by subclass')
+
+    def add_to_events_queue(self, events_queue, waitable_id: int) -> bool:
+        """
+        Make the entities push an identifier to an events queue when they are ready.
+
+        Used by the :class:`rclpy.executors.EventsExecutor`.
+        When the identifier is popped from the queue :meth:`take_data` is called without
+        :meth:`is_ready`, once per push whatever the number of events pushed, so it must take
+        all the data available or push the identifier again for the rest.
+
+        :param events_queue: The ``_rclpy.EventsQueue`` to push to.
+        :param waitable_id: The identifier to add the entities with.
+        :return: ``False`` if the waitable can't be used with an events queue, in which case
+            the executor waits on it with a wait set.
+        """
+        return False
+
+    def remove_from_events_queue(self, events_queue, waitable_id: int) -> None:
+        """
+        Make the entities stop pushing to an events queue they were added to.
+
+        Used by the :class:`rclpy.executors.EventsExecutor` for the waitables whose
+        :meth:`add_to_events_queue` returned ``True``, when they are removed from it.
+
+        :param events_queue: The ``_rclpy.EventsQueue`` the waitable was added to.
+        :param waitable_id: The identifier the entities were added with.
+        """
+        events_queue.remove(waitable_id)
@@ -25,6 +25,7 @@
 #include "action_client.hpp"
 #include "action_goal_handle.hpp"
 #include "action_server.hpp"
+#include "callback_group.hpp"
 #include "client.hpp"
 #include "clock.hpp"
 #include "context.hpp"
@@ -32,12 +33,19 @@
 #include "duration.hpp"
 #include "clock_event.hpp"
 #include "event_handle.hpp"
+#include "events_queue.hpp"
 #include "exceptions.hpp"
+#include "executor_core.hpp"
 #include "graph.hpp"
 #include "guard_condition.hpp"
+#include "introspection.hpp"
+#include "lazy_message.hpp"
 #include "lifecycle.hpp"
+#include "loaned_message.hpp"
 #include "logging.hpp"
 #include "logging_api.hpp"
+#include "member_buffer.hpp"
+#include "multi_threaded_executor_core.hpp"
 #include "names.hpp"
 #include "node.hpp"
 #include "publisher.hpp"
@@ -56,7 +64,12 @@
 
 namespace py = pybind11;
 
+// The extension doesn't rely on the GIL, so it doesn't enable it again on free-threaded builds
+#if PYBIND11_VERSION_HEX >= 0x020D0000
+PYBIND11_MODULE(_rclpy_pybind11, m, py::mod_gil_not_used()) {
+#else
 PYBIND11_MODULE(_rclpy_pybind11, m) {
+#endif
   m.doc() = "ROS 2 Python client library.";
 
   rclpy::define_destroyable(m);
@@ -150,10 +163,16 @@ PYBIND11_MODULE(_rclpy_pybind11, m) {
     "Get an action RMW QoS profile.");
   rclpy::define_guard_condition(m);
   rclpy::define_timer(m);
+  rclpy::define_lazy_message(m);
+  rclpy::define_loaned_message(m);
+  rclpy::define_member_buffer(m);
   rclpy::define_subscription(m);
   rclpy::define_time_point(m);
   rclpy::define_clock(m);
   rclpy::define_waitset(m);
+  rclpy::define_callback_group_state(m);
+  rclpy::define_executor_core(m);
+  rclpy::define_multi_threaded_executor_core(m);
 
   m.def(
     "rclpy_expand_topic_name", &rclpy::expand_topic_name,
@@ -214,12 +233,30 @@ PYBIND11_MODULE(_rclpy_pybind11, m) {
   m.def(
     "rclpy_serialize", &rclpy::serialize,
     "Serialize a ROS message.");
+  m.def(
+    "rclpy_serialize_into", &rclpy::serialize_into,
+    "Serialize a ROS message into an existing buffer.");
+  m.def(
+    "rclpy_serialized_size", &rclpy::serialized_size,
+    "Get the size of a serialized ROS message.");
   m.def(
     "rclpy_deserialize", &rclpy::deserialize,
     "Deserialize a ROS message.");
+  m.def(
+    "rclpy_serialize_batch", &rclpy::serialize_batch,
+    "Serialize ROS messages of one type into a single buffer.");
+  m.def(
+    "rclpy_deserialize_batch", &rclpy::deserialize_batch,
+    "Deserialize ROS messages of one type from a single buffer.");
+  m.def(
+    "rclpy_get_message_dtype", [](py::object pymsg_type) {
+      return rclpy::get_message_dtype(rclpy::get_message_members(pymsg_type));
+    },
+    "Get the NumPy data type matching the C struct of a ROS message of fixed layout.");
 
   rclpy::define_node(m);
   rclpy::define_event_handle(m);
+  rclpy::define_events_queue(m);
 
   m.def(
     "rclpy_get_rmw_implementation_identifier",
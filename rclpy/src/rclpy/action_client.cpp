@@ -22,6 +22,7 @@
 #include <rmw/types.h>
 
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include "action_client.hpp"
@@ -109,8 +110,12 @@ ActionClient::ActionClient(
   /* taken_msg is always destroyed in this function */ \
   auto taken_msg = create_from_py(pymsg_type); \
   rmw_request_id_t header; \
-  rcl_ret_t ret = rcl_action_take_ ## Type ## _response( \
-    rcl_action_client_.get(), &header, taken_msg.get()); \
+  rcl_ret_t ret; \
+  { \
+    auto lock = lock_releasing_gil(mutex_); \
+    ret = rcl_action_take_ ## Type ## _response( \
+      rcl_action_client_.get(), &header, taken_msg.get()); \
+  } \
   int64_t sequence = header.sequence_number; \
   /* Create the tuple to return */ \
   if (RCL_RET_ACTION_CLIENT_TAKE_FAILED == ret || RCL_RET_ACTION_SERVER_TAKE_FAILED == ret) { \
@@ -129,8 +134,12 @@ ActionClient::take_goal_response(py::object pymsg_type)
 #define SEND_SERVICE_REQUEST(Type) \
   auto ros_request = convert_from_py(pyrequest); \
   int64_t sequence_number; \
-  rcl_ret_t ret = rcl_action_send_ ## Type ## _request( \
-    rcl_action_client_.get(), ros_request.get(), &sequence_number); \
+  rcl_ret_t ret; \
+  { \
+    auto lock = lock_releasing_gil(mutex_); \
+    ret = rcl_action_send_ ## Type ## _request( \
+      rcl_action_client_.get(), ros_request.get(), &sequence_number); \
+  } \
   if (RCL_RET_OK != ret) { \
     throw rclpy::RCLError("Failed to send " #Type " request"); \
   } \
@@ -150,7 +159,11 @@ ActionClient::take_cancel_response(py::object pymsg_type)
 
 #define TAKE_MESSAGE(Type) \
   auto taken_msg = create_from_py(pymsg_type); \
-  rcl_ret_t ret = rcl_action_take_ ## Type(rcl_action_client_.get(), taken_msg.get()); \
+  rcl_ret_t ret; \
+  { \
+    auto lock = lock_releasing_gil(mutex_); \
+    ret = rcl_action_take_ ## Type(rcl_action_client_.get(), taken_msg.get()); \
+  } \
   if (RCL_RET_OK != ret) { \
     if (RCL_RET_ACTION_CLIENT_TAKE_FAILED == ret) { \
       /* if take failed, just do nothing */ \
@@ -232,6 +245,7 @@ ActionClient::is_action_server_available()
 void
 ActionClient::add_to_waitset(WaitSet & wait_set)
 {
+  auto lock = lock_releasing_gil(mutex_);
   rcl_ret_t ret = rcl_action_wait_set_add_action_client(
     wait_set.rcl_ptr(), rcl_action_client_.get(), NULL, NULL);
   if (RCL_RET_OK != ret) {
@@ -248,14 +262,18 @@ ActionClient::is_ready(WaitSet & wait_set)
   bool is_goal_response_ready = false;
   bool is_cancel_response_ready = false;
   bool is_result_response_ready = false;
-  rcl_ret_t ret = rcl_action_client_wait_set_get_entities_ready(
-    wait_set.rcl_ptr(),
-    rcl_action_client_.get(),
-    &is_feedback_ready,
-    &is_status_ready,
-    &is_goal_response_ready,
-    &is_cancel_response_ready,
-    &is_result_response_ready);
+  rcl_ret_t ret;
+  {
+    auto lock = lock_releasing_gil(mutex_);
+    ret = rcl_action_client_wait_set_get_entities_ready(
+      wait_set.rcl_ptr(),
+      rcl_action_client_.get(),
+      &is_feedback_ready,
+      &is_status_ready,
+      &is_goal_response_ready,
+      &is_cancel_response_ready,
+      &is_result_response_ready);
+  }
   if (RCL_RET_OK != ret) {
     throw rclpy::RCLError("Failed to get number of ready entities for action client");
   }
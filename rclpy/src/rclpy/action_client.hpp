@@ -21,6 +21,7 @@
 #include <rmw/types.h>
 
 #include <memory>
+#include <mutex>
 
 #include "destroyable.hpp"
 #include "node.hpp"
@@ -229,6 +230,8 @@ public:
 private:
   Node node_;
   std::shared_ptr<rcl_action_client_t> rcl_action_client_;
+  /// Serializes the use of the rcl action client, whose functions are not thread safe
+  std::mutex mutex_;
 };
 /// Define a pybind11 wrapper for an rcl_time_point_t
 /**
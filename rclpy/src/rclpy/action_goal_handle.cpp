@@ -20,6 +20,7 @@
 #include <rcl_action/types.h>
 
 #include <memory>
+#include <mutex>
 
 #include "action_goal_handle.hpp"
 #include "action_server.hpp"
@@ -42,6 +43,7 @@ ActionGoalHandle::ActionGoalHandle(
     throw py::error_already_set();
   }
 
+  auto lock = lock_releasing_gil(action_server.mutex());
   auto rcl_handle = rcl_action_accept_new_goal(
     action_server.rcl_ptr(), goal_info_msg_ptr);
   if (!rcl_handle) {
@@ -78,6 +80,7 @@ rcl_action_goal_state_t
 ActionGoalHandle::get_status()
 {
   rcl_action_goal_state_t status;
+  auto lock = lock_releasing_gil(action_server_.mutex());
   rcl_ret_t ret = rcl_action_goal_handle_get_status(rcl_action_goal_handle_.get(), &status);
   if (RCL_RET_OK != ret) {
     throw rclpy::RCLError("Failed to get goal status");
@@ -86,9 +89,17 @@ ActionGoalHandle::get_status()
   return status;
 }
 
+bool
+ActionGoalHandle::is_active()
+{
+  auto lock = lock_releasing_gil(action_server_.mutex());
+  return rcl_action_goal_handle_is_active(rcl_action_goal_handle_.get());
+}
+
 void
 ActionGoalHandle::update_goal_state(rcl_action_goal_event_t event)
 {
+  auto lock = lock_releasing_gil(action_server_.mutex());
   rcl_ret_t ret = rcl_action_update_goal_state(rcl_action_goal_handle_.get(), event);
   if (RCL_RET_OK != ret) {
     throw rclpy::RCLError("Failed to update goal state");
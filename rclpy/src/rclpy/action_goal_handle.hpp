@@ -56,10 +56,7 @@ public:
 
   /// Check if the goal is still active
   bool
-  is_active()
-  {
-    return rcl_action_goal_handle_is_active(rcl_ptr());
-  }
+  is_active();
 
   /// Get rcl_action goal handle_t pointer
   rcl_action_goal_handle_t *
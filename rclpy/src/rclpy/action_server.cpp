@@ -23,6 +23,7 @@
 #include <rmw/types.h>
 
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 
@@ -32,6 +33,7 @@
 #include "clock.hpp"
 #include "exceptions.hpp"
 #include "node.hpp"
+#include "utils.hpp"
 
 namespace rclpy
 {
@@ -113,8 +115,12 @@ ActionServer::ActionServer(
   /* taken_msg is always destroyed in this function */ \
   auto taken_msg = create_from_py(pymsg_type); \
   rmw_request_id_t header; \
-  rcl_ret_t ret = \
-    rcl_action_take_ ## Type ## _request(rcl_action_server_.get(), &header, taken_msg.get()); \
+  rcl_ret_t ret; \
+  { \
+    auto lock = lock_releasing_gil(*mutex_); \
+    ret = rcl_action_take_ ## Type ## _request( \
+      rcl_action_server_.get(), &header, taken_msg.get()); \
+  } \
   /* Create the tuple to return */ \
   if (ret == RCL_RET_ACTION_CLIENT_TAKE_FAILED || ret == RCL_RET_ACTION_SERVER_TAKE_FAILED) { \
     return py::make_tuple(py::none(), py::none()); \
@@ -137,8 +143,12 @@ ActionServer::take_result_request(py::object pymsg_type)
 
 #define SEND_SERVICE_RESPONSE(Type) \
   auto ros_response = convert_from_py(pyresponse); \
-  rcl_ret_t ret = rcl_action_send_ ## Type ## _response( \
-    rcl_action_server_.get(), header, ros_response.get()); \
+  rcl_ret_t ret; \
+  { \
+    auto lock = lock_releasing_gil(*mutex_); \
+    ret = rcl_action_send_ ## Type ## _response( \
+      rcl_action_server_.get(), header, ros_response.get()); \
+  } \
   if (RCL_RET_OK != ret) { \
     throw rclpy::RCLError("Failed to send " #Type " response"); \
   }
@@ -174,7 +184,11 @@ void
 ActionServer::publish_feedback(py::object pymsg)
 {
   auto ros_message = convert_from_py(pymsg);
-  rcl_ret_t ret = rcl_action_publish_feedback(rcl_action_server_.get(), ros_message.get());
+  rcl_ret_t ret;
+  {
+    auto lock = lock_releasing_gil(*mutex_);
+    ret = rcl_action_publish_feedback(rcl_action_server_.get(), ros_message.get());
+  }
   if (RCL_RET_OK != ret) {
     throw rclpy::RCLError("Failed to publish feedback with an action server");
   }
@@ -183,6 +197,7 @@ ActionServer::publish_feedback(py::object pymsg)
 void
 ActionServer::publish_status()
 {
+  auto lock = lock_releasing_gil(*mutex_);
   rcl_action_goal_status_array_t status_message =
     rcl_action_get_zero_initialized_goal_status_array();
   rcl_ret_t ret = rcl_action_get_goal_status_array(rcl_action_server_.get(), &status_message);
@@ -213,6 +228,7 @@ ActionServer::publish_status()
 void
 ActionServer::notify_goal_done()
 {
+  auto lock = lock_releasing_gil(*mutex_);
   rcl_ret_t ret = rcl_action_notify_goal_done(rcl_action_server_.get());
   if (RCL_RET_OK != ret) {
     throw rclpy::RCLError("Failed to notfiy action server of goal done");
@@ -224,6 +240,7 @@ ActionServer::goal_exists(py::object pygoal_info)
 {
   auto goal_info = convert_from_py(pygoal_info);
   rcl_action_goal_info_t * goal_info_type = static_cast<rcl_action_goal_info_t *>(goal_info.get());
+  auto lock = lock_releasing_gil(*mutex_);
   return rcl_action_server_goal_exists(rcl_action_server_.get(), goal_info_type);
 }
 
@@ -264,13 +281,17 @@ ActionServer::is_ready(WaitSet & wait_set)
   bool is_cancel_request_ready = false;
   bool is_result_request_ready = false;
   bool is_goal_expired = false;
-  rcl_ret_t ret = rcl_action_server_wait_set_get_entities_ready(
-    wait_set.rcl_ptr(),
-    rcl_action_server_.get(),
-    &is_goal_request_ready,
-    &is_cancel_request_ready,
-    &is_result_request_ready,
-    &is_goal_expired);
+  rcl_ret_t ret;
+  {
+    auto lock = lock_releasing_gil(*mutex_);
+    ret = rcl_action_server_wait_set_get_entities_ready(
+      wait_set.rcl_ptr(),
+      rcl_action_server_.get(),
+      &is_goal_request_ready,
+      &is_cancel_request_ready,
+      &is_result_request_ready,
+      &is_goal_expired);
+  }
 
   if (RCL_RET_OK != ret) {
     throw rclpy::RCLError("Failed to get number of ready entities for action server");
@@ -287,6 +308,7 @@ ActionServer::is_ready(WaitSet & wait_set)
 void
 ActionServer::add_to_waitset(WaitSet & wait_set)
 {
+  auto lock = lock_releasing_gil(*mutex_);
   rcl_ret_t ret = rcl_action_wait_set_add_action_server(
     wait_set.rcl_ptr(), rcl_action_server_.get(), NULL);
   if (RCL_RET_OK != ret) {
@@ -303,8 +325,12 @@ ActionServer::process_cancel_request(
     cancel_request.get());
 
   rcl_action_cancel_response_t cancel_response = rcl_action_get_zero_initialized_cancel_response();
-  rcl_ret_t ret = rcl_action_process_cancel_request(
-    rcl_action_server_.get(), cancel_request_tmp, &cancel_response);
+  rcl_ret_t ret;
+  {
+    auto lock = lock_releasing_gil(*mutex_);
+    ret = rcl_action_process_cancel_request(
+      rcl_action_server_.get(), cancel_request_tmp, &cancel_response);
+  }
 
   if (RCL_RET_OK != ret) {
     std::string error_text = append_rcl_error("Failed to process cancel request");
@@ -337,8 +363,12 @@ ActionServer::expire_goals(int64_t max_num_goals)
   auto expired_goals =
     std::unique_ptr<rcl_action_goal_info_t[]>(new rcl_action_goal_info_t[max_num_goals]);
   size_t num_expired;
-  rcl_ret_t ret = rcl_action_expire_goals(
-    rcl_action_server_.get(), expired_goals.get(), max_num_goals, &num_expired);
+  rcl_ret_t ret;
+  {
+    auto lock = lock_releasing_gil(*mutex_);
+    ret = rcl_action_expire_goals(
+      rcl_action_server_.get(), expired_goals.get(), max_num_goals, &num_expired);
+  }
   if (RCL_RET_OK != ret) {
     throw rclpy::RCLError("Failed to expire goals");
   }
@@ -21,6 +21,7 @@
 #include <rmw/types.h>
 
 #include <memory>
+#include <mutex>
 
 #include "clock.hpp"
 #include "destroyable.hpp"
@@ -248,6 +249,19 @@ public:
     return rcl_action_server_.get();
   }
 
+  /// Get the mutex serializing the use of the rcl action server and of its goal handles
+  /**
+   * The goals of the rcl action server are accepted, expired and read by several of its
+   * functions, and their state is updated through the goal handles, none of which is thread
+   * safe.
+   * Copies of the action server share the mutex.
+   */
+  std::mutex &
+  mutex() const
+  {
+    return *mutex_;
+  }
+
   /// Force an early destruction of this object
   void
   destroy() override;
@@ -255,6 +269,7 @@ public:
 private:
   Node node_;
   std::shared_ptr<rcl_action_server_t> rcl_action_server_;
+  std::shared_ptr<std::mutex> mutex_ = std::make_shared<std::mutex>();
 };
 /// Define a pybind11 wrapper for an rcl_time_point_t
 /**
@@ -0,0 +1,94 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <pybind11/pybind11.h>
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+#include "callback_group.hpp"
+
+namespace rclpy
+{
+CallbackGroupState::CallbackGroupState(bool exclusive)
+: exclusive_(exclusive)
+{
+}
+
+bool
+CallbackGroupState::can_execute() const
+{
+  return !exclusive_ || 0u == active_.load(std::memory_order_acquire);
+}
+
+bool
+CallbackGroupState::beginning_execution(uintptr_t token)
+{
+  if (0u == token) {
+    throw py::value_error("token must not be zero");
+  }
+  if (!exclusive_) {
+    return true;
+  }
+  uintptr_t expected = 0u;
+  return active_.compare_exchange_strong(
+    expected, token, std::memory_order_acquire, std::memory_order_relaxed);
+}
+
+void
+CallbackGroupState::ending_execution(uintptr_t token)
+{
+  if (!exclusive_) {
+    return;
+  }
+  uintptr_t expected = token;
+  if (!active_.compare_exchange_strong(
+      expected, 0u, std::memory_order_release, std::memory_order_relaxed))
+  {
+    throw std::runtime_error("entity ending execution is not the one executing in the group");
+  }
+}
+
+/// The token of a Python entity, the same as its id()
+static uintptr_t
+_get_token(py::handle entity)
+{
+  return reinterpret_cast<uintptr_t>(entity.ptr());
+}
+
+void
+define_callback_group_state(py::object module)
+{
+  py::class_<CallbackGroupState, std::shared_ptr<CallbackGroupState>>(
+    module, "CallbackGroupState")
+  .def(py::init<bool>(), py::arg("exclusive"))
+  .def_property_readonly(
+    "exclusive", &CallbackGroupState::exclusive,
+    "Whether at most one entity of the group executes at a time")
+  .def(
+    "can_execute", &CallbackGroupState::can_execute,
+    "Whether an entity of the group could begin executing right now")
+  .def(
+    "beginning_execution", [](CallbackGroupState & state, py::handle entity) {
+      return state.beginning_execution(_get_token(entity));
+    },
+    "Claim the group to begin executing an entity", py::arg("entity"))
+  .def(
+    "ending_execution", [](CallbackGroupState & state, py::handle entity) {
+      state.ending_execution(_get_token(entity));
+    },
+    "Release the group once an entity ended executing", py::arg("entity"));
+}
+}  // namespace rclpy
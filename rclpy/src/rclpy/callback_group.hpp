@@ -0,0 +1,91 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLPY__CALLBACK_GROUP_HPP_
+#define RCLPY__CALLBACK_GROUP_HPP_
+
+#include <pybind11/pybind11.h>
+
+#include <atomic>
+#include <cstdint>
+
+namespace py = pybind11;
+
+namespace rclpy
+{
+/// Execution state of a callback group, shared by the Python group and the executor cores
+/**
+ * An execution is claimed with a non-zero token identifying the executing entity, the
+ * Python callback groups use the address of the entity object.
+ * The token of the entity executing in a mutually exclusive group is kept in a single atomic
+ * word, so claiming the group is one compare-and-swap and neither needs a lock nor the GIL.
+ * Groups that are not exclusive never refuse an execution.
+ */
+class CallbackGroupState
+{
+public:
+  /// Create the state of a callback group
+  /**
+   * \param[in] exclusive If True at most one entity of the group executes at a time
+   */
+  explicit CallbackGroupState(bool exclusive);
+
+  /// Whether at most one entity of the group executes at a time
+  bool
+  exclusive() const
+  {
+    return exclusive_;
+  }
+
+  /// Whether an entity of the group could begin executing right now
+  bool
+  can_execute() const;
+
+  /// Claim the group to begin executing an entity
+  /**
+   * If this returns true then ending_execution() must be called with the same token once the
+   * execution ended.
+   *
+   * Raises ValueError if the token is zero
+   *
+   * \param[in] token Non-zero identifier of the entity
+   * \return true if the entity may execute, false if another entity of the group is executing
+   */
+  bool
+  beginning_execution(uintptr_t token);
+
+  /// Release the group once an entity ended executing
+  /**
+   * Raises RuntimeError if the group is exclusive and the entity wasn't the one executing
+   *
+   * \param[in] token The identifier the execution began with
+   */
+  void
+  ending_execution(uintptr_t token);
+
+private:
+  const bool exclusive_;
+  /// Token of the entity executing in an exclusive group, zero while none is
+  std::atomic<uintptr_t> active_{0u};
+};
+
+/// Define a pybind11 wrapper for an rclpy::CallbackGroupState
+/**
+ * \param[in] module a pybind11 module to add the definition to
+ */
+void
+define_callback_group_state(py::object module);
+}  // namespace rclpy
+
+#endif  // RCLPY__CALLBACK_GROUP_HPP_
@@ -22,6 +22,7 @@
 #include <rmw/types.h>
 
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include "client.hpp"
@@ -29,6 +30,7 @@
 #include "exceptions.hpp"
 #include "node.hpp"
 #include "python_allocator.hpp"
+#include "type_support.hpp"
 #include "utils.hpp"
 
 namespace rclpy
@@ -43,7 +45,9 @@ Client::destroy()
 
 Client::Client(
   Node & node, py::object pysrv_type, const std::string & service_name, py::object pyqos_profile)
-: node_(node)
+: node_(node),
+  request_type_support_(pysrv_type.attr("Request")),
+  response_type_support_(pysrv_type.attr("Response"))
 {
   srv_type_ = static_cast<rosidl_service_type_support_t *>(common_get_type_support(pysrv_type));
   if (nullptr == srv_type_) {
@@ -94,12 +98,10 @@ Client::Client(
 int64_t
 Client::send_request(py::object pyrequest)
 {
-  auto raw_ros_request = convert_from_py(pyrequest);
-  if (!raw_ros_request) {
-    throw py::error_already_set();
-  }
+  auto raw_ros_request = request_type_support_.convert_from_py(pyrequest);
 
   int64_t sequence_number;
+  auto lock = lock_releasing_gil(mutex_);
   rcl_ret_t ret = rcl_send_request(rcl_client_.get(), raw_ros_request.get(), &sequence_number);
   if (RCL_RET_OK != ret) {
     throw RCLError("failed to send request");
@@ -123,13 +125,18 @@ Client::service_server_is_available()
 py::tuple
 Client::take_response(py::object pyresponse_type)
 {
-  auto taken_response = create_from_py(pyresponse_type);
+  response_type_support_.check_type(pyresponse_type);
+  auto taken_response = response_type_support_.create();
 
   rmw_service_info_t header;
 
   py::tuple result_tuple(2);
-  rcl_ret_t ret = rcl_take_response_with_info(
-    rcl_client_.get(), &header, taken_response.get());
+  rcl_ret_t ret;
+  {
+    auto lock = lock_releasing_gil(mutex_);
+    py::gil_scoped_release gil_release;
+    ret = rcl_take_response_with_info(rcl_client_.get(), &header, taken_response.get());
+  }
   if (ret == RCL_RET_CLIENT_TAKE_FAILED) {
     result_tuple[0] = py::none();
     result_tuple[1] = py::none();
@@ -141,7 +148,7 @@ Client::take_response(py::object pyresponse_type)
 
   result_tuple[0] = header;
 
-  result_tuple[1] = convert_to_py(taken_response.get(), pyresponse_type);
+  result_tuple[1] = response_type_support_.convert_to_py(taken_response.get());
 
   return result_tuple;
 }
@@ -156,6 +163,7 @@ Client::configure_introspection(
     pyqos_service_event_pub.is_none() ? rcl_publisher_get_default_options().qos :
     pyqos_service_event_pub.cast<rmw_qos_profile_t>();
 
+  auto lock = lock_releasing_gil(mutex_);
   rcl_ret_t ret = rcl_client_configure_service_introspection(
     rcl_client_.get(), node_.rcl_ptr(), clock.rcl_ptr(), srv_type_, pub_opts, introspection_state);
 
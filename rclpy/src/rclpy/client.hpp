@@ -22,11 +22,13 @@
 #include <rmw/types.h>
 
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include "clock.hpp"
 #include "destroyable.hpp"
 #include "node.hpp"
+#include "type_support.hpp"
 
 namespace py = pybind11;
 
@@ -76,6 +78,7 @@ public:
   /// Take a response from a given client
   /**
    * Raises ValueError if pyclient is not a client capsule
+   * Raises TypeError if \p pyresponse_type is not the response type of the client
    *
    * \param[in] pyresponse_type Instance of the message type to take
    * \return 2-tuple sequence number and received response, or None if there is no response
@@ -113,6 +116,14 @@ private:
   Node node_;
   std::shared_ptr<rcl_client_t> rcl_client_;
   rosidl_service_type_support_t * srv_type_;
+  TypeSupportHandle request_type_support_;
+  TypeSupportHandle response_type_support_;
+  /// Serializes sending requests, taking responses and configuring introspection
+  /**
+   * The rcl client functions are not thread safe, and introspection configures the
+   * publisher that sending and taking use.
+   */
+  std::mutex mutex_;
 };
 
 /// Define a pybind11 wrapper for an rclpy::Client
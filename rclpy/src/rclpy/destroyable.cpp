@@ -14,6 +14,8 @@
 
 #include <pybind11/pybind11.h>
 
+#include <atomic>
+#include <cstddef>
 #include <memory>
 #include <stdexcept>
 
@@ -26,28 +28,38 @@ Destroyable::Destroyable(const Destroyable &)
 {
   // When a destroyable is copied, it does not matter if someone asked
   // to destroy the original. The copy has its own lifetime.
-  use_count = 0;
-  please_destroy_ = false;
+  state_ = 0u;
+}
+
+Destroyable &
+Destroyable::operator=(const Destroyable &)
+{
+  return *this;
 }
 
 void
 Destroyable::enter()
 {
-  if (please_destroy_) {
-    throw InvalidHandle("cannot use Destroyable because destruction was requested");
-  }
-  ++use_count;
+  size_t state = state_.load();
+  do {
+    if (state & kDestroyRequested) {
+      throw InvalidHandle("cannot use Destroyable because destruction was requested");
+    }
+  } while (!state_.compare_exchange_weak(state, state + 1u));
 }
 
 void
 Destroyable::exit(py::object, py::object, py::object)
 {
-  if (0u == use_count) {
-    throw std::runtime_error("Internal error: Destroyable use_count would be negative");
-  }
+  size_t state = state_.load();
+  do {
+    if (0u == (state & ~kDestroyRequested)) {
+      throw std::runtime_error("Internal error: Destroyable use_count would be negative");
+    }
+  } while (!state_.compare_exchange_weak(state, state - 1u));
 
-  --use_count;
-  if (please_destroy_ && 0u == use_count) {
+  if (kDestroyRequested == state - 1u) {
+    // Last use ended after destruction was requested
     destroy();
   }
 }
@@ -62,12 +74,12 @@ Destroyable::destroy()
 void
 Destroyable::destroy_when_not_in_use()
 {
-  if (please_destroy_) {
+  const size_t state = state_.fetch_or(kDestroyRequested);
+  if (state & kDestroyRequested) {
     // already asked to destroy
     return;
   }
-  please_destroy_ = true;
-  if (0u == use_count) {
+  if (0u == state) {
     destroy();
   }
 }
@@ -17,11 +17,19 @@
 
 #include <pybind11/pybind11.h>
 
+#include <atomic>
+#include <cstddef>
+
 namespace py = pybind11;
 
 namespace rclpy
 {
 /// This class blocks destruction when in use
+/**
+ * The use count and the destruction request are a single atomic word, so entering, exiting and
+ * requesting destruction from several threads at once destroys the object exactly once, when
+ * it is no longer in use, without relying on the GIL.
+ */
 class Destroyable
 {
 public:
@@ -31,6 +39,10 @@ public:
   /// Copy constructor
   Destroyable(const Destroyable & other);
 
+  /// Copy assignment, the object keeps its own lifetime
+  Destroyable &
+  operator=(const Destroyable & other);
+
   /// Context manager __enter__ - block destruction
   void
   enter();
@@ -52,8 +64,11 @@ public:
   ~Destroyable() = default;
 
 private:
-  size_t use_count = 0u;
-  bool please_destroy_ = false;
+  /// Set in state_ once destruction was requested
+  static constexpr size_t kDestroyRequested = ~(~static_cast<size_t>(0u) >> 1u);
+
+  /// Number of uses, plus kDestroyRequested once destruction was requested
+  std::atomic<size_t> state_{0u};
 };
 
 /// Define a pybind11 wrapper for an rclpy::Destroyable
@@ -51,23 +51,43 @@ create_zero_initialized_event()
   return event;
 }
 
+EventHandle::~EventHandle()
+{
+  // Let the parent be destroyed if the handle is dropped without being destroyed
+  destroy();
+}
+
 void
 EventHandle::destroy()
 {
   rcl_event_.reset();
-  std::visit([](auto & t) {t.destroy();}, grandparent_);
+  std::visit(
+    [](auto & grandparent) {
+      if (grandparent) {
+        grandparent->exit(py::none(), py::none(), py::none());
+        grandparent.reset();
+      }
+    }, grandparent_);
 }
 
 EventHandle::EventHandle(
   rclpy::Subscription & subscription, rcl_subscription_event_type_t event_type)
-: event_type_(event_type), grandparent_(subscription)
+: event_type_(event_type)
 {
   // Create a subscription event
   rcl_event_ = create_zero_initialized_event();
 
+  // Block destruction of the subscription for as long as the event uses it
+  subscription.enter();
+  grandparent_ = subscription.shared_from_this();
+
   rcl_ret_t ret = rcl_subscription_event_init(
-    rcl_event_.get(),
-    std::get<Subscription>(grandparent_).rcl_ptr(), event_type);
+    rcl_event_.get(), subscription.rcl_ptr(), event_type);
+  if (RCL_RET_OK != ret) {
+    // Not through destroy(), finalizing the event would reset the error
+    subscription.exit(py::none(), py::none(), py::none());
+    grandparent_ = std::shared_ptr<Subscription>();
+  }
   if (RCL_RET_BAD_ALLOC == ret) {
     rcl_reset_error();
     throw std::bad_alloc();
@@ -82,14 +102,22 @@ EventHandle::EventHandle(
 
 EventHandle::EventHandle(
   rclpy::Publisher & publisher, rcl_publisher_event_type_t event_type)
-: event_type_(event_type), grandparent_(publisher)
+: event_type_(event_type)
 {
   // Create a publisher event
   rcl_event_ = create_zero_initialized_event();
 
+  // Block destruction of the publisher for as long as the event uses it
+  publisher.enter();
+  grandparent_ = publisher.shared_from_this();
+
   rcl_ret_t ret = rcl_publisher_event_init(
-    rcl_event_.get(),
-    std::get<Publisher>(grandparent_).rcl_ptr(), event_type);
+    rcl_event_.get(), publisher.rcl_ptr(), event_type);
+  if (RCL_RET_OK != ret) {
+    // Not through destroy(), finalizing the event would reset the error
+    publisher.exit(py::none(), py::none(), py::none());
+    grandparent_ = std::shared_ptr<Publisher>();
+  }
   if (RCL_RET_BAD_ALLOC == ret) {
     rcl_reset_error();
     throw std::bad_alloc();
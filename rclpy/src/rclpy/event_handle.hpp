@@ -62,7 +62,7 @@ public:
    */
   EventHandle(rclpy::Publisher & publisher, rcl_publisher_event_type_t event_type);
 
-  ~EventHandle() = default;
+  ~EventHandle();
 
   /// Get pending data from a ready QoS event.
   /**
@@ -91,7 +91,8 @@ public:
 
 private:
   std::variant<rcl_subscription_event_type_t, rcl_publisher_event_type_t> event_type_;
-  std::variant<Publisher, Subscription> grandparent_;
+  /// The publisher or subscription of the event, kept in use until the event is destroyed
+  std::variant<std::shared_ptr<Publisher>, std::shared_ptr<Subscription>> grandparent_;
   std::shared_ptr<rcl_event_t> rcl_event_;
 };
 
@@ -0,0 +1,286 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <pybind11/pybind11.h>
+
+#include <rcl/client.h>
+#include <rcl/error_handling.h>
+#include <rcl/event.h>
+#include <rcl/service.h>
+#include <rcl/subscription.h>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "events_queue.hpp"
+#include "exceptions.hpp"
+
+namespace rclpy
+{
+EventsQueue::~EventsQueue()
+{
+  destroy();
+}
+
+void
+EventsQueue::on_event(const void * user_data, size_t number_of_events)
+{
+  const auto * listener = static_cast<const Listener *>(user_data);
+  listener->queue->push(listener->id, number_of_events);
+}
+
+template<typename SetCallback>
+void
+EventsQueue::add_listener(
+  uint64_t id, SetCallback && set_callback, std::function<void()> unset)
+{
+  auto listener = std::make_unique<Listener>(Listener{this, id, std::move(unset)});
+  Listener * raw_listener = listener.get();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!listeners_.emplace(id, std::move(listener)).second) {
+      throw py::value_error("identifier " + std::to_string(id) + " is already used");
+    }
+  }
+  try {
+    // The middleware may call the callback right away for data received before, don't hold
+    // the lock the callback needs
+    set_callback(raw_listener);
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    listeners_.erase(id);
+    throw;
+  }
+}
+
+void
+EventsQueue::add_subscription(std::shared_ptr<Subscription> subscription, uint64_t id)
+{
+  // Block destruction of the subscription for as long as it pushes to the queue
+  subscription->enter();
+  auto unset = [subscription]() {
+      rcl_subscription_set_on_new_message_callback(subscription->rcl_ptr(), nullptr, nullptr);
+      rcl_reset_error();
+      subscription->exit(py::none(), py::none(), py::none());
+    };
+  try {
+    add_listener(
+      id, [&subscription](Listener * listener) {
+        rcl_ret_t ret = rcl_subscription_set_on_new_message_callback(
+          subscription->rcl_ptr(), &EventsQueue::on_event, listener);
+        if (RCL_RET_OK != ret) {
+          throw RCLError("failed to set the new message callback of the subscription");
+        }
+      }, unset);
+  } catch (...) {
+    subscription->exit(py::none(), py::none(), py::none());
+    throw;
+  }
+}
+
+void
+EventsQueue::add_service(std::shared_ptr<Service> service, uint64_t id)
+{
+  service->enter();
+  auto unset = [service]() {
+      rcl_service_set_on_new_request_callback(service->rcl_ptr(), nullptr, nullptr);
+      rcl_reset_error();
+      service->exit(py::none(), py::none(), py::none());
+    };
+  try {
+    add_listener(
+      id, [&service](Listener * listener) {
+        rcl_ret_t ret = rcl_service_set_on_new_request_callback(
+          service->rcl_ptr(), &EventsQueue::on_event, listener);
+        if (RCL_RET_OK != ret) {
+          throw RCLError("failed to set the new request callback of the service");
+        }
+      }, unset);
+  } catch (...) {
+    service->exit(py::none(), py::none(), py::none());
+    throw;
+  }
+}
+
+void
+EventsQueue::add_client(std::shared_ptr<Client> client, uint64_t id)
+{
+  client->enter();
+  auto unset = [client]() {
+      rcl_client_set_on_new_response_callback(client->rcl_ptr(), nullptr, nullptr);
+      rcl_reset_error();
+      client->exit(py::none(), py::none(), py::none());
+    };
+  try {
+    add_listener(
+      id, [&client](Listener * listener) {
+        rcl_ret_t ret = rcl_client_set_on_new_response_callback(
+          client->rcl_ptr(), &EventsQueue::on_event, listener);
+        if (RCL_RET_OK != ret) {
+          throw RCLError("failed to set the new response callback of the client");
+        }
+      }, unset);
+  } catch (...) {
+    client->exit(py::none(), py::none(), py::none());
+    throw;
+  }
+}
+
+void
+EventsQueue::add_event(std::shared_ptr<EventHandle> event, uint64_t id)
+{
+  event->enter();
+  auto unset = [event]() {
+      rcl_event_set_callback(event->rcl_ptr(), nullptr, nullptr);
+      rcl_reset_error();
+      event->exit(py::none(), py::none(), py::none());
+    };
+  try {
+    add_listener(
+      id, [&event](Listener * listener) {
+        rcl_ret_t ret = rcl_event_set_callback(
+          event->rcl_ptr(), &EventsQueue::on_event, listener);
+        if (RCL_RET_OK != ret) {
+          throw RCLError("failed to set the callback of the event");
+        }
+      }, unset);
+  } catch (...) {
+    event->exit(py::none(), py::none(), py::none());
+    throw;
+  }
+}
+
+void
+EventsQueue::add_guard_condition(std::shared_ptr<GuardCondition> gc, uint64_t id)
+{
+  gc->enter();
+  auto unset = [gc]() {
+      gc->set_on_trigger_callback(nullptr);
+      gc->exit(py::none(), py::none(), py::none());
+    };
+  try {
+    add_listener(
+      id, [&gc](Listener * listener) {
+        gc->set_on_trigger_callback(
+          [listener](size_t number_of_triggers) {
+            EventsQueue::on_event(listener, number_of_triggers);
+          });
+      }, unset);
+  } catch (...) {
+    gc->exit(py::none(), py::none(), py::none());
+    throw;
+  }
+}
+
+void
+EventsQueue::remove(uint64_t id)
+{
+  std::unique_ptr<Listener> listener;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = listeners_.find(id);
+    if (listeners_.end() == it) {
+      return;
+    }
+    listener = std::move(it->second);
+    listeners_.erase(it);
+  }
+  // Unsetting waits for a callback in progress, which needs the lock
+  listener->unset();
+}
+
+void
+EventsQueue::push(uint64_t id, size_t count)
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    events_.emplace_back(id, count);
+  }
+  condition_.notify_one();
+}
+
+py::list
+EventsQueue::wait(int64_t timeout_ns)
+{
+  std::vector<std::pair<uint64_t, size_t>> events;
+  {
+    py::gil_scoped_release gil_release;
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto has_events = [this]() {return !events_.empty();};
+    if (timeout_ns < 0) {
+      condition_.wait(lock, has_events);
+    } else if (timeout_ns > 0) {
+      condition_.wait_for(lock, std::chrono::nanoseconds(timeout_ns), has_events);
+    }
+    events.swap(events_);
+  }
+
+  py::list pyevents;
+  for (const auto & event : events) {
+    pyevents.append(py::make_tuple(event.first, event.second));
+  }
+  return pyevents;
+}
+
+void
+EventsQueue::destroy()
+{
+  std::unordered_map<uint64_t, std::unique_ptr<Listener>> listeners;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    listeners.swap(listeners_);
+    events_.clear();
+  }
+  for (auto & id_and_listener : listeners) {
+    id_and_listener.second->unset();
+  }
+}
+
+void
+define_events_queue(py::object module)
+{
+  py::class_<EventsQueue, Destroyable, std::shared_ptr<EventsQueue>>(module, "EventsQueue")
+  .def(py::init<>())
+  .def(
+    "add_subscription", &EventsQueue::add_subscription,
+    "Push the identifier of a subscription whenever it receives messages")
+  .def(
+    "add_service", &EventsQueue::add_service,
+    "Push the identifier of a service whenever it receives requests")
+  .def(
+    "add_client", &EventsQueue::add_client,
+    "Push the identifier of a client whenever it receives responses")
+  .def(
+    "add_event", &EventsQueue::add_event,
+    "Push the identifier of an event handle whenever its event occurs")
+  .def(
+    "add_guard_condition", &EventsQueue::add_guard_condition,
+    "Push the identifier of a guard condition whenever it is triggered")
+  .def(
+    "remove", &EventsQueue::remove,
+    "Stop pushing the identifier of an entity")
+  .def(
+    "push", &EventsQueue::push,
+    "Push an identifier, e.g. to wake up a wait")
+  .def(
+    "wait", &EventsQueue::wait,
+    "Wait for events and take all of them");
+}
+}  // namespace rclpy
@@ -0,0 +1,166 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLPY__EVENTS_QUEUE_HPP_
+#define RCLPY__EVENTS_QUEUE_HPP_
+
+#include <pybind11/pybind11.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "client.hpp"
+#include "destroyable.hpp"
+#include "event_handle.hpp"
+#include "guard_condition.hpp"
+#include "service.hpp"
+#include "subscription.hpp"
+
+namespace py = pybind11;
+
+namespace rclpy
+{
+/// A queue the entities push their identifier to when they get new data
+/**
+ * Entities are added with an identifier chosen by the caller, and a listener callback is set
+ * on them, which the middleware calls from its own threads with the number of new messages,
+ * requests, responses or events.
+ * The callback pushes the identifier and that number to the queue without needing the GIL,
+ * and wait() hands the pushed events over to the thread executing the callbacks.
+ *
+ * The cost of waiting thus depends on the number of events, not on the number of entities.
+ */
+class EventsQueue : public Destroyable, public std::enable_shared_from_this<EventsQueue>
+{
+public:
+  EventsQueue() = default;
+
+  ~EventsQueue();
+
+  /// Push the identifier of a subscription whenever it receives messages
+  /**
+   * Raises InvalidHandle if the subscription is being destroyed
+   * Raises RCLError if the listener callback could not be set
+   * Raises ValueError if the identifier is already used
+   *
+   * \param[in] subscription The subscription
+   * \param[in] id The identifier to push
+   */
+  void
+  add_subscription(std::shared_ptr<Subscription> subscription, uint64_t id);
+
+  /// Push the identifier of a service whenever it receives requests
+  /**
+   * \sa add_subscription()
+   */
+  void
+  add_service(std::shared_ptr<Service> service, uint64_t id);
+
+  /// Push the identifier of a client whenever it receives responses
+  /**
+   * \sa add_subscription()
+   */
+  void
+  add_client(std::shared_ptr<Client> client, uint64_t id);
+
+  /// Push the identifier of an event handle whenever its event occurs
+  /**
+   * \sa add_subscription()
+   */
+  void
+  add_event(std::shared_ptr<EventHandle> event, uint64_t id);
+
+  /// Push the identifier of a guard condition whenever it is triggered
+  /**
+   * Only triggers going through GuardCondition::trigger_guard_condition() are pushed.
+   *
+   * \sa add_subscription()
+   */
+  void
+  add_guard_condition(std::shared_ptr<GuardCondition> gc, uint64_t id);
+
+  /// Stop pushing the identifier of an entity
+  /**
+   * Once this returns the identifier is no longer pushed, but it may still be in the queue.
+   * Unknown identifiers are ignored.
+   *
+   * \param[in] id The identifier the entity was added with
+   */
+  void
+  remove(uint64_t id);
+
+  /// Push an identifier, e.g. to wake up a wait
+  /**
+   * \param[in] id The identifier to push
+   * \param[in] count The number of events to push the identifier with
+   */
+  void
+  push(uint64_t id, size_t count);
+
+  /// Wait for events and take all of them
+  /**
+   * The GIL is released while waiting.
+   *
+   * \param[in] timeout_ns Maximum time to wait in nanoseconds, if negative wait forever,
+   *   if zero don't wait
+   * \return List of the pushed (identifier, count) tuples in the order they were pushed,
+   *   empty if the timeout was reached
+   */
+  py::list
+  wait(int64_t timeout_ns);
+
+  /// Stop pushing the identifiers of all entities
+  void
+  destroy() override;
+
+private:
+  struct Listener
+  {
+    EventsQueue * queue;
+    uint64_t id;
+    /// Unsets the listener callback of the entity
+    std::function<void()> unset;
+  };
+
+  /// Listener callback set on the entities, called by the middleware
+  static void
+  on_event(const void * user_data, size_t number_of_events);
+
+  /// Register a listener and set it on its entity
+  template<typename SetCallback>
+  void
+  add_listener(uint64_t id, SetCallback && set_callback, std::function<void()> unset);
+
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::vector<std::pair<uint64_t, size_t>> events_;
+  /// Listeners by identifier, their address is passed to the middleware
+  std::unordered_map<uint64_t, std::unique_ptr<Listener>> listeners_;
+};
+
+/// Define a pybind11 wrapper for an rclpy::EventsQueue
+/**
+ * \param[in] module a pybind11 module to add the definition to
+ */
+void
+define_events_queue(py::object module);
+}  // namespace rclpy
+
+#endif  // RCLPY__EVENTS_QUEUE_HPP_
@@ -0,0 +1,572 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <pybind11/pybind11.h>
+
+#include <rcl/wait.h>
+#include <rcutils/logging_macros.h>
+#include <rmw/types.h>
+
+#include <rcpputils/scope_exit.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "exceptions.hpp"
+#include "executor_core.hpp"
+#include "lazy_message.hpp"
+#include "loaned_message.hpp"
+#include "utils.hpp"
+
+namespace rclpy
+{
+ExecutorCore::ExecutorCore(std::shared_ptr<WaitSet> wait_set)
+: wait_set_(wait_set)
+{
+}
+
+std::shared_ptr<WaitSet>
+ExecutorCore::get_wait_set()
+{
+  auto lock = lock_releasing_gil(mutex_);
+  if (!wait_set_) {
+    throw InvalidHandle("executor core was destroyed");
+  }
+  return wait_set_;
+}
+
+/// The token claiming a callback group state for a Python entity, the same as its id()
+static uintptr_t
+_get_token(py::handle entity)
+{
+  return reinterpret_cast<uintptr_t>(entity.ptr());
+}
+
+template<typename EntryArray, typename Entity, typename Entry>
+void
+_add_entry(
+  const std::shared_ptr<WaitSet> & wait_set, EntryArray & entries,
+  std::shared_ptr<Entity> entity, Entry && entry)
+{
+  if (!wait_set) {
+    throw InvalidHandle("executor core was destroyed");
+  }
+  const size_t index = wait_set->attach(entity);
+  if (index != entries.size()) {
+    wait_set->detach(entity);
+    throw py::value_error("wait set has entities attached outside of the executor core");
+  }
+  entries.push_back(std::forward<Entry>(entry));
+}
+
+template<typename EntryArray, typename Entity, typename GetEntity>
+void
+_remove_entry(
+  const std::shared_ptr<WaitSet> & wait_set, EntryArray & entries,
+  std::shared_ptr<Entity> entity, GetEntity && get_entity)
+{
+  if (!wait_set) {
+    throw InvalidHandle("executor core was destroyed");
+  }
+  auto it = std::find_if(
+    entries.begin(), entries.end(),
+    [&entity, &get_entity](const auto & entry) {return get_entity(entry) == entity;});
+  if (it == entries.end()) {
+    throw py::value_error("entity was not added to the executor core");
+  }
+  wait_set->detach(entity);
+  entries.erase(it);
+}
+
+void
+ExecutorCore::add_subscription(
+  std::shared_ptr<Subscription> subscription, py::object pymsg_type, bool raw, bool with_info,
+  py::object callback, py::object begin, py::object end, bool callback_ends_execution,
+  size_t max_batch_size, bool loaned_messages, py::object reused_message, bool lazy,
+  py::object columns, bool array_views, std::shared_ptr<CallbackGroupState> group,
+  py::handle entity)
+{
+  Callbacks callbacks{callback, begin, end, callback_ends_execution, group, _get_token(entity)};
+  auto lock = lock_releasing_gil(mutex_);
+  _add_entry(
+    wait_set_, subscriptions_, subscription,
+    SubscriptionEntry{subscription, pymsg_type, raw, with_info, max_batch_size, loaned_messages,
+      reused_message, lazy, columns, array_views, std::move(callbacks)});
+  ++generation_;
+}
+
+void
+ExecutorCore::add_timer(
+  std::shared_ptr<Timer> timer,
+  py::object callback, py::object begin, py::object end, bool callback_ends_execution,
+  std::shared_ptr<CallbackGroupState> group, py::handle entity)
+{
+  Callbacks callbacks{callback, begin, end, callback_ends_execution, group, _get_token(entity)};
+  auto lock = lock_releasing_gil(mutex_);
+  _add_entry(wait_set_, timers_, timer, TimerEntry{timer, std::move(callbacks)});
+  ++generation_;
+}
+
+void
+ExecutorCore::add_guard_condition(
+  std::shared_ptr<GuardCondition> gc,
+  py::object callback, py::object begin, py::object end, bool callback_ends_execution,
+  std::shared_ptr<CallbackGroupState> group, py::handle entity)
+{
+  Callbacks callbacks{callback, begin, end, callback_ends_execution, group, _get_token(entity)};
+  auto lock = lock_releasing_gil(mutex_);
+  _add_entry(wait_set_, guard_conditions_, gc, GuardConditionEntry{gc, std::move(callbacks)});
+  ++generation_;
+}
+
+void
+ExecutorCore::add_service(
+  std::shared_ptr<Service> service, py::object pyrequest_type, py::object pyresponse_type,
+  py::object callback, py::object begin, py::object end, bool callback_ends_execution,
+  std::shared_ptr<CallbackGroupState> group, py::handle entity)
+{
+  Callbacks callbacks{callback, begin, end, callback_ends_execution, group, _get_token(entity)};
+  auto lock = lock_releasing_gil(mutex_);
+  _add_entry(
+    wait_set_, services_, service,
+    ServiceEntry{service, pyrequest_type, pyresponse_type, std::move(callbacks)});
+  ++generation_;
+}
+
+void
+ExecutorCore::add_client(
+  std::shared_ptr<Client> client, py::object pyresponse_type,
+  py::object callback, py::object begin, py::object end, bool callback_ends_execution,
+  std::shared_ptr<CallbackGroupState> group, py::handle entity)
+{
+  Callbacks callbacks{callback, begin, end, callback_ends_execution, group, _get_token(entity)};
+  auto lock = lock_releasing_gil(mutex_);
+  _add_entry(
+    wait_set_, clients_, client, ClientEntry{client, pyresponse_type, std::move(callbacks)});
+  ++generation_;
+}
+
+void
+ExecutorCore::remove(std::shared_ptr<Subscription> subscription)
+{
+  auto lock = lock_releasing_gil(mutex_);
+  _remove_entry(
+    wait_set_, subscriptions_, subscription,
+    [](const SubscriptionEntry & entry) {return entry.subscription;});
+  ++generation_;
+}
+
+void
+ExecutorCore::remove(std::shared_ptr<Timer> timer)
+{
+  auto lock = lock_releasing_gil(mutex_);
+  _remove_entry(
+    wait_set_, timers_, timer,
+    [](const TimerEntry & entry) {return entry.timer;});
+  ++generation_;
+}
+
+void
+ExecutorCore::remove(std::shared_ptr<GuardCondition> gc)
+{
+  auto lock = lock_releasing_gil(mutex_);
+  _remove_entry(
+    wait_set_, guard_conditions_, gc,
+    [](const GuardConditionEntry & entry) {return entry.gc;});
+  ++generation_;
+}
+
+void
+ExecutorCore::remove(std::shared_ptr<Service> service)
+{
+  auto lock = lock_releasing_gil(mutex_);
+  _remove_entry(
+    wait_set_, services_, service,
+    [](const ServiceEntry & entry) {return entry.service;});
+  ++generation_;
+}
+
+void
+ExecutorCore::remove(std::shared_ptr<Client> client)
+{
+  auto lock = lock_releasing_gil(mutex_);
+  _remove_entry(
+    wait_set_, clients_, client,
+    [](const ClientEntry & entry) {return entry.client;});
+  ++generation_;
+}
+
+/// Take the data of an entity and call its callback between its begin and end callables
+/**
+ * \param[in] callbacks The callables registered for the entity
+ * \param[in] take_and_call Takes the data and calls the callback, it must set its argument to
+ *   true right before calling the callback
+ * \return true if the callback was called
+ */
+template<typename Callbacks, typename TakeAndCall>
+bool
+_execute(const Callbacks & callbacks, TakeAndCall && take_and_call)
+{
+  if (callbacks.group) {
+    if (!callbacks.group->beginning_execution(callbacks.token)) {
+      // The data stays in the queue until the entity may be executed
+      return false;
+    }
+  } else if (!callbacks.begin.is_none() && !callbacks.begin().template cast<bool>()) {
+    return false;
+  }
+
+  bool called = false;
+  auto end = [&callbacks, &called]() {
+      if (called && callbacks.callback_ends_execution) {
+        return;
+      }
+      if (callbacks.group) {
+        callbacks.group->ending_execution(callbacks.token);
+      } else if (!callbacks.end.is_none()) {
+        callbacks.end();
+      }
+    };
+  try {
+    take_and_call(called);
+  } catch (...) {
+    end();
+    throw;
+  }
+  end();
+  return called;
+}
+
+void
+ExecutorCore::prepare_wait()
+{
+  get_wait_set()->rebuild();
+}
+
+size_t
+ExecutorCore::wait_and_dispatch(int64_t timeout_ns)
+{
+  get_wait_set()->wait(timeout_ns);
+  return dispatch();
+}
+
+/// Append the indices of the ready entries
+/**
+ * An entry is only ready if the wait set holds its own entity at its index, since the
+ * following entries move down when an entity is removed during the wait.
+ */
+template<typename Entity, typename EntryArray, typename GetEntity>
+void
+_get_ready_indices(
+  Entity * const * entities, size_t size_of_entities, const EntryArray & entries,
+  GetEntity && get_entity, std::vector<size_t> & indices)
+{
+  const size_t n = std::min(size_of_entities, entries.size());
+  for (size_t i = 0u; i < n; ++i) {
+    if (entities[i] && entities[i] == get_entity(entries[i])->rcl_ptr()) {
+      indices.push_back(i);
+    }
+  }
+}
+
+/// Copy the entries of the given indices
+template<typename EntryArray>
+EntryArray
+_copy_entries(const EntryArray & entries, const std::vector<size_t> & indices)
+{
+  EntryArray copies;
+  copies.reserve(indices.size());
+  for (size_t i : indices) {
+    copies.push_back(entries[i]);
+  }
+  return copies;
+}
+
+size_t
+ExecutorCore::dispatch()
+{
+  uint64_t generation;
+  size_t num_called = 0u;
+
+  // Copies, a callback may change the registered entities
+  std::vector<TimerEntry> ready_timers;
+  std::vector<SubscriptionEntry> ready_subscriptions;
+  std::vector<GuardConditionEntry> ready_guard_conditions;
+  std::vector<ClientEntry> ready_clients;
+  std::vector<ServiceEntry> ready_services;
+  {
+    auto lock = lock_releasing_gil(mutex_);
+    if (!wait_set_) {
+      return 0u;
+    }
+    generation = generation_;
+    // Entities added after the attached ones, e.g. the ones of waitables, are left out
+    std::vector<size_t> timer_indices;
+    std::vector<size_t> subscription_indices;
+    std::vector<size_t> guard_condition_indices;
+    std::vector<size_t> client_indices;
+    std::vector<size_t> service_indices;
+    {
+      py::gil_scoped_release gil_release;
+      const rcl_wait_set_t * wait_set = wait_set_->rcl_ptr();
+      _get_ready_indices(
+        wait_set->timers, wait_set->size_of_timers, timers_,
+        [](const TimerEntry & entry) {return entry.timer;}, timer_indices);
+      _get_ready_indices(
+        wait_set->subscriptions, wait_set->size_of_subscriptions, subscriptions_,
+        [](const SubscriptionEntry & entry) {return entry.subscription;}, subscription_indices);
+      _get_ready_indices(
+        wait_set->guard_conditions, wait_set->size_of_guard_conditions, guard_conditions_,
+        [](const GuardConditionEntry & entry) {return entry.gc;}, guard_condition_indices);
+      _get_ready_indices(
+        wait_set->clients, wait_set->size_of_clients, clients_,
+        [](const ClientEntry & entry) {return entry.client;}, client_indices);
+      _get_ready_indices(
+        wait_set->services, wait_set->size_of_services, services_,
+        [](const ServiceEntry & entry) {return entry.service;}, service_indices);
+    }
+    ready_timers = _copy_entries(timers_, timer_indices);
+    ready_subscriptions = _copy_entries(subscriptions_, subscription_indices);
+    ready_guard_conditions = _copy_entries(guard_conditions_, guard_condition_indices);
+    ready_clients = _copy_entries(clients_, client_indices);
+    ready_services = _copy_entries(services_, service_indices);
+  }
+
+  for (const TimerEntry & entry : ready_timers) {
+    if (generation != generation_) {
+      return num_called;
+    }
+    // Check timer is ready to workaround rcl issue with cancelled timers
+    if (!entry.timer->is_timer_ready()) {
+      continue;
+    }
+    num_called += _execute(
+      entry.callbacks, [&entry](bool & called) {
+        entry.timer->call_timer();
+        called = true;
+        entry.callbacks.callback();
+      });
+  }
+
+  for (const SubscriptionEntry & entry : ready_subscriptions) {
+    if (generation != generation_) {
+      return num_called;
+    }
+    num_called += _execute(
+      entry.callbacks, [&entry](bool & called) {
+        py::object taken;
+        if (entry.loaned_messages) {
+          taken = entry.subscription->take_loaned_message(entry.msg_type);
+        } else if (!entry.reused_message.is_none()) {
+          py::object info = entry.subscription->take_message_into(entry.reused_message);
+          if (!info.is_none()) {
+            taken = py::make_tuple(entry.reused_message, info);
+          }
+        } else if (!entry.columns.is_none()) {
+          auto columns = entry.columns.cast<py::tuple>();
+          const size_t n = entry.subscription->take_messages_into_array(columns[0], columns[1]);
+          if (n) {
+            py::slice taken_rows(0, static_cast<py::ssize_t>(n), 1);
+            taken = py::make_tuple(columns[0][taken_rows], columns[1][taken_rows]);
+          }
+        } else if (entry.array_views) {
+          taken = entry.subscription->take_message_with_array_views(entry.msg_type);
+        } else if (entry.max_batch_size) {
+          taken = entry.subscription->take_messages(
+            entry.msg_type, entry.max_batch_size, entry.raw);
+        } else {
+          taken = entry.subscription->take_message(entry.msg_type, entry.raw || entry.lazy);
+        }
+        if (!taken || taken.is_none()) {
+          return;
+        }
+        auto msg_info = taken.cast<py::tuple>();
+        if (entry.lazy) {
+          msg_info = py::make_tuple(
+            std::make_shared<LazyMessage>(msg_info[0], entry.msg_type), msg_info[1]);
+        }
+        std::shared_ptr<LoanedMessage> loaned_message;
+        if (entry.loaned_messages && !entry.callbacks.callback_ends_execution) {
+          loaned_message = msg_info[0].cast<std::shared_ptr<LoanedMessage>>();
+        }
+        // The message is only valid during the callback
+        RCPPUTILS_SCOPE_EXIT(
+          {
+            if (loaned_message) {
+              loaned_message->release();
+            }
+          });
+        called = true;
+        if (entry.with_info) {
+          entry.callbacks.callback(msg_info[0], msg_info[1]);
+        } else {
+          entry.callbacks.callback(msg_info[0]);
+        }
+      });
+  }
+
+  for (const GuardConditionEntry & entry : ready_guard_conditions) {
+    if (generation != generation_) {
+      return num_called;
+    }
+    if (entry.callbacks.callback.is_none()) {
+      // Only there to wake up the wait
+      continue;
+    }
+    num_called += _execute(
+      entry.callbacks, [&entry](bool & called) {
+        called = true;
+        entry.callbacks.callback();
+      });
+  }
+
+  for (const ClientEntry & entry : ready_clients) {
+    if (generation != generation_) {
+      return num_called;
+    }
+    num_called += _execute(
+      entry.callbacks, [&entry](bool & called) {
+        py::tuple header_and_response = entry.client->take_response(entry.response_type);
+        if (header_and_response[0].is_none()) {
+          return;
+        }
+        called = true;
+        entry.callbacks.callback(header_and_response[0], header_and_response[1]);
+      });
+  }
+
+  for (const ServiceEntry & entry : ready_services) {
+    if (generation != generation_) {
+      return num_called;
+    }
+    num_called += _execute(
+      entry.callbacks, [&entry](bool & called) {
+        py::tuple request_and_header = entry.service->service_take_request(entry.request_type);
+        if (request_and_header[1].is_none()) {
+          return;
+        }
+        called = true;
+        if (entry.callbacks.callback_ends_execution) {
+          // The callback sends the response itself once it is done
+          entry.callbacks.callback(request_and_header[0], request_and_header[1]);
+          return;
+        }
+        py::object response = entry.callbacks.callback(
+          request_and_header[0], entry.response_type());
+        if (!py::isinstance(response, entry.response_type)) {
+          RCUTILS_LOG_ERROR_NAMED(
+            entry.service->get_logger_name(),
+            "Callback of service '%s' did not return an instance of the response type, "
+            "no response is sent", entry.service->get_service_name());
+          return;
+        }
+        auto header = request_and_header[1].cast<rmw_service_info_t>();
+        entry.service->service_send_response(response, &header.request_id);
+      });
+  }
+
+  return num_called;
+}
+
+void
+ExecutorCore::destroy()
+{
+  // The callbacks are released without the lock, releasing them may call into the core
+  std::vector<SubscriptionEntry> subscriptions;
+  std::vector<TimerEntry> timers;
+  std::vector<GuardConditionEntry> guard_conditions;
+  std::vector<ServiceEntry> services;
+  std::vector<ClientEntry> clients;
+  auto lock = lock_releasing_gil(mutex_);
+  subscriptions.swap(subscriptions_);
+  timers.swap(timers_);
+  guard_conditions.swap(guard_conditions_);
+  services.swap(services_);
+  clients.swap(clients_);
+  ++generation_;
+  wait_set_.reset();
+  lock.unlock();
+}
+
+void
+define_executor_core(py::object module)
+{
+  py::class_<ExecutorCore, Destroyable, std::shared_ptr<ExecutorCore>>(module, "ExecutorCore")
+  .def(py::init<std::shared_ptr<WaitSet>>())
+  .def(
+    "add_subscription", &ExecutorCore::add_subscription,
+    "Attach a subscription to the wait set and register its callback",
+    py::arg("subscription"), py::arg("msg_type"), py::arg("raw"), py::arg("with_info"),
+    py::arg("callback"), py::arg("begin"), py::arg("end"),
+    py::arg("callback_ends_execution") = false, py::arg("max_batch_size") = 0u,
+    py::arg("loaned_messages") = false, py::arg("reused_message") = py::none(),
+    py::arg("lazy") = false, py::arg("columns") = py::none(), py::arg("array_views") = false,
+    py::arg("group") = nullptr, py::arg("entity") = py::none())
+  .def(
+    "add_timer", &ExecutorCore::add_timer,
+    "Attach a timer to the wait set and register its callback",
+    py::arg("timer"), py::arg("callback"), py::arg("begin"), py::arg("end"),
+    py::arg("callback_ends_execution") = false, py::arg("group") = nullptr,
+    py::arg("entity") = py::none())
+  .def(
+    "add_guard_condition", &ExecutorCore::add_guard_condition,
+    "Attach a guard condition to the wait set and register its callback",
+    py::arg("gc"), py::arg("callback"), py::arg("begin"), py::arg("end"),
+    py::arg("callback_ends_execution") = false, py::arg("group") = nullptr,
+    py::arg("entity") = py::none())
+  .def(
+    "add_service", &ExecutorCore::add_service,
+    "Attach a service to the wait set and register its callback",
+    py::arg("service"), py::arg("request_type"), py::arg("response_type"),
+    py::arg("callback"), py::arg("begin"), py::arg("end"),
+    py::arg("callback_ends_execution") = false, py::arg("group") = nullptr,
+    py::arg("entity") = py::none())
+  .def(
+    "add_client", &ExecutorCore::add_client,
+    "Attach a client to the wait set and register its callback",
+    py::arg("client"), py::arg("response_type"),
+    py::arg("callback"), py::arg("begin"), py::arg("end"),
+    py::arg("callback_ends_execution") = false, py::arg("group") = nullptr,
+    py::arg("entity") = py::none())
+  .def(
+    "remove", py::overload_cast<std::shared_ptr<Subscription>>(&ExecutorCore::remove),
+    "Detach a subscription from the wait set and forget its callback")
+  .def(
+    "remove", py::overload_cast<std::shared_ptr<Timer>>(&ExecutorCore::remove),
+    "Detach a timer from the wait set and forget its callback")
+  .def(
+    "remove", py::overload_cast<std::shared_ptr<GuardCondition>>(&ExecutorCore::remove),
+    "Detach a guard condition from the wait set and forget its callback")
+  .def(
+    "remove", py::overload_cast<std::shared_ptr<Service>>(&ExecutorCore::remove),
+    "Detach a service from the wait set and forget its callback")
+  .def(
+    "remove", py::overload_cast<std::shared_ptr<Client>>(&ExecutorCore::remove),
+    "Detach a client from the wait set and forget its callback")
+  .def(
+    "prepare_wait", &ExecutorCore::prepare_wait,
+    "Clear the wait set and add the attached entities back to it")
+  .def(
+    "wait_and_dispatch", &ExecutorCore::wait_and_dispatch,
+    "Wait on the wait set, then take the data of every ready entity and call its callback",
+    py::arg("timeout_ns"))
+  .def(
+    "dispatch", &ExecutorCore::dispatch,
+    "Take the data of every ready entity and call its callback");
+}
+}  // namespace rclpy
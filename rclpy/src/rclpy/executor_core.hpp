@@ -0,0 +1,306 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLPY__EXECUTOR_CORE_HPP_
+#define RCLPY__EXECUTOR_CORE_HPP_
+
+#include <pybind11/pybind11.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "callback_group.hpp"
+#include "client.hpp"
+#include "destroyable.hpp"
+#include "guard_condition.hpp"
+#include "service.hpp"
+#include "subscription.hpp"
+#include "timer.hpp"
+#include "wait_set.hpp"
+
+namespace py = pybind11;
+
+namespace rclpy
+{
+/// Dispatch the callbacks of entities attached to a wait set without leaving native code
+/**
+ * Entities are registered together with the Python callable to invoke when they are ready.
+ * wait_and_dispatch() waits on the wait set, looks up the ready entities, takes their data
+ * through the same code paths as the Python executors and calls the callables directly.
+ * The GIL is released while waiting, while looking up the ready entities and while taking
+ * their data, it's only held to convert the taken data and to run the callables.
+ *
+ * Every entity may have a pair of callables guarding its execution, typically the
+ * beginning_execution() and ending_execution() methods of its callback group bound to it.
+ * The data of an entity is not taken while its begin callable returns False.
+ * Callback groups with a native state are claimed and released through it instead, without
+ * calling into Python.
+ *
+ * Entities may be added and removed from any thread, including during a wait or from a
+ * callback.
+ * The registered entities are guarded by a mutex, which is not held while waiting nor while
+ * running the callbacks.
+ */
+class ExecutorCore : public Destroyable, public std::enable_shared_from_this<ExecutorCore>
+{
+public:
+  /// Create an executor core dispatching the entities attached to a wait set
+  /**
+   * \param[in] wait_set The wait set entities are attached to, it must not have any attached
+   *   entities yet
+   */
+  explicit ExecutorCore(std::shared_ptr<WaitSet> wait_set);
+
+  ~ExecutorCore() = default;
+
+  /// Attach a subscription to the wait set and register its callback
+  /**
+   * Raises InvalidHandle if the subscription is being destroyed
+   *
+   * \param[in] subscription The subscription to attach
+   * \param[in] pymsg_type The message type to take
+   * \param[in] raw If True take the serialized message instead of converting it
+   * \param[in] with_info If True the callback also gets the message info
+   * \param[in] callback Called with the taken message
+   * \param[in] begin Called before taking, or None
+   * \param[in] end Called after the callback, or None
+   * \param[in] callback_ends_execution If True the callback calls end itself once it is invoked
+   * \param[in] max_batch_size If not zero the callback is called with a list of up to this many
+   *   messages, and with their metadata as returned by Subscription::take_messages()
+   * \param[in] loaned_messages If True the callback is called with a LoanedMessage, which is
+   *   released after the callback unless the callback ends the execution itself
+   * \param[in] reused_message If not None messages are taken into this instance with
+   *   Subscription::take_message_into() and the callback is called with it
+   * \param[in] lazy If True the serialized message is taken and the callback is called with a
+   *   LazyMessage viewing it
+   * \param[in] columns If not None a tuple of an array of C messages and an array of receive
+   *   timestamps, messages are taken into them with Subscription::take_messages_into_array()
+   *   and the callback is called with the filled rows of both
+   * \param[in] array_views If True messages are taken with
+   *   Subscription::take_message_with_array_views()
+   * \param[in] group If not None the callback group state claimed for the entity instead of
+   *   calling begin and end
+   * \param[in] entity The Python entity the callback group state is claimed for
+   */
+  void
+  add_subscription(
+    std::shared_ptr<Subscription> subscription, py::object pymsg_type, bool raw, bool with_info,
+    py::object callback, py::object begin, py::object end, bool callback_ends_execution,
+    size_t max_batch_size, bool loaned_messages, py::object reused_message, bool lazy,
+    py::object columns, bool array_views, std::shared_ptr<CallbackGroupState> group,
+    py::handle entity);
+
+  /// Attach a timer to the wait set and register its callback
+  /**
+   * The timer is only called if it is still ready after the wait, so canceled timers are
+   * skipped.
+   *
+   * \sa add_subscription()
+   */
+  void
+  add_timer(
+    std::shared_ptr<Timer> timer,
+    py::object callback, py::object begin, py::object end, bool callback_ends_execution,
+    std::shared_ptr<CallbackGroupState> group, py::handle entity);
+
+  /// Attach a guard condition to the wait set and register its callback
+  /**
+   * If the callback is None the guard condition only wakes up the wait.
+   *
+   * \sa add_subscription()
+   */
+  void
+  add_guard_condition(
+    std::shared_ptr<GuardCondition> gc,
+    py::object callback, py::object begin, py::object end, bool callback_ends_execution,
+    std::shared_ptr<CallbackGroupState> group, py::handle entity);
+
+  /// Attach a service to the wait set and register its callback
+  /**
+   * The callback is called with the request and a new response instance and must return the
+   * response, which is then sent.
+   * If callback_ends_execution is True the callback is called with the request and its header
+   * instead, and it is responsible for sending the response.
+   *
+   * \param[in] service The service to attach
+   * \param[in] pyrequest_type The request type to take
+   * \param[in] pyresponse_type The response type
+   * \sa add_subscription()
+   */
+  void
+  add_service(
+    std::shared_ptr<Service> service, py::object pyrequest_type, py::object pyresponse_type,
+    py::object callback, py::object begin, py::object end, bool callback_ends_execution,
+    std::shared_ptr<CallbackGroupState> group, py::handle entity);
+
+  /// Attach a client to the wait set and register its callback
+  /**
+   * The callback is called with the header and the response.
+   *
+   * \param[in] client The client to attach
+   * \param[in] pyresponse_type The response type to take
+   * \sa add_subscription()
+   */
+  void
+  add_client(
+    std::shared_ptr<Client> client, py::object pyresponse_type,
+    py::object callback, py::object begin, py::object end, bool callback_ends_execution,
+    std::shared_ptr<CallbackGroupState> group, py::handle entity);
+
+  /// Detach a subscription from the wait set and forget its callback
+  /**
+   * Raises ValueError if the subscription was not added
+   */
+  void
+  remove(std::shared_ptr<Subscription> subscription);
+
+  /// \sa remove(std::shared_ptr<Subscription>)
+  void
+  remove(std::shared_ptr<Timer> timer);
+
+  /// \sa remove(std::shared_ptr<Subscription>)
+  void
+  remove(std::shared_ptr<GuardCondition> gc);
+
+  /// \sa remove(std::shared_ptr<Subscription>)
+  void
+  remove(std::shared_ptr<Service> service);
+
+  /// \sa remove(std::shared_ptr<Subscription>)
+  void
+  remove(std::shared_ptr<Client> client);
+
+  /// Clear the wait set and add the attached entities back to it
+  /**
+   * Entities of the caller, e.g. waitables, can then be added to the wait set before calling
+   * wait_and_dispatch().
+   */
+  void
+  prepare_wait();
+
+  /// Wait on the wait set, then take the data of every ready entity and call its callback
+  /**
+   * \param[in] timeout_ns Maximum time to wait in nanoseconds, if negative wait forever
+   * \return Number of callbacks that were called
+   * \sa dispatch()
+   */
+  size_t
+  wait_and_dispatch(int64_t timeout_ns);
+
+  /// Take the data of every ready entity and call its callback
+  /**
+   * This must be called after waiting on the wait set.
+   * Entities are handled in the order timers, subscriptions, guard conditions, clients and
+   * services.
+   * Entities added to the wait set after the attached ones, such as the ones of waitables, are
+   * ignored.
+   * Dispatching stops early if entities are added or removed by a callback.
+   *
+   * Exceptions raised by a callback are propagated after its end callable was called.
+   * A service callback not returning a response is logged as an error and no response is sent.
+   *
+   * \return Number of callbacks that were called
+   */
+  size_t
+  dispatch();
+
+  /// Forget all callbacks and release the wait set
+  /**
+   * Entities are left attached to the wait set, destroying the wait set detaches them.
+   */
+  void
+  destroy() override;
+
+private:
+  struct Callbacks
+  {
+    py::object callback;
+    py::object begin;
+    py::object end;
+    bool callback_ends_execution;
+    std::shared_ptr<CallbackGroupState> group;
+    /// Token of the entity claiming the callback group state
+    uintptr_t token;
+  };
+
+  struct SubscriptionEntry
+  {
+    std::shared_ptr<Subscription> subscription;
+    py::object msg_type;
+    bool raw;
+    bool with_info;
+    size_t max_batch_size;
+    bool loaned_messages;
+    py::object reused_message;
+    bool lazy;
+    py::object columns;
+    bool array_views;
+    Callbacks callbacks;
+  };
+
+  struct TimerEntry
+  {
+    std::shared_ptr<Timer> timer;
+    Callbacks callbacks;
+  };
+
+  struct GuardConditionEntry
+  {
+    std::shared_ptr<GuardCondition> gc;
+    Callbacks callbacks;
+  };
+
+  struct ServiceEntry
+  {
+    std::shared_ptr<Service> service;
+    py::object request_type;
+    py::object response_type;
+    Callbacks callbacks;
+  };
+
+  struct ClientEntry
+  {
+    std::shared_ptr<Client> client;
+    py::object response_type;
+    Callbacks callbacks;
+  };
+
+  /// Get the wait set, or throw InvalidHandle if the core was destroyed
+  std::shared_ptr<WaitSet>
+  get_wait_set();
+
+  /// Guards the wait set pointer and the entries
+  std::mutex mutex_;
+  std::shared_ptr<WaitSet> wait_set_;
+  std::vector<SubscriptionEntry> subscriptions_;
+  std::vector<TimerEntry> timers_;
+  std::vector<GuardConditionEntry> guard_conditions_;
+  std::vector<ServiceEntry> services_;
+  std::vector<ClientEntry> clients_;
+  /// Incremented whenever entities are added or removed
+  std::atomic<uint64_t> generation_{0u};
+};
+
+/// Define a pybind11 wrapper for an rclpy::ExecutorCore
+/**
+ * \param[in] module a pybind11 module to add the definition to
+ */
+void
+define_executor_core(py::object module);
+}  // namespace rclpy
+
+#endif  // RCLPY__EXECUTOR_CORE_HPP_
@@ -18,7 +18,10 @@
 #include <rcl/guard_condition.h>
 #include <rcl/types.h>
 
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <utility>
 
 #include "context.hpp"
 #include "exceptions.hpp"
@@ -70,6 +73,24 @@ GuardCondition::trigger_guard_condition()
   if (RCL_RET_OK != ret) {
     throw RCLError("failed to trigger guard condition");
   }
+
+  std::lock_guard<std::mutex> lock(on_trigger_mutex_);
+  if (on_trigger_) {
+    on_trigger_(1u);
+  } else {
+    unreported_trigger_ = true;
+  }
+}
+
+void
+GuardCondition::set_on_trigger_callback(std::function<void(size_t)> on_trigger)
+{
+  std::lock_guard<std::mutex> lock(on_trigger_mutex_);
+  on_trigger_ = std::move(on_trigger);
+  if (on_trigger_ && unreported_trigger_) {
+    unreported_trigger_ = false;
+    on_trigger_(1u);
+  }
 }
 
 void define_guard_condition(py::object module)
@@ -19,7 +19,9 @@
 
 #include <rcl/guard_condition.h>
 
+#include <functional>
 #include <memory>
+#include <mutex>
 
 #include "context.hpp"
 #include "destroyable.hpp"
@@ -46,6 +48,19 @@ public:
   void
   trigger_guard_condition();
 
+  /// Set a function called whenever the guard condition is triggered through this object
+  /**
+   * The function is called with the number of triggers.
+   * If the guard condition was triggered while no function was set, it is called right away
+   * with a single trigger, the way a wait set sees pending triggers once.
+   * Triggers of the underlying rcl guard condition not going through
+   * trigger_guard_condition(), e.g. by the signal handler, are not reported.
+   *
+   * \param[in] on_trigger The function to call, or an empty function to unset it
+   */
+  void
+  set_on_trigger_callback(std::function<void(size_t)> on_trigger);
+
   /// Get rcl_guard_condition_t pointer
   rcl_guard_condition_t * rcl_ptr() const
   {
@@ -58,6 +73,10 @@ public:
 private:
   Context context_;
   std::shared_ptr<rcl_guard_condition_t> rcl_guard_condition_;
+  std::mutex on_trigger_mutex_;
+  std::function<void(size_t)> on_trigger_;
+  /// Whether it was triggered while no function was set
+  bool unreported_trigger_ = false;
 
   /// Handle destructor for guard condition
   static void
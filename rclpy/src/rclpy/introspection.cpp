@@ -0,0 +1,451 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <pybind11/pybind11.h>
+
+#include <rcutils/error_handling.h>
+#include <rosidl_runtime_c/message_type_support_struct.h>
+#include <rosidl_runtime_c/string.h>
+#include <rosidl_runtime_c/u16string.h>
+#include <rosidl_typesupport_introspection_c/field_types.h>
+#include <rosidl_typesupport_introspection_c/identifier.h>
+#include <rosidl_typesupport_introspection_c/message_introspection.h>
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "introspection.hpp"
+#include "type_support.hpp"
+#include "utils.hpp"
+
+namespace rclpy
+{
+const rosidl_typesupport_introspection_c__MessageMembers *
+get_message_members(py::object pymsg_type)
+{
+  auto type_support = static_cast<const rosidl_message_type_support_t *>(
+    common_get_type_support(pymsg_type));
+  if (!type_support) {
+    throw py::error_already_set();
+  }
+
+  const rosidl_message_type_support_t * introspection_type_support =
+    get_message_typesupport_handle(type_support, rosidl_typesupport_introspection_c__identifier);
+  if (!introspection_type_support) {
+    std::string error_text{"no introspection type support for message type: "};
+    error_text += rcutils_get_error_string().str;
+    rcutils_reset_error();
+    throw std::runtime_error(error_text);
+  }
+  return static_cast<const rosidl_typesupport_introspection_c__MessageMembers *>(
+    introspection_type_support->data);
+}
+
+const rosidl_typesupport_introspection_c__MessageMember *
+find_message_member(
+  const rosidl_typesupport_introspection_c__MessageMembers * members, const std::string & path,
+  void ** message)
+{
+  size_t begin = 0u;
+  while (true) {
+    const size_t end = path.find('.', begin);
+    const std::string name = path.substr(begin, end - begin);
+    const rosidl_typesupport_introspection_c__MessageMember * member = nullptr;
+    for (uint32_t i = 0u; i < members->member_count_; ++i) {
+      if (name == members->members_[i].name_) {
+        member = &members->members_[i];
+        break;
+      }
+    }
+    if (!member) {
+      throw py::value_error("message has no member '" + path.substr(0, end) + "'");
+    }
+    if (std::string::npos == end) {
+      return member;
+    }
+    if (rosidl_typesupport_introspection_c__ROS_TYPE_MESSAGE != member->type_id_ ||
+      member->is_array_)
+    {
+      throw py::value_error("member '" + path.substr(0, end) + "' is not a nested message");
+    }
+    *message = static_cast<uint8_t *>(*message) + member->offset_;
+    members = static_cast<const rosidl_typesupport_introspection_c__MessageMembers *>(
+      member->members_->data);
+    begin = end + 1u;
+  }
+}
+
+bool
+get_primitive_format(uint8_t type_id, const char ** format, size_t * itemsize)
+{
+  switch (type_id) {
+    case rosidl_typesupport_introspection_c__ROS_TYPE_FLOAT:
+      *format = "f";
+      *itemsize = sizeof(float);
+      break;
+    case rosidl_typesupport_introspection_c__ROS_TYPE_DOUBLE:
+      *format = "d";
+      *itemsize = sizeof(double);
+      break;
+    case rosidl_typesupport_introspection_c__ROS_TYPE_LONG_DOUBLE:
+      *format = "g";
+      *itemsize = sizeof(long double);
+      break;
+    case rosidl_typesupport_introspection_c__ROS_TYPE_BOOLEAN:
+      *format = "?";
+      *itemsize = sizeof(bool);
+      break;
+    case rosidl_typesupport_introspection_c__ROS_TYPE_CHAR:
+    case rosidl_typesupport_introspection_c__ROS_TYPE_INT8:
+      *format = "b";
+      *itemsize = sizeof(int8_t);
+      break;
+    case rosidl_typesupport_introspection_c__ROS_TYPE_OCTET:
+    case rosidl_typesupport_introspection_c__ROS_TYPE_UINT8:
+      *format = "B";
+      *itemsize = sizeof(uint8_t);
+      break;
+    case rosidl_typesupport_introspection_c__ROS_TYPE_WCHAR:
+    case rosidl_typesupport_introspection_c__ROS_TYPE_UINT16:
+      *format = "H";
+      *itemsize = sizeof(uint16_t);
+      break;
+    case rosidl_typesupport_introspection_c__ROS_TYPE_INT16:
+      *format = "h";
+      *itemsize = sizeof(int16_t);
+      break;
+    case rosidl_typesupport_introspection_c__ROS_TYPE_UINT32:
+      *format = "I";
+      *itemsize = sizeof(uint32_t);
+      break;
+    case rosidl_typesupport_introspection_c__ROS_TYPE_INT32:
+      *format = "i";
+      *itemsize = sizeof(int32_t);
+      break;
+    case rosidl_typesupport_introspection_c__ROS_TYPE_UINT64:
+      *format = "Q";
+      *itemsize = sizeof(uint64_t);
+      break;
+    case rosidl_typesupport_introspection_c__ROS_TYPE_INT64:
+      *format = "q";
+      *itemsize = sizeof(int64_t);
+      break;
+    default:
+      return false;
+  }
+  return true;
+}
+
+/// Take ownership of a new reference, throw if it's null because of a Python error
+static py::object
+_steal_or_throw(PyObject * object)
+{
+  if (!object) {
+    throw py::error_already_set();
+  }
+  return py::reinterpret_steal<py::object>(object);
+}
+
+/// Convert a single value of a primitive or string type, return None if it's not supported
+static py::object
+_convert_single_value_to_py(const void * field, uint8_t type_id)
+{
+  switch (type_id) {
+    case rosidl_typesupport_introspection_c__ROS_TYPE_FLOAT:
+      return py::float_(*static_cast<const float *>(field));
+    case rosidl_typesupport_introspection_c__ROS_TYPE_DOUBLE:
+      return py::float_(*static_cast<const double *>(field));
+    case rosidl_typesupport_introspection_c__ROS_TYPE_LONG_DOUBLE:
+      return py::float_(static_cast<double>(*static_cast<const long double *>(field)));
+    case rosidl_typesupport_introspection_c__ROS_TYPE_BOOLEAN:
+      return py::bool_(*static_cast<const bool *>(field));
+    case rosidl_typesupport_introspection_c__ROS_TYPE_CHAR:
+      return _steal_or_throw(PyUnicode_FromOrdinal(*static_cast<const unsigned char *>(field)));
+    case rosidl_typesupport_introspection_c__ROS_TYPE_WCHAR:
+      return _steal_or_throw(PyUnicode_FromOrdinal(*static_cast<const uint16_t *>(field)));
+    case rosidl_typesupport_introspection_c__ROS_TYPE_OCTET:
+      return py::bytes(static_cast<const char *>(field), 1);
+    case rosidl_typesupport_introspection_c__ROS_TYPE_INT8:
+      return py::int_(*static_cast<const int8_t *>(field));
+    case rosidl_typesupport_introspection_c__ROS_TYPE_UINT8:
+      return py::int_(*static_cast<const uint8_t *>(field));
+    case rosidl_typesupport_introspection_c__ROS_TYPE_INT16:
+      return py::int_(*static_cast<const int16_t *>(field));
+    case rosidl_typesupport_introspection_c__ROS_TYPE_UINT16:
+      return py::int_(*static_cast<const uint16_t *>(field));
+    case rosidl_typesupport_introspection_c__ROS_TYPE_INT32:
+      return py::int_(*static_cast<const int32_t *>(field));
+    case rosidl_typesupport_introspection_c__ROS_TYPE_UINT32:
+      return py::int_(*static_cast<const uint32_t *>(field));
+    case rosidl_typesupport_introspection_c__ROS_TYPE_INT64:
+      return py::int_(*static_cast<const int64_t *>(field));
+    case rosidl_typesupport_introspection_c__ROS_TYPE_UINT64:
+      return py::int_(*static_cast<const uint64_t *>(field));
+    case rosidl_typesupport_introspection_c__ROS_TYPE_STRING:
+      {
+        const auto * str = static_cast<const rosidl_runtime_c__String *>(field);
+        // Same error handling as the generated conversion
+        return _steal_or_throw(
+          PyUnicode_DecodeUTF8(str->data, static_cast<Py_ssize_t>(str->size), "replace"));
+      }
+    case rosidl_typesupport_introspection_c__ROS_TYPE_WSTRING:
+      {
+        const auto * str = static_cast<const rosidl_runtime_c__U16String *>(field);
+        return _steal_or_throw(
+          PyUnicode_DecodeUTF16(
+            reinterpret_cast<const char *>(str->data),
+            static_cast<Py_ssize_t>(str->size * sizeof(uint16_t)), NULL, NULL));
+      }
+    default:
+      return py::none();
+  }
+}
+
+/// Copy items into the existing buffer of a Python object, return false if it doesn't fit
+static bool
+_copy_into_py_buffer(py::handle pyobject, const void * data, size_t itemsize, size_t count)
+{
+  if (!PyObject_CheckBuffer(pyobject.ptr())) {
+    return false;
+  }
+  Py_buffer view;
+  if (PyObject_GetBuffer(pyobject.ptr(), &view, PyBUF_WRITABLE | PyBUF_C_CONTIGUOUS) != 0) {
+    PyErr_Clear();
+    return false;
+  }
+  const bool fits = static_cast<size_t>(view.itemsize) == itemsize &&
+    static_cast<size_t>(view.len) == itemsize * count;
+  if (fits && count > 0u) {
+    std::memcpy(view.buf, data, itemsize * count);
+  }
+  PyBuffer_Release(&view);
+  return fits;
+}
+
+/// Get the Python type of the messages described by introspection members
+static py::object
+_get_pymsg_type(const rosidl_typesupport_introspection_c__MessageMembers * members)
+{
+  // The namespace is e.g. "std_msgs__msg" for the Python module std_msgs.msg
+  std::string module_name = members->message_namespace_;
+  for (size_t pos = module_name.find("__"); pos != std::string::npos;
+    pos = module_name.find("__", pos))
+  {
+    module_name.replace(pos, 2u, ".");
+  }
+  return py::module_::import(module_name.c_str()).attr(members->message_name_);
+}
+
+/// Update a list of Python messages in place from the messages of an array or sequence member
+static py::object
+_update_py_message_list(
+  const void * field, const rosidl_typesupport_introspection_c__MessageMember & member,
+  py::handle pyfield)
+{
+  const auto * members =
+    static_cast<const rosidl_typesupport_introspection_c__MessageMembers *>(
+    member.members_->data);
+  const size_t count = member.size_function(field);
+  py::list items = py::isinstance<py::list>(pyfield) ?
+    py::reinterpret_borrow<py::list>(pyfield) : py::list(pyfield);
+  if (items.size() > count) {
+    if (PySequence_DelSlice(items.ptr(), static_cast<Py_ssize_t>(count), PY_SSIZE_T_MAX) != 0) {
+      throw py::error_already_set();
+    }
+  }
+  py::object pymsg_type;
+  for (size_t j = 0u; j < count; ++j) {
+    const void * item = member.get_const_function(field, j);
+    if (j < items.size()) {
+      update_py_message(item, members, items[j]);
+      continue;
+    }
+    if (!pymsg_type) {
+      pymsg_type = _get_pymsg_type(members);
+    }
+    py::object pyitem = pymsg_type();
+    update_py_message(item, members, pyitem);
+    items.append(pyitem);
+  }
+  return items;
+}
+
+/// Convert the values of an array or sequence member to a list, return None if not supported
+static py::object
+_convert_values_to_py_list(
+  const void * field, const rosidl_typesupport_introspection_c__MessageMember & member)
+{
+  const size_t count = member.size_function(field);
+  py::list items(count);
+  for (size_t j = 0u; j < count; ++j) {
+    py::object item = _convert_single_value_to_py(
+      member.get_const_function(field, j), member.type_id_);
+    if (item.is_none()) {
+      return py::none();
+    }
+    items[j] = std::move(item);
+  }
+  return items;
+}
+
+void
+update_py_message(
+  const void * message, const rosidl_typesupport_introspection_c__MessageMembers * members,
+  py::handle pymsg)
+{
+  // Members that can't be updated in place are taken from a regular conversion, done once
+  py::object pyconverted;
+
+  for (uint32_t i = 0u; i < members->member_count_; ++i) {
+    const rosidl_typesupport_introspection_c__MessageMember & member = members->members_[i];
+    // Generated messages store the value of each member in a slot named after it
+    const std::string slot = std::string("_") + member.name_;
+    const void * field = static_cast<const uint8_t *>(message) + member.offset_;
+
+    py::object value;
+    if (!member.is_array_) {
+      if (rosidl_typesupport_introspection_c__ROS_TYPE_MESSAGE == member.type_id_) {
+        update_py_message(
+          field,
+          static_cast<const rosidl_typesupport_introspection_c__MessageMembers *>(
+            member.members_->data),
+          pymsg.attr(slot.c_str()));
+        continue;
+      }
+      value = _convert_single_value_to_py(field, member.type_id_);
+    } else if (rosidl_typesupport_introspection_c__ROS_TYPE_MESSAGE == member.type_id_) {
+      value = _update_py_message_list(field, member, pymsg.attr(slot.c_str()));
+    } else {
+      py::object pyfield = pymsg.attr(slot.c_str());
+      const char * format = nullptr;
+      size_t itemsize = 0u;
+      if (get_primitive_format(member.type_id_, &format, &itemsize) &&
+        PyObject_CheckBuffer(pyfield.ptr()))
+      {
+        // Arrays are NumPy arrays and sequences are array.array, their memory can be reused if
+        // they hold as many items as the C message
+        const void * data = field;
+        size_t count = member.array_size_;
+        const bool is_sequence = 0u == member.array_size_ || member.is_upper_bound_;
+        if (is_sequence) {
+          count = member.size_function(field);
+          data = count > 0u ? member.get_const_function(field, 0u) : nullptr;
+        }
+        if (_copy_into_py_buffer(pyfield, data, itemsize, count)) {
+          continue;
+        }
+        if (is_sequence && py::hasattr(pyfield, "typecode")) {
+          // The size of the sequence changed, replace the array.array with one of the new size
+          value = pyfield.get_type()(
+            pyfield.attr("typecode"),
+            py::bytes(static_cast<const char *>(data), itemsize * count));
+        }
+      } else {
+        // Other arrays and sequences, e.g. of strings or booleans, are lists
+        value = _convert_values_to_py_list(field, member);
+      }
+    }
+
+    if (!value || value.is_none()) {
+      if (!pyconverted) {
+        TypeSupportHandle type_support(py::reinterpret_borrow<py::object>(pymsg.get_type()));
+        pyconverted = type_support.convert_to_py(const_cast<void *>(message));
+      }
+      value = pyconverted.attr(slot.c_str());
+    }
+    pymsg.attr(slot.c_str()) = value;
+  }
+}
+
+bool
+has_fixed_layout(const rosidl_typesupport_introspection_c__MessageMembers * members)
+{
+  for (uint32_t i = 0u; i < members->member_count_; ++i) {
+    const rosidl_typesupport_introspection_c__MessageMember & member = members->members_[i];
+    if (member.is_array_ && (0u == member.array_size_ || member.is_upper_bound_)) {
+      return false;
+    }
+    const char * format = nullptr;
+    size_t itemsize = 0u;
+    if (rosidl_typesupport_introspection_c__ROS_TYPE_MESSAGE == member.type_id_) {
+      if (!has_fixed_layout(
+          static_cast<const rosidl_typesupport_introspection_c__MessageMembers *>(
+            member.members_->data)))
+      {
+        return false;
+      }
+    } else if (!get_primitive_format(member.type_id_, &format, &itemsize)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+size_t
+get_fixed_member_size(const rosidl_typesupport_introspection_c__MessageMember * member)
+{
+  size_t size = 0u;
+  if (rosidl_typesupport_introspection_c__ROS_TYPE_MESSAGE == member->type_id_) {
+    size = static_cast<const rosidl_typesupport_introspection_c__MessageMembers *>(
+      member->members_->data)->size_of_;
+  } else {
+    const char * format = nullptr;
+    get_primitive_format(member->type_id_, &format, &size);
+  }
+  return member->is_array_ ? size * member->array_size_ : size;
+}
+
+py::object
+get_message_dtype(const rosidl_typesupport_introspection_c__MessageMembers * members)
+{
+  if (!has_fixed_layout(members)) {
+    throw py::value_error(
+            std::string("message type '") + members->message_name_ +
+            "' doesn't have a fixed layout");
+  }
+
+  py::list names;
+  py::list formats;
+  py::list offsets;
+  for (uint32_t i = 0u; i < members->member_count_; ++i) {
+    const rosidl_typesupport_introspection_c__MessageMember & member = members->members_[i];
+    py::object format;
+    if (rosidl_typesupport_introspection_c__ROS_TYPE_MESSAGE == member.type_id_) {
+      format = get_message_dtype(
+        static_cast<const rosidl_typesupport_introspection_c__MessageMembers *>(
+          member.members_->data));
+    } else {
+      const char * primitive_format = nullptr;
+      size_t itemsize = 0u;
+      get_primitive_format(member.type_id_, &primitive_format, &itemsize);
+      format = py::str(primitive_format);
+    }
+    if (member.is_array_) {
+      format = py::make_tuple(format, py::make_tuple(member.array_size_));
+    }
+    names.append(member.name_);
+    formats.append(format);
+    offsets.append(member.offset_);
+  }
+
+  py::dict description;
+  description["names"] = names;
+  description["formats"] = formats;
+  description["offsets"] = offsets;
+  description["itemsize"] = members->size_of_;
+  return py::module::import("numpy").attr("dtype")(description);
+}
+}  // namespace rclpy
@@ -0,0 +1,123 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLPY__INTROSPECTION_HPP_
+#define RCLPY__INTROSPECTION_HPP_
+
+#include <pybind11/pybind11.h>
+
+#include <rosidl_typesupport_introspection_c/message_introspection.h>
+
+#include <cstdint>
+#include <string>
+
+namespace py = pybind11;
+
+namespace rclpy
+{
+/// Get the introspection type support of a ROS message type
+/**
+ * The introspection type support describes the layout of the C struct of the message, i.e.
+ * the size of the struct and the name, type and offset of each of its members.
+ *
+ * Raises AttributeError if \p pymsg_type is missing its type support
+ * Raises RuntimeError if the message type has no introspection type support
+ *
+ * \param[in] pymsg_type ROS message Python type
+ * \return The members of the message, valid as long as the type support library is loaded
+ */
+const rosidl_typesupport_introspection_c__MessageMembers *
+get_message_members(py::object pymsg_type);
+
+/// Find a member of a message by its name
+/**
+ * Members of nested messages are found by joining the names with dots, e.g. "header.stamp".
+ *
+ * Raises ValueError if there is no such member or if the path goes through a member that is
+ * not a single nested message
+ *
+ * \param[in] members The members of the message
+ * \param[in] path The name of the member
+ * \param[inout] message The C message, it is set to the nested message holding the member
+ * \return The member
+ */
+const rosidl_typesupport_introspection_c__MessageMember *
+find_message_member(
+  const rosidl_typesupport_introspection_c__MessageMembers * members, const std::string & path,
+  void ** message);
+
+/// Get the buffer format and item size of a primitive type
+/**
+ * \param[in] type_id The introspection type id
+ * \param[out] format The buffer protocol format of the type
+ * \param[out] itemsize The size of a value of the type
+ * \return false if the type is not primitive, e.g. a string or a nested message
+ */
+bool
+get_primitive_format(uint8_t type_id, const char ** format, size_t * itemsize);
+
+/// Update the members of a Python message in place from a C message
+/**
+ * Nested messages, NumPy arrays, array.array sequences and lists of nested messages already
+ * held by the Python message are reused, their values are overwritten.
+ * Other members, e.g. strings or lists of strings, and array.array sequences whose size
+ * changed are replaced with values converted for that member only.
+ *
+ * Raises any exception raised by the conversion
+ *
+ * \param[in] message The C message to convert
+ * \param[in] members The members of the message
+ * \param[in] pymsg An instance of the Python message type matching \p members
+ */
+void
+update_py_message(
+  const void * message, const rosidl_typesupport_introspection_c__MessageMembers * members,
+  py::handle pymsg);
+
+/// Check whether a message only holds primitive values, directly or in fixed size arrays
+/**
+ * The C struct of such a message doesn't own any memory, so it can be copied as is.
+ * Nested messages must have a fixed layout as well.
+ *
+ * \param[in] members The members of the message
+ * \return true if the message has a fixed layout
+ */
+bool
+has_fixed_layout(const rosidl_typesupport_introspection_c__MessageMembers * members);
+
+/// Get the size of the value of a member of a message of fixed layout
+/**
+ * \param[in] member The member of the message
+ * \return The size of the value, or of all the items of an array
+ */
+size_t
+get_fixed_member_size(const rosidl_typesupport_introspection_c__MessageMember * member);
+
+/// Get the NumPy structured data type matching the C struct of a message of fixed layout
+/**
+ * Each member is a field of the data type at the offset of the member in the C struct,
+ * nested messages are nested structured data types and fixed size arrays are subarrays.
+ * The item size of the data type is the size of the C struct, so an array of it has the
+ * memory layout of an array of C messages.
+ *
+ * Raises ValueError if the message doesn't have a fixed layout
+ *
+ * \param[in] members The members of the message
+ * \return The numpy.dtype
+ */
+py::object
+get_message_dtype(const rosidl_typesupport_introspection_c__MessageMembers * members);
+}  // namespace rclpy
+
+#endif  // RCLPY__INTROSPECTION_HPP_
@@ -0,0 +1,478 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <pybind11/pybind11.h>
+
+#include <rosidl_typesupport_introspection_c/field_types.h>
+#include <rosidl_typesupport_introspection_c/message_introspection.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "introspection.hpp"
+#include "lazy_message.hpp"
+#include "serialization.hpp"
+#include "utils.hpp"
+
+namespace rclpy
+{
+namespace
+{
+/// Size of the encapsulation header preceding the CDR stream
+constexpr size_t kEncapsulationSize = 4u;
+
+/// Thrown when the serialized message can't be decoded in place
+struct UnsupportedEncoding
+{
+};
+
+bool
+host_is_little_endian()
+{
+  const uint16_t one = 1u;
+  uint8_t first_byte;
+  std::memcpy(&first_byte, &one, 1u);
+  return 1u == first_byte;
+}
+
+/// Sequential reader of a CDR stream, aligning values relative to the end of the header
+class CdrReader
+{
+public:
+  CdrReader(const uint8_t * data, size_t size, bool swap, size_t position)
+  : data_(data), size_(size), swap_(swap), position_(position)
+  {
+  }
+
+  void
+  align(size_t alignment)
+  {
+    const size_t misalignment = (position_ - kEncapsulationSize) % alignment;
+    if (misalignment) {
+      position_ += alignment - misalignment;
+    }
+  }
+
+  const uint8_t *
+  skip(size_t size)
+  {
+    if (position_ > size_ || size > size_ - position_) {
+      throw py::value_error("serialized message is truncated");
+    }
+    const uint8_t * data = data_ + position_;
+    position_ += size;
+    return data;
+  }
+
+  template<typename T>
+  T
+  read()
+  {
+    align(sizeof(T));
+    uint8_t bytes[sizeof(T)];
+    std::memcpy(bytes, skip(sizeof(T)), sizeof(T));
+    if (swap_) {
+      std::reverse(bytes, bytes + sizeof(T));
+    }
+    T value;
+    std::memcpy(&value, bytes, sizeof(T));
+    return value;
+  }
+
+  size_t
+  position() const
+  {
+    return position_;
+  }
+
+private:
+  const uint8_t * data_;
+  size_t size_;
+  bool swap_;
+  size_t position_;
+};
+
+/// Get the serialized size of a primitive type and its NumPy type, or nullptr if it has none
+/**
+ * Returns false if the type is not primitive.
+ * Throws UnsupportedEncoding for types which are serialized differently by each middleware.
+ */
+bool
+get_primitive_layout(uint8_t type_id, size_t * size, const char ** dtype)
+{
+  switch (type_id) {
+    case rosidl_typesupport_introspection_c__ROS_TYPE_FLOAT:
+      *size = 4u;
+      *dtype = "f4";
+      return true;
+    case rosidl_typesupport_introspection_c__ROS_TYPE_DOUBLE:
+      *size = 8u;
+      *dtype = "f8";
+      return true;
+    case rosidl_typesupport_introspection_c__ROS_TYPE_BOOLEAN:
+    case rosidl_typesupport_introspection_c__ROS_TYPE_CHAR:
+    case rosidl_typesupport_introspection_c__ROS_TYPE_OCTET:
+      *size = 1u;
+      *dtype = nullptr;
+      return true;
+    case rosidl_typesupport_introspection_c__ROS_TYPE_INT8:
+      *size = 1u;
+      *dtype = "i1";
+      return true;
+    case rosidl_typesupport_introspection_c__ROS_TYPE_UINT8:
+      *size = 1u;
+      *dtype = "u1";
+      return true;
+    case rosidl_typesupport_introspection_c__ROS_TYPE_INT16:
+      *size = 2u;
+      *dtype = "i2";
+      return true;
+    case rosidl_typesupport_introspection_c__ROS_TYPE_UINT16:
+      *size = 2u;
+      *dtype = "u2";
+      return true;
+    case rosidl_typesupport_introspection_c__ROS_TYPE_INT32:
+      *size = 4u;
+      *dtype = "i4";
+      return true;
+    case rosidl_typesupport_introspection_c__ROS_TYPE_UINT32:
+      *size = 4u;
+      *dtype = "u4";
+      return true;
+    case rosidl_typesupport_introspection_c__ROS_TYPE_INT64:
+      *size = 8u;
+      *dtype = "i8";
+      return true;
+    case rosidl_typesupport_introspection_c__ROS_TYPE_UINT64:
+      *size = 8u;
+      *dtype = "u8";
+      return true;
+    case rosidl_typesupport_introspection_c__ROS_TYPE_LONG_DOUBLE:
+    case rosidl_typesupport_introspection_c__ROS_TYPE_WCHAR:
+    case rosidl_typesupport_introspection_c__ROS_TYPE_WSTRING:
+      throw UnsupportedEncoding();
+    default:
+      return false;
+  }
+}
+
+const rosidl_typesupport_introspection_c__MessageMembers *
+get_nested_members(const rosidl_typesupport_introspection_c__MessageMember & member)
+{
+  return static_cast<const rosidl_typesupport_introspection_c__MessageMembers *>(
+    member.members_->data);
+}
+
+/// Read the number of items of a member, which is serialized before the items of sequences
+size_t
+read_item_count(
+  CdrReader & reader, const rosidl_typesupport_introspection_c__MessageMember & member)
+{
+  if (!member.is_array_) {
+    return 1u;
+  }
+  if (member.array_size_ > 0u && !member.is_upper_bound_) {
+    return member.array_size_;
+  }
+  return reader.read<uint32_t>();
+}
+
+void
+skip_message(
+  CdrReader & reader, const rosidl_typesupport_introspection_c__MessageMembers * members);
+
+void
+skip_member(CdrReader & reader, const rosidl_typesupport_introspection_c__MessageMember & member)
+{
+  const size_t count = read_item_count(reader, member);
+  size_t size;
+  const char * dtype;
+  if (get_primitive_layout(member.type_id_, &size, &dtype)) {
+    if (count > 0u) {
+      reader.align(size);
+      reader.skip(size * count);
+    }
+  } else if (rosidl_typesupport_introspection_c__ROS_TYPE_STRING == member.type_id_) {
+    for (size_t i = 0u; i < count; ++i) {
+      reader.skip(reader.read<uint32_t>());
+    }
+  } else {
+    for (size_t i = 0u; i < count; ++i) {
+      skip_message(reader, get_nested_members(member));
+    }
+  }
+}
+
+void
+skip_message(
+  CdrReader & reader, const rosidl_typesupport_introspection_c__MessageMembers * members)
+{
+  for (uint32_t i = 0u; i < members->member_count_; ++i) {
+    skip_member(reader, members->members_[i]);
+  }
+}
+
+/// Decode a single value of a primitive or string type
+py::object
+decode_value(CdrReader & reader, uint8_t type_id)
+{
+  switch (type_id) {
+    case rosidl_typesupport_introspection_c__ROS_TYPE_FLOAT:
+      return py::float_(reader.read<float>());
+    case rosidl_typesupport_introspection_c__ROS_TYPE_DOUBLE:
+      return py::float_(reader.read<double>());
+    case rosidl_typesupport_introspection_c__ROS_TYPE_BOOLEAN:
+      return py::bool_(0u != reader.read<uint8_t>());
+    case rosidl_typesupport_introspection_c__ROS_TYPE_CHAR:
+      {
+        PyObject * pystr = PyUnicode_FromOrdinal(reader.read<uint8_t>());
+        if (!pystr) {
+          throw py::error_already_set();
+        }
+        return py::reinterpret_steal<py::object>(pystr);
+      }
+    case rosidl_typesupport_introspection_c__ROS_TYPE_OCTET:
+      return py::bytes(reinterpret_cast<const char *>(reader.skip(1u)), 1u);
+    case rosidl_typesupport_introspection_c__ROS_TYPE_INT8:
+      return py::int_(reader.read<int8_t>());
+    case rosidl_typesupport_introspection_c__ROS_TYPE_UINT8:
+      return py::int_(reader.read<uint8_t>());
+    case rosidl_typesupport_introspection_c__ROS_TYPE_INT16:
+      return py::int_(reader.read<int16_t>());
+    case rosidl_typesupport_introspection_c__ROS_TYPE_UINT16:
+      return py::int_(reader.read<uint16_t>());
+    case rosidl_typesupport_introspection_c__ROS_TYPE_INT32:
+      return py::int_(reader.read<int32_t>());
+    case rosidl_typesupport_introspection_c__ROS_TYPE_UINT32:
+      return py::int_(reader.read<uint32_t>());
+    case rosidl_typesupport_introspection_c__ROS_TYPE_INT64:
+      return py::int_(reader.read<int64_t>());
+    case rosidl_typesupport_introspection_c__ROS_TYPE_UINT64:
+      return py::int_(reader.read<uint64_t>());
+    case rosidl_typesupport_introspection_c__ROS_TYPE_STRING:
+      {
+        // The length includes the terminating null character
+        const uint32_t length = reader.read<uint32_t>();
+        const uint8_t * data = reader.skip(length);
+        // Same error handling as the generated conversion
+        PyObject * pystr = PyUnicode_DecodeUTF8(
+          reinterpret_cast<const char *>(data),
+          static_cast<Py_ssize_t>(length > 0u ? length - 1u : 0u), "replace");
+        if (!pystr) {
+          throw py::error_already_set();
+        }
+        return py::reinterpret_steal<py::object>(pystr);
+      }
+    default:
+      throw UnsupportedEncoding();
+  }
+}
+}  // namespace
+
+struct LazyMessage::Root
+{
+  py::object pybuffer;
+  py::object pymsg_type;
+  std::unique_ptr<BufferView> buffer;
+  /// Whether the message is encoded as plain CDR, which is decoded in place
+  bool plain_cdr;
+  bool little_endian;
+  /// Guards message, which the views of the nested messages share
+  std::mutex mutex;
+  /// The deserialized message, once a member couldn't be decoded in place
+  py::object message;
+};
+
+LazyMessage::LazyMessage(py::object pybuffer, py::object pymsg_type)
+: root_(std::make_shared<Root>()),
+  members_(get_message_members(pymsg_type)),
+  member_offsets_{kEncapsulationSize}
+{
+  root_->pybuffer = pybuffer;
+  root_->pymsg_type = pymsg_type;
+  root_->buffer = std::make_unique<BufferView>(pybuffer, false);
+  if (root_->buffer->size() < kEncapsulationSize) {
+    throw py::value_error("serialized message is truncated");
+  }
+  // The encapsulation identifier is big endian, 0 is CDR_BE and 1 is CDR_LE
+  const uint8_t * header = root_->buffer->data();
+  root_->plain_cdr = 0u == header[0] && header[1] <= 1u;
+  root_->little_endian = 1u == header[1];
+}
+
+LazyMessage::LazyMessage(
+  std::shared_ptr<Root> root, const rosidl_typesupport_introspection_c__MessageMembers * members,
+  size_t offset, std::vector<py::object> path)
+: root_(std::move(root)), members_(members), member_offsets_{offset}, path_(std::move(path))
+{
+}
+
+py::object
+LazyMessage::get_member(const std::string & name)
+{
+  py::str pyname(name);
+  auto lock = lock_releasing_gil(mutex_);
+  if (values_.contains(pyname)) {
+    return values_[pyname];
+  }
+
+  uint32_t index = 0u;
+  while (index < members_->member_count_ && name != members_->members_[index].name_) {
+    ++index;
+  }
+  if (index == members_->member_count_) {
+    throw py::attribute_error("message has no member '" + name + "'");
+  }
+
+  py::object value;
+  if (root_->plain_cdr) {
+    try {
+      value = decode_member(members_->members_[index], get_member_offset(index));
+    } catch (const UnsupportedEncoding &) {
+    }
+  }
+  if (!value) {
+    value = deserialize().attr(pyname);
+  }
+  values_[pyname] = value;
+  return value;
+}
+
+py::list
+LazyMessage::get_member_names() const
+{
+  py::list names;
+  for (uint32_t i = 0u; i < members_->member_count_; ++i) {
+    names.append(members_->members_[i].name_);
+  }
+  return names;
+}
+
+py::object
+LazyMessage::deserialize()
+{
+  py::object message;
+  {
+    auto lock = lock_releasing_gil(root_->mutex);
+    if (!root_->message) {
+      root_->message = rclpy::deserialize(root_->pybuffer, root_->pymsg_type);
+    }
+    message = root_->message;
+  }
+  for (const py::object & key : path_) {
+    if (py::isinstance<py::str>(key)) {
+      message = message.attr(key);
+    } else {
+      message = message[key];
+    }
+  }
+  return message;
+}
+
+py::object
+LazyMessage::get_buffer() const
+{
+  return root_->pybuffer;
+}
+
+size_t
+LazyMessage::get_member_offset(uint32_t index)
+{
+  while (member_offsets_.size() <= index) {
+    CdrReader reader(
+      root_->buffer->data(), root_->buffer->size(), root_->little_endian != host_is_little_endian(),
+      member_offsets_.back());
+    skip_member(reader, members_->members_[member_offsets_.size() - 1u]);
+    member_offsets_.push_back(reader.position());
+  }
+  return member_offsets_[index];
+}
+
+py::object
+LazyMessage::decode_member(
+  const rosidl_typesupport_introspection_c__MessageMember & member, size_t offset)
+{
+  CdrReader reader(
+    root_->buffer->data(), root_->buffer->size(), root_->little_endian != host_is_little_endian(),
+    offset);
+
+  auto create_view = [this, &reader, &member](std::vector<py::object> path) {
+      auto view = std::shared_ptr<LazyMessage>(
+        new LazyMessage(root_, get_nested_members(member), reader.position(), std::move(path)));
+      return py::cast(view);
+    };
+  std::vector<py::object> path = path_;
+  path.push_back(py::str(member.name_));
+
+  const bool is_message = rosidl_typesupport_introspection_c__ROS_TYPE_MESSAGE == member.type_id_;
+  if (!member.is_array_) {
+    return is_message ? create_view(std::move(path)) : decode_value(reader, member.type_id_);
+  }
+
+  const size_t count = read_item_count(reader, member);
+  size_t size;
+  const char * dtype = nullptr;
+  if (get_primitive_layout(member.type_id_, &size, &dtype) && dtype) {
+    // Numeric items are exposed in place, with the byte order of the serialized message
+    if (count > 0u) {
+      reader.align(size);
+    }
+    const size_t position = reader.position();
+    reader.skip(size * count);
+    py::object array = py::module::import("numpy").attr("frombuffer")(
+      root_->pybuffer, py::str(std::string(root_->little_endian ? "<" : ">") + dtype),
+      count, position);
+    array.attr("setflags")(py::arg("write") = false);
+    return array;
+  }
+
+  py::list items;
+  for (size_t i = 0u; i < count; ++i) {
+    if (is_message) {
+      std::vector<py::object> item_path = path;
+      item_path.push_back(py::int_(i));
+      items.append(create_view(std::move(item_path)));
+      skip_message(reader, get_nested_members(member));
+    } else {
+      items.append(decode_value(reader, member.type_id_));
+    }
+  }
+  return items;
+}
+
+void
+define_lazy_message(py::object module)
+{
+  py::class_<LazyMessage, std::shared_ptr<LazyMessage>>(module, "LazyMessage")
+  .def(py::init<py::object, py::object>())
+  .def(
+    "__getattr__", &LazyMessage::get_member,
+    "Get the value of a member, decoding it on first access")
+  .def(
+    "__dir__", &LazyMessage::get_member_names,
+    "Get the names of the members of the message")
+  .def(
+    "_deserialize", &LazyMessage::deserialize,
+    "Deserialize the viewed message into a Python message")
+  .def_property_readonly(
+    "_buffer", &LazyMessage::get_buffer,
+    "The object holding the serialized message");
+}
+}  // namespace rclpy
@@ -0,0 +1,127 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLPY__LAZY_MESSAGE_HPP_
+#define RCLPY__LAZY_MESSAGE_HPP_
+
+#include <pybind11/pybind11.h>
+
+#include <rosidl_typesupport_introspection_c/message_introspection.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace py = pybind11;
+
+namespace rclpy
+{
+/// A view of a serialized message decoding its members when they are accessed
+/**
+ * The serialized message is kept as is and a member is only decoded, using the introspection
+ * type support of the message, the first time it is accessed as an attribute of the view.
+ * Members preceding it are skipped over without being converted, so reading a small member
+ * of a large message doesn't pay for converting the whole message.
+ *
+ * Members are decoded to the same Python types as in Python messages, except:
+ *  - nested messages are views of the nested serialized message,
+ *  - arrays and sequences of numeric types are read-only NumPy arrays over the serialized
+ *    message, without copying their items,
+ *  - arrays and sequences of other types are lists.
+ *
+ * Only the plain CDR encoding, as produced by the ROS 2 middlewares, is decoded in place.
+ * When a member can't be decoded in place, e.g. because the message uses another encoding or
+ * a wide string precedes the member, the whole message is deserialized once instead and the
+ * member is taken from the deserialized message.
+ *
+ * A view may be read from several threads, its decoded members are cached under a mutex.
+ */
+class LazyMessage
+{
+public:
+  /// Create a view of a serialized message
+  /**
+   * Raises ValueError if the message type is missing its type support
+   * Raises RuntimeError if the message type has no introspection type support
+   *
+   * \param[in] pybuffer An object exposing the serialized message through the buffer protocol
+   * \param[in] pymsg_type The type of the serialized message
+   */
+  LazyMessage(py::object pybuffer, py::object pymsg_type);
+
+  /// Get the value of a member, decoding it on first access
+  /**
+   * Raises AttributeError if the message has no such member
+   * Raises ValueError if the serialized message is truncated
+   *
+   * \param[in] name The name of the member
+   * \return The value of the member
+   */
+  py::object
+  get_member(const std::string & name);
+
+  /// Get the names of the members of the message
+  py::list
+  get_member_names() const;
+
+  /// Deserialize the viewed message into a Python message
+  /**
+   * The whole serialized message is deserialized, at most once, and the nested message
+   * viewed by this instance is returned.
+   *
+   * \return The Python message
+   */
+  py::object
+  deserialize();
+
+  /// Get the object holding the serialized message
+  py::object
+  get_buffer() const;
+
+private:
+  struct Root;
+
+  LazyMessage(
+    std::shared_ptr<Root> root, const rosidl_typesupport_introspection_c__MessageMembers * members,
+    size_t offset, std::vector<py::object> path);
+
+  /// Get the position of the member of the given index in the serialized message
+  size_t
+  get_member_offset(uint32_t index);
+
+  py::object
+  decode_member(const rosidl_typesupport_introspection_c__MessageMember & member, size_t offset);
+
+  std::shared_ptr<Root> root_;
+  const rosidl_typesupport_introspection_c__MessageMembers * members_;
+  /// Guards member_offsets_ and values_
+  std::mutex mutex_;
+  /// Positions of the members already reached, the first one is the start of the message
+  std::vector<size_t> member_offsets_;
+  /// Names and indices leading from the root message to the viewed one
+  std::vector<py::object> path_;
+  py::dict values_;
+};
+
+/// Define a pybind11 wrapper for an rclpy::LazyMessage
+/**
+ * \param[in] module a pybind11 module to add the definition to
+ */
+void
+define_lazy_message(py::object module);
+}  // namespace rclpy
+
+#endif  // RCLPY__LAZY_MESSAGE_HPP_
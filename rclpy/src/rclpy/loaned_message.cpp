@@ -0,0 +1,206 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <pybind11/pybind11.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "introspection.hpp"
+#include "loaned_message.hpp"
+#include "member_buffer.hpp"
+#include "type_support.hpp"
+#include "utils.hpp"
+
+namespace rclpy
+{
+class LoanedMessage::ViewOwner
+{
+public:
+  explicit ViewOwner(std::shared_ptr<LoanedMessage> message)
+  : message_(std::move(message))
+  {
+  }
+
+  ~ViewOwner()
+  {
+    message_->end_view();
+  }
+
+private:
+  std::shared_ptr<LoanedMessage> message_;
+};
+
+LoanedMessage::LoanedMessage(
+  void * message, ReleaseFunction release_message, const TypeSupportHandle & type_support,
+  bool loaned, bool readonly, const void * source)
+: message_(message, std::move(release_message)), type_support_(type_support),
+  members_(get_message_members(type_support.pymsg_type())), loaned_(loaned), readonly_(readonly),
+  source_(source)
+{
+}
+
+std::shared_ptr<void>
+LoanedMessage::make_view_owner()
+{
+  auto owner = std::make_shared<ViewOwner>(shared_from_this());
+  ++num_view_owners_;
+  // Views get the C message from the owner
+  return std::shared_ptr<void>(owner, message_.get());
+}
+
+void
+LoanedMessage::end_view()
+{
+  auto lock = lock_releasing_gil(mutex_);
+  if (0u == --num_view_owners_ && release_requested_) {
+    message_.reset();
+  }
+}
+
+bool
+LoanedMessage::is_released()
+{
+  auto lock = lock_releasing_gil(mutex_);
+  return !message_ || release_requested_;
+}
+
+py::object
+LoanedMessage::get_message()
+{
+  std::shared_ptr<void> owner;
+  {
+    auto lock = lock_releasing_gil(mutex_);
+    if (!message_ || release_requested_) {
+      throw py::value_error("loaned message was already released");
+    }
+    if (!readonly_) {
+      // The message may have been written to since the last conversion
+      return type_support_.convert_to_py(message_.get());
+    }
+    owner = make_view_owner();
+  }
+  return convert_to_py_with_array_views(type_support_, members_, owner);
+}
+
+py::memoryview
+LoanedMessage::get_member_view(const std::string & path)
+{
+  std::shared_ptr<void> owner;
+  void * message = nullptr;
+  {
+    auto lock = lock_releasing_gil(mutex_);
+    if (!message_ || release_requested_) {
+      throw py::value_error("loaned message was already released");
+    }
+    message = message_.get();
+    owner = make_view_owner();
+  }
+  const auto * member = find_message_member(members_, path, &message);
+  return rclpy::get_member_view(owner, message, member, readonly_);
+}
+
+void
+LoanedMessage::resize_member(const std::string & path, size_t size)
+{
+  auto lock = lock_releasing_gil(mutex_);
+  if (!message_ || release_requested_) {
+    throw py::value_error("loaned message was already released");
+  }
+  if (loaned_) {
+    // Memory of the middleware can't hold heap allocated sequences
+    throw py::value_error("sequences of messages loaned from the middleware can't be resized");
+  }
+  if (readonly_) {
+    throw py::value_error("message is read-only");
+  }
+  if (num_view_owners_ > 0u) {
+    // Resizing moves the items the views point to
+    throw py::buffer_error("loaned message can't be resized while views of it exist");
+  }
+  void * message = message_.get();
+  const auto * member = find_message_member(members_, path, &message);
+  if (!member->is_array_ || (member->array_size_ > 0u && !member->is_upper_bound_)) {
+    throw py::value_error("member '" + path + "' is not a sequence");
+  }
+  if (member->is_upper_bound_ && size > member->array_size_) {
+    throw py::value_error("size exceeds the bound of member '" + path + "'");
+  }
+  if (!member->resize_function(static_cast<uint8_t *>(message) + member->offset_, size)) {
+    throw std::bad_alloc();
+  }
+}
+
+void
+LoanedMessage::release()
+{
+  auto lock = lock_releasing_gil(mutex_);
+  if (num_view_owners_ > 0u) {
+    if (!readonly_) {
+      throw py::buffer_error("loaned message can't be released while views of it exist");
+    }
+    // The last view gone releases the message
+    release_requested_ = true;
+    return;
+  }
+  message_.reset();
+}
+
+LoanedMessage::Message
+LoanedMessage::detach()
+{
+  auto lock = lock_releasing_gil(mutex_);
+  if (!message_ || release_requested_) {
+    throw py::value_error("loaned message was already released");
+  }
+  if (num_view_owners_ > 0u) {
+    throw py::buffer_error("loaned message can't be published while views of it exist");
+  }
+  return std::move(message_);
+}
+
+void
+define_loaned_message(py::object module)
+{
+  py::class_<LoanedMessage, std::shared_ptr<LoanedMessage>>(module, "LoanedMessage")
+  .def_property_readonly(
+    "message", &LoanedMessage::get_message,
+    "Get the message converted to a Python message")
+  .def_property_readonly(
+    "is_loaned", &LoanedMessage::is_loaned,
+    "Whether the message is loaned from the middleware")
+  .def_property_readonly(
+    "released", &LoanedMessage::is_released,
+    "Whether the message was released")
+  .def(
+    "get_member_view", &LoanedMessage::get_member_view,
+    "Get a memoryview over a member of primitive type")
+  .def(
+    "resize_member", &LoanedMessage::resize_member,
+    "Resize a sequence member")
+  .def(
+    "release", &LoanedMessage::release,
+    "Release the message, returning the loan if it is loaned")
+  .def(
+    "__enter__", [](std::shared_ptr<LoanedMessage> message) {
+      return message;
+    })
+  .def(
+    "__exit__", [](LoanedMessage & message, py::object, py::object, py::object) {
+      message.release();
+    });
+}
+}  // namespace rclpy
@@ -0,0 +1,173 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLPY__LOANED_MESSAGE_HPP_
+#define RCLPY__LOANED_MESSAGE_HPP_
+
+#include <pybind11/pybind11.h>
+
+#include <rosidl_typesupport_introspection_c/message_introspection.h>
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "type_support.hpp"
+
+namespace py = pybind11;
+
+namespace rclpy
+{
+/// A C message that is only valid until it is released
+/**
+ * The message is usually loaned from the middleware, in which case the loan is returned when
+ * the message is released.
+ * When the middleware can't loan messages the message is owned by this instance instead.
+ *
+ * The message is converted to a Python message on demand.
+ * Members of primitive types can be accessed in place through memoryviews.
+ * Views keep the message alive. Releasing a read-only message only returns the loan once the
+ * last of its views is gone, while a writable message can't be released, resized or published
+ * as long as views of it exist.
+ */
+class LoanedMessage : public std::enable_shared_from_this<LoanedMessage>
+{
+public:
+  /// Function releasing the message, i.e. returning the loan or destroying it
+  using ReleaseFunction = std::function<void (void *)>;
+
+  /// A C message released when it is destroyed
+  using Message = std::unique_ptr<void, ReleaseFunction>;
+
+  /// Wrap a C message
+  /**
+   * \param[in] message C message, released with \p release_message
+   * \param[in] release_message Called with the message when this instance is released
+   * \param[in] type_support Type support of the message
+   * \param[in] loaned Whether the message is loaned from the middleware
+   * \param[in] readonly Whether buffers of the message are read-only
+   * \param[in] source The rcl entity the message belongs to
+   */
+  LoanedMessage(
+    void * message, ReleaseFunction release_message, const TypeSupportHandle & type_support,
+    bool loaned, bool readonly, const void * source);
+
+  /// Whether the message is loaned from the middleware
+  bool
+  is_loaned() const
+  {
+    return loaned_;
+  }
+
+  /// Whether the message was released
+  bool
+  is_released();
+
+  /// Get the message converted to a Python message
+  /**
+   * The primitive arrays of a read-only message are converted to read-only memoryviews over
+   * the C message, see convert_to_py_with_array_views(), the other members are copied.
+   * A writable message is fully copied, it is converted again on every call.
+   *
+   * Raises ValueError if the message was released
+   *
+   * \return an instance of the ROS message Python type
+   */
+  py::object
+  get_message();
+
+  /// Get a memoryview over a member of primitive type
+  /**
+   * Raises ValueError if the message was released
+   * Raises ValueError if there is no such member or if it is not of a primitive type
+   *
+   * \param[in] path The name of the member, members of nested messages are separated by dots
+   * \return A memoryview of the value, or of all the values of an array or sequence
+   */
+  py::memoryview
+  get_member_view(const std::string & path);
+
+  /// Resize a sequence member
+  /**
+   * Raises ValueError if the message was released or is loaned from the middleware
+   * Raises BufferError if views of the message exist
+   * Raises ValueError if there is no such member or if it is not a sequence
+   * Raises ValueError if the size exceeds the bound of the sequence
+   * Raises MemoryError if the sequence could not be resized
+   *
+   * \param[in] path The name of the member, members of nested messages are separated by dots
+   * \param[in] size The new size of the sequence
+   */
+  void
+  resize_member(const std::string & path, size_t size);
+
+  /// Release the message, nothing happens if it was already released
+  /**
+   * A read-only message with views is only released once the last of them is gone.
+   *
+   * Raises BufferError if views of a writable message exist
+   */
+  void
+  release();
+
+  /// Take ownership of the message, this instance is released afterwards
+  /**
+   * Raises ValueError if the message was released
+   * Raises BufferError if views of the message exist
+   *
+   * \return the C message
+   */
+  Message
+  detach();
+
+  /// Get the rcl entity the message belongs to
+  const void *
+  source() const
+  {
+    return source_;
+  }
+
+private:
+  /// Keeps the message alive, and from being released, while views of it exist
+  class ViewOwner;
+
+  /// Get an owner for new views of the message, the mutex must be held
+  std::shared_ptr<void>
+  make_view_owner();
+
+  /// Called when the last view of an owner is gone
+  void
+  end_view();
+
+  std::mutex mutex_;
+  Message message_;
+  size_t num_view_owners_ = 0u;
+  bool release_requested_ = false;
+  TypeSupportHandle type_support_;
+  const rosidl_typesupport_introspection_c__MessageMembers * members_;
+  bool loaned_;
+  bool readonly_;
+  const void * source_;
+};
+
+/// Define a pybind11 wrapper for an rclpy::LoanedMessage
+/**
+ * \param[in] module a pybind11 module to add the definition to
+ */
+void
+define_loaned_message(py::object module);
+}  // namespace rclpy
+
+#endif  // RCLPY__LOANED_MESSAGE_HPP_
@@ -0,0 +1,234 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <pybind11/pybind11.h>
+
+#include <rosidl_typesupport_introspection_c/field_types.h>
+#include <rosidl_typesupport_introspection_c/message_introspection.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "introspection.hpp"
+#include "member_buffer.hpp"
+#include "type_support.hpp"
+
+namespace rclpy
+{
+namespace
+{
+/// Layout shared by the C sequences of all types
+struct Sequence
+{
+  void * data;
+  size_t size;
+  size_t capacity;
+};
+
+bool
+is_sequence(const rosidl_typesupport_introspection_c__MessageMember & member)
+{
+  return member.is_array_ && (0u == member.array_size_ || member.is_upper_bound_);
+}
+
+const rosidl_typesupport_introspection_c__MessageMembers *
+get_nested_members(const rosidl_typesupport_introspection_c__MessageMember & member)
+{
+  return static_cast<const rosidl_typesupport_introspection_c__MessageMembers *>(
+    member.members_->data);
+}
+
+/// Whether arrays and sequences of a primitive type are held in a buffer by Python messages
+/**
+ * Fixed size arrays of these types are NumPy arrays and sequences are array.array, arrays and
+ * sequences of the other primitive types are lists.
+ */
+bool
+is_python_buffer_type(uint8_t type_id)
+{
+  switch (type_id) {
+    case rosidl_typesupport_introspection_c__ROS_TYPE_FLOAT:
+    case rosidl_typesupport_introspection_c__ROS_TYPE_DOUBLE:
+    case rosidl_typesupport_introspection_c__ROS_TYPE_INT8:
+    case rosidl_typesupport_introspection_c__ROS_TYPE_UINT8:
+    case rosidl_typesupport_introspection_c__ROS_TYPE_INT16:
+    case rosidl_typesupport_introspection_c__ROS_TYPE_UINT16:
+    case rosidl_typesupport_introspection_c__ROS_TYPE_INT32:
+    case rosidl_typesupport_introspection_c__ROS_TYPE_UINT32:
+    case rosidl_typesupport_introspection_c__ROS_TYPE_INT64:
+    case rosidl_typesupport_introspection_c__ROS_TYPE_UINT64:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/// Empty the primitive sequences of a message and of its nested messages
+/**
+ * Only the storage of the message itself is modified, i.e. nested messages held by sequences
+ * are left untouched and their primitive sequences are converted as usual.
+ */
+void
+empty_primitive_sequences(
+  void * message, const rosidl_typesupport_introspection_c__MessageMembers * members)
+{
+  for (uint32_t i = 0u; i < members->member_count_; ++i) {
+    const rosidl_typesupport_introspection_c__MessageMember & member = members->members_[i];
+    void * field = static_cast<uint8_t *>(message) + member.offset_;
+    if (rosidl_typesupport_introspection_c__ROS_TYPE_MESSAGE == member.type_id_) {
+      if (!member.is_array_) {
+        empty_primitive_sequences(field, get_nested_members(member));
+        continue;
+      }
+      if (is_sequence(member)) {
+        continue;
+      }
+      for (size_t j = 0u; j < member.array_size_; ++j) {
+        empty_primitive_sequences(member.get_function(field, j), get_nested_members(member));
+      }
+    } else if (is_sequence(member) && is_python_buffer_type(member.type_id_)) {
+      static_cast<Sequence *>(field)->size = 0u;
+    }
+  }
+}
+
+/// Get the items of a primitive member and the number of them
+void *
+get_primitive_items(
+  void * message, const rosidl_typesupport_introspection_c__MessageMember & member,
+  size_t * count)
+{
+  void * field = static_cast<uint8_t *>(message) + member.offset_;
+  if (!member.is_array_) {
+    *count = 1u;
+    return field;
+  }
+  *count = member.size_function(field);
+  // Empty sequences may not have any storage, point to the sequence itself instead
+  return *count > 0u ? member.get_function(field, 0u) : field;
+}
+
+/// Set the primitive arrays of a Python message and of its nested messages to views
+void
+set_array_views(
+  void * message, const rosidl_typesupport_introspection_c__MessageMembers * members,
+  py::handle pymsg, const std::shared_ptr<void> & owner)
+{
+  for (uint32_t i = 0u; i < members->member_count_; ++i) {
+    const rosidl_typesupport_introspection_c__MessageMember & member = members->members_[i];
+    if (!member.is_array_ &&
+      rosidl_typesupport_introspection_c__ROS_TYPE_MESSAGE != member.type_id_)
+    {
+      continue;
+    }
+    void * field = static_cast<uint8_t *>(message) + member.offset_;
+    // Set the slots directly, the property setters would copy the views
+    const std::string slot = std::string("_") + member.name_;
+    const char * format = nullptr;
+    size_t itemsize = 0u;
+    if (rosidl_typesupport_introspection_c__ROS_TYPE_MESSAGE == member.type_id_) {
+      py::object pyfield = pymsg.attr(slot.c_str());
+      if (!member.is_array_) {
+        set_array_views(field, get_nested_members(member), pyfield, owner);
+        continue;
+      }
+      const size_t count = member.size_function(field);
+      for (size_t j = 0u; j < count; ++j) {
+        set_array_views(
+          member.get_function(field, j), get_nested_members(member), pyfield[py::int_(j)], owner);
+      }
+    } else if (is_python_buffer_type(member.type_id_) &&
+      get_primitive_format(member.type_id_, &format, &itemsize))
+    {
+      size_t count = 0u;
+      void * data = get_primitive_items(message, member, &count);
+      auto buffer = std::make_shared<MemberBuffer>(owner, data, format, itemsize, count);
+      py::memoryview view(py::cast(buffer));
+      if (is_sequence(member)) {
+        pymsg.attr(slot.c_str()) = view;
+      } else {
+        // The generated conversion and comparison of fixed size arrays expect NumPy arrays
+        py::object pyfield = pymsg.attr(slot.c_str());
+        pymsg.attr(slot.c_str()) =
+          py::module::import("numpy").attr("frombuffer")(view, pyfield.attr("dtype"));
+      }
+    }
+  }
+}
+}  // namespace
+
+MemberBuffer::MemberBuffer(
+  std::shared_ptr<void> message, void * data, const char * format, size_t itemsize,
+  size_t count, bool readonly)
+: message_(std::move(message)), data_(data), format_(format), itemsize_(itemsize),
+  count_(count), readonly_(readonly)
+{
+}
+
+py::buffer_info
+MemberBuffer::get_buffer() const
+{
+  return py::buffer_info(
+    data_, static_cast<py::ssize_t>(itemsize_), format_, 1,
+    {static_cast<py::ssize_t>(count_)}, {static_cast<py::ssize_t>(itemsize_)}, readonly_);
+}
+
+py::object
+convert_to_py_with_array_views(
+  const TypeSupportHandle & type_support,
+  const rosidl_typesupport_introspection_c__MessageMembers * members,
+  std::shared_ptr<void> message)
+{
+  // Convert a shallow copy whose primitive sequences are empty to skip copying their items,
+  // the C message itself may be in read-only memory of the middleware
+  std::vector<std::max_align_t> copy(
+    (members->size_of_ + sizeof(std::max_align_t) - 1u) / sizeof(std::max_align_t));
+  std::memcpy(copy.data(), message.get(), members->size_of_);
+  empty_primitive_sequences(copy.data(), members);
+  py::object pymsg = type_support.convert_to_py(copy.data());
+  set_array_views(message.get(), members, pymsg, message);
+  return pymsg;
+}
+
+py::memoryview
+get_member_view(
+  std::shared_ptr<void> owner, void * message,
+  const rosidl_typesupport_introspection_c__MessageMember * member, bool readonly)
+{
+  const char * format = nullptr;
+  size_t itemsize = 0u;
+  if (!get_primitive_format(member->type_id_, &format, &itemsize)) {
+    throw py::value_error(
+            std::string("member '") + member->name_ + "' is not of a primitive type");
+  }
+  size_t count = 0u;
+  void * data = get_primitive_items(message, *member, &count);
+  auto buffer = std::make_shared<MemberBuffer>(
+    std::move(owner), data, format, itemsize, count, readonly);
+  return py::memoryview(py::cast(buffer));
+}
+
+void
+define_member_buffer(py::object module)
+{
+  py::class_<MemberBuffer, std::shared_ptr<MemberBuffer>>(
+    module, "MemberBuffer", py::buffer_protocol())
+  .def_buffer(&MemberBuffer::get_buffer);
+}
+}  // namespace rclpy
@@ -0,0 +1,114 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLPY__MEMBER_BUFFER_HPP_
+#define RCLPY__MEMBER_BUFFER_HPP_
+
+#include <pybind11/pybind11.h>
+
+#include <rosidl_typesupport_introspection_c/message_introspection.h>
+
+#include <memory>
+
+#include "type_support.hpp"
+
+namespace py = pybind11;
+
+namespace rclpy
+{
+/// The items of a primitive array or sequence member of a C message
+/**
+ * The items are exposed through the buffer protocol, read-only unless requested otherwise.
+ * The C message is kept alive as long as the buffer or any view of it is.
+ */
+class MemberBuffer
+{
+public:
+  /// Create a buffer over the items of a member
+  /**
+   * \param[in] message The C message holding the member
+   * \param[in] data The first item of the member
+   * \param[in] format The buffer protocol format of the items
+   * \param[in] itemsize The size of an item
+   * \param[in] count The number of items
+   * \param[in] readonly Whether the items are exposed read-only
+   */
+  MemberBuffer(
+    std::shared_ptr<void> message, void * data, const char * format, size_t itemsize,
+    size_t count, bool readonly = true);
+
+  /// Get the buffer over the items
+  py::buffer_info
+  get_buffer() const;
+
+private:
+  std::shared_ptr<void> message_;
+  void * data_;
+  const char * format_;
+  size_t itemsize_;
+  size_t count_;
+  bool readonly_;
+};
+
+/// Convert a C message to a Python message whose primitive arrays are views of the C message
+/**
+ * Members that are sequences of a numeric type, including the ones of nested messages, are set
+ * to read-only memoryviews over the items in the C message and the ones that are fixed size
+ * arrays of a numeric type to read-only NumPy arrays over them, instead of holding converted
+ * copies of them.
+ * Arrays and sequences of the other primitive types are lists and are converted as usual.
+ * Sequences are not converted at all, fixed size arrays and the sequences of nested messages
+ * held by sequences are converted before being replaced.
+ * The C message is only read, the views keep it alive.
+ *
+ * Raises any exception raised by the conversion
+ *
+ * \param[in] type_support The type support of the message
+ * \param[in] members The members of the message
+ * \param[in] message The C message to convert, it must not be modified afterwards
+ * \return The Python message
+ */
+py::object
+convert_to_py_with_array_views(
+  const TypeSupportHandle & type_support,
+  const rosidl_typesupport_introspection_c__MessageMembers * members,
+  std::shared_ptr<void> message);
+
+/// Get a memoryview over the value of a member of primitive type
+/**
+ * Single values are exposed as a view of one item, arrays as a view of all of their items and
+ * sequences as a view of their current items.
+ *
+ * Raises ValueError if the member is not of a primitive type
+ *
+ * \param[in] owner Kept alive by the view, it must keep the C message alive
+ * \param[in] message The C message holding the member
+ * \param[in] member The member of the message
+ * \param[in] readonly Whether the view is read-only
+ * \return The memoryview
+ */
+py::memoryview
+get_member_view(
+  std::shared_ptr<void> owner, void * message,
+  const rosidl_typesupport_introspection_c__MessageMember * member, bool readonly);
+
+/// Define a pybind11 wrapper for an rclpy::MemberBuffer
+/**
+ * \param[in] module a pybind11 module to add the definition to
+ */
+void
+define_member_buffer(py::object module);
+}  // namespace rclpy
+
+#endif  // RCLPY__MEMBER_BUFFER_HPP_
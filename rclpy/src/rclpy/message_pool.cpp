@@ -0,0 +1,153 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <pybind11/pybind11.h>
+
+#include <rosidl_typesupport_introspection_c/field_types.h>
+#include <rosidl_typesupport_introspection_c/message_introspection.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+
+#include "introspection.hpp"
+#include "message_pool.hpp"
+#include "type_support.hpp"
+
+namespace rclpy
+{
+namespace
+{
+const rosidl_typesupport_introspection_c__MessageMembers *
+get_nested_members(const rosidl_typesupport_introspection_c__MessageMember & member)
+{
+  return static_cast<const rosidl_typesupport_introspection_c__MessageMembers *>(
+    member.members_->data);
+}
+
+bool
+is_sequence(const rosidl_typesupport_introspection_c__MessageMember & member)
+{
+  return member.is_array_ && (0u == member.array_size_ || member.is_upper_bound_);
+}
+
+/// Whether a message or its nested messages have sequence members
+bool
+has_sequences(const rosidl_typesupport_introspection_c__MessageMembers * members)
+{
+  for (uint32_t i = 0u; i < members->member_count_; ++i) {
+    const rosidl_typesupport_introspection_c__MessageMember & member = members->members_[i];
+    if (is_sequence(member)) {
+      return true;
+    }
+    if (rosidl_typesupport_introspection_c__ROS_TYPE_MESSAGE == member.type_id_ &&
+      has_sequences(get_nested_members(member)))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+/// Empty the sequences of a message and of its nested messages, freeing their storage
+void
+clear_sequences(
+  void * message, const rosidl_typesupport_introspection_c__MessageMembers * members)
+{
+  for (uint32_t i = 0u; i < members->member_count_; ++i) {
+    const rosidl_typesupport_introspection_c__MessageMember & member = members->members_[i];
+    void * field = static_cast<uint8_t *>(message) + member.offset_;
+    if (is_sequence(member)) {
+      // Resizing to zero finalizes the items and frees the storage, it can't fail
+      member.resize_function(field, 0u);
+    } else if (rosidl_typesupport_introspection_c__ROS_TYPE_MESSAGE == member.type_id_) {
+      const size_t count = member.is_array_ ? member.array_size_ : 1u;
+      for (size_t j = 0u; j < count; ++j) {
+        void * nested = member.is_array_ ? member.get_function(field, j) : field;
+        clear_sequences(nested, get_nested_members(member));
+      }
+    }
+  }
+}
+}  // namespace
+
+MessagePool::MessagePool(const TypeSupportHandle & type_support)
+: create_ros_message_(type_support.create_function()),
+  destroy_ros_message_(type_support.destroy_function())
+{
+  // Without introspection type support messages are not reused, which is correct but slower
+  try {
+    members_ = get_message_members(type_support.pymsg_type());
+  } catch (const py::error_already_set &) {
+    members_ = nullptr;
+  } catch (const std::runtime_error &) {
+    members_ = nullptr;
+  }
+  has_sequences_ = members_ && has_sequences(members_);
+}
+
+MessagePool::~MessagePool()
+{
+  for (void * message : messages_) {
+    destroy_ros_message_(message);
+  }
+}
+
+MessagePool::Message
+MessagePool::acquire()
+{
+  void * message = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!messages_.empty()) {
+      message = messages_.back();
+      messages_.pop_back();
+    }
+  }
+  if (!message) {
+    message = create_ros_message_();
+    if (!message) {
+      throw std::bad_alloc();
+    }
+  }
+  return Message(message, GiveBack{shared_from_this()});
+}
+
+size_t
+MessagePool::size() const
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return messages_.size();
+}
+
+void
+MessagePool::give_back(void * message)
+{
+  if (!members_) {
+    destroy_ros_message_(message);
+    return;
+  }
+  if (has_sequences_) {
+    clear_sequences(message, members_);
+  }
+  try {
+    std::lock_guard<std::mutex> lock(mutex_);
+    messages_.push_back(message);
+  } catch (const std::bad_alloc &) {
+    destroy_ros_message_(message);
+  }
+}
+}  // namespace rclpy
@@ -0,0 +1,112 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLPY__MESSAGE_POOL_HPP_
+#define RCLPY__MESSAGE_POOL_HPP_
+
+#include <rosidl_typesupport_introspection_c/message_introspection.h>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "type_support.hpp"
+
+namespace rclpy
+{
+/// A pool of C messages of one type reused across publishes and takes
+/**
+ * Creating a C message allocates it and initializes all of its members, destroying it
+ * finalizes and frees them, which for messages with strings and sequences means many
+ * allocations per message.
+ * Messages acquired from the pool are given back to it instead of being destroyed, so an
+ * entity allocates as many messages as it uses concurrently rather than one per message.
+ *
+ * Messages are not fully reset when given back: publishing converts every member of the
+ * Python message into the C message and taking deserializes every member, so whatever the
+ * previous use left is overwritten.
+ * Sequence storage is not reused though, its capacity is lost between uses: the conversion
+ * from Python initializes sequences without finalizing them and the deserialization of the
+ * rmw implementations finalizes and initializes them again, both allocating new storage
+ * whatever the previous use left.
+ * So the sequences of a message, including the ones of its nested messages, are emptied and
+ * their storage freed when it is given back, as the conversion would leak it otherwise.
+ * Memory held by strings is kept until it is overwritten.
+ * If the layout of the messages is unknown, i.e. the type has no introspection type support,
+ * messages are destroyed when given back instead.
+ *
+ * The pool is thread safe and doesn't need the GIL.
+ */
+class MessagePool : public std::enable_shared_from_this<MessagePool>
+{
+  struct GiveBack
+  {
+    std::shared_ptr<MessagePool> pool;
+
+    void
+    operator()(void * message) const
+    {
+      pool->give_back(message);
+    }
+  };
+
+public:
+  /// A message acquired from the pool, given back when it is released
+  using Message = std::unique_ptr<void, GiveBack>;
+
+  /// Create an empty pool of messages of a type
+  /**
+   * The GIL must be held.
+   *
+   * \param[in] type_support Type support of the messages
+   */
+  explicit MessagePool(const TypeSupportHandle & type_support);
+
+  /// Destroy the messages in the pool
+  ~MessagePool();
+
+  MessagePool(const MessagePool &) = delete;
+  MessagePool & operator=(const MessagePool &) = delete;
+
+  /// Get a message from the pool, or create one if the pool is empty
+  /**
+   * The pool must be owned by a std::shared_ptr.
+   *
+   * Raises MemoryError if a message cannot be allocated
+   *
+   * \return A message holding the contents of its previous use, if any
+   */
+  Message
+  acquire();
+
+  /// Get the number of messages waiting in the pool to be reused
+  size_t
+  size() const;
+
+private:
+  void
+  give_back(void * message);
+
+  create_ros_message_function * create_ros_message_;
+  destroy_ros_message_function * destroy_ros_message_;
+  /// Members of the messages, or nullptr if they are not known
+  const rosidl_typesupport_introspection_c__MessageMembers * members_ = nullptr;
+  /// Whether the messages hold sequences to be emptied when they are given back
+  bool has_sequences_ = false;
+  mutable std::mutex mutex_;
+  std::vector<void *> messages_;
+};
+}  // namespace rclpy
+
+#endif  // RCLPY__MESSAGE_POOL_HPP_
@@ -0,0 +1,542 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <pybind11/pybind11.h>
+
+#include <rcl/wait.h>
+
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "exceptions.hpp"
+#include "multi_threaded_executor_core.hpp"
+
+namespace rclpy
+{
+MultiThreadedExecutorCore::MultiThreadedExecutorCore(
+  std::shared_ptr<WaitSet> wait_set, std::shared_ptr<GuardCondition> wake_gc,
+  size_t num_threads)
+: wait_set_(wait_set), wake_gc_(wake_gc)
+{
+  if (0u == num_threads) {
+    throw py::value_error("the number of threads must be positive");
+  }
+  // The workers trigger it, don't let it be destroyed before they are joined
+  wake_gc_->enter();
+  // The threads are started once the core is owned by a std::shared_ptr
+  for (size_t i = 0u; i < num_threads; ++i) {
+    workers_.push_back(std::make_unique<Worker>());
+  }
+}
+
+MultiThreadedExecutorCore::~MultiThreadedExecutorCore()
+{
+  destroy();
+}
+
+void
+MultiThreadedExecutorCore::add_entry(
+  uint64_t id, EntityKind kind, std::shared_ptr<Destroyable> entity, py::object handler,
+  std::shared_ptr<CallbackGroupState> group)
+{
+  if (entity) {
+    // Block destruction of the entity for as long as it is registered
+    entity->enter();
+  }
+  std::lock_guard<std::mutex> lock(entries_mutex_);
+  if (entries_.count(id)) {
+    if (entity) {
+      entity->exit(py::none(), py::none(), py::none());
+    }
+    throw py::value_error("identifier " + std::to_string(id) + " is already used");
+  }
+
+  auto entry = std::make_shared<Entry>();
+  entry->id = id;
+  entry->kind = kind;
+  entry->entity = std::move(entity);
+  entry->handler = std::move(handler);
+  entry->group = std::move(group);
+  entries_.emplace(id, std::move(entry));
+}
+
+void
+MultiThreadedExecutorCore::add_subscription(
+  std::shared_ptr<Subscription> subscription, uint64_t id, py::object handler,
+  std::shared_ptr<CallbackGroupState> group)
+{
+  add_entry(id, EntityKind::Subscription, subscription, handler, group);
+}
+
+void
+MultiThreadedExecutorCore::add_timer(
+  std::shared_ptr<Timer> timer, uint64_t id, py::object handler,
+  std::shared_ptr<CallbackGroupState> group)
+{
+  add_entry(id, EntityKind::Timer, timer, handler, group);
+}
+
+void
+MultiThreadedExecutorCore::add_guard_condition(
+  std::shared_ptr<GuardCondition> gc, uint64_t id, py::object handler,
+  std::shared_ptr<CallbackGroupState> group)
+{
+  add_entry(id, EntityKind::GuardCondition, gc, handler, group);
+}
+
+void
+MultiThreadedExecutorCore::add_service(
+  std::shared_ptr<Service> service, uint64_t id, py::object handler,
+  std::shared_ptr<CallbackGroupState> group)
+{
+  add_entry(id, EntityKind::Service, service, handler, group);
+}
+
+void
+MultiThreadedExecutorCore::add_client(
+  std::shared_ptr<Client> client, uint64_t id, py::object handler,
+  std::shared_ptr<CallbackGroupState> group)
+{
+  add_entry(id, EntityKind::Client, client, handler, group);
+}
+
+void
+MultiThreadedExecutorCore::add_external(
+  uint64_t id, py::object handler, std::shared_ptr<CallbackGroupState> group)
+{
+  add_entry(id, EntityKind::External, nullptr, handler, group);
+}
+
+void
+MultiThreadedExecutorCore::remove(uint64_t id)
+{
+  std::shared_ptr<Entry> entry;
+  {
+    std::lock_guard<std::mutex> lock(entries_mutex_);
+    auto it = entries_.find(id);
+    if (entries_.end() == it) {
+      return;
+    }
+    entry = std::move(it->second);
+    entries_.erase(it);
+  }
+  // A queued execution is skipped, the worker still ends it
+  entry->removed = true;
+  if (entry->entity) {
+    entry->entity->exit(py::none(), py::none(), py::none());
+  }
+}
+
+bool
+MultiThreadedExecutorCore::is_idle(const Entry & entry)
+{
+  return !entry.removed && !entry.scheduled && (!entry.group || entry.group->can_execute());
+}
+
+void
+MultiThreadedExecutorCore::prepare_wait()
+{
+  waited_subscriptions_.clear();
+  waited_timers_.clear();
+  waited_guard_conditions_.clear();
+  waited_services_.clear();
+  waited_clients_.clear();
+  wait_set_->clear_entities();
+
+  std::lock_guard<std::mutex> lock(entries_mutex_);
+  for (const auto & id_and_entry : entries_) {
+    const std::shared_ptr<Entry> & entry = id_and_entry.second;
+    if (!is_idle(*entry)) {
+      // Waking up for it would be useless until it may be executed again
+      continue;
+    }
+    switch (entry->kind) {
+      case EntityKind::Subscription:
+        wait_set_->add_subscription(*std::static_pointer_cast<Subscription>(entry->entity));
+        waited_subscriptions_.push_back(entry);
+        break;
+      case EntityKind::Timer:
+        wait_set_->add_timer(*std::static_pointer_cast<Timer>(entry->entity));
+        waited_timers_.push_back(entry);
+        break;
+      case EntityKind::GuardCondition:
+        wait_set_->add_guard_condition(*std::static_pointer_cast<GuardCondition>(entry->entity));
+        waited_guard_conditions_.push_back(entry);
+        break;
+      case EntityKind::Service:
+        wait_set_->add_service(*std::static_pointer_cast<Service>(entry->entity));
+        waited_services_.push_back(entry);
+        break;
+      case EntityKind::Client:
+        wait_set_->add_client(*std::static_pointer_cast<Client>(entry->entity));
+        waited_clients_.push_back(entry);
+        break;
+      case EntityKind::External:
+        break;
+    }
+  }
+}
+
+void
+MultiThreadedExecutorCore::start_workers()
+{
+  std::call_once(
+    start_flag_, [this]() {
+      if (stopping_) {
+        return;
+      }
+      // Each worker keeps the core alive until it returns, destroy() may be called from a
+      // callable, after which the core may be released while the worker still runs
+      std::shared_ptr<MultiThreadedExecutorCore> self = shared_from_this();
+      for (size_t i = 0u; i < workers_.size(); ++i) {
+        threads_.emplace_back([self, i]() {self->run_worker(i);});
+      }
+    });
+}
+
+size_t
+MultiThreadedExecutorCore::wait_and_schedule(int64_t timeout_ns)
+{
+  start_workers();
+  {
+    std::lock_guard<std::mutex> lock(error_mutex_);
+    if (error_) {
+      std::exception_ptr error = error_;
+      error_ = nullptr;
+      std::rethrow_exception(error);
+    }
+  }
+
+  // Releases the GIL while waiting
+  wait_set_->wait(timeout_ns);
+
+  const rcl_wait_set_t * wait_set = wait_set_->rcl_ptr();
+  size_t num_scheduled = 0u;
+  for (size_t i = 0u; i < waited_timers_.size(); ++i) {
+    // Check timer is ready to workaround rcl issue with cancelled timers
+    if (wait_set->timers[i] &&
+      std::static_pointer_cast<Timer>(waited_timers_[i]->entity)->is_timer_ready())
+    {
+      num_scheduled += try_schedule(waited_timers_[i]);
+    }
+  }
+  for (size_t i = 0u; i < waited_subscriptions_.size(); ++i) {
+    if (wait_set->subscriptions[i]) {
+      num_scheduled += try_schedule(waited_subscriptions_[i]);
+    }
+  }
+  for (size_t i = 0u; i < waited_guard_conditions_.size(); ++i) {
+    // Guard conditions without a handler only wake up the wait
+    if (wait_set->guard_conditions[i] && !waited_guard_conditions_[i]->handler.is_none()) {
+      num_scheduled += try_schedule(waited_guard_conditions_[i]);
+    }
+  }
+  for (size_t i = 0u; i < waited_clients_.size(); ++i) {
+    if (wait_set->clients[i]) {
+      num_scheduled += try_schedule(waited_clients_[i]);
+    }
+  }
+  for (size_t i = 0u; i < waited_services_.size(); ++i) {
+    if (wait_set->services[i]) {
+      num_scheduled += try_schedule(waited_services_[i]);
+    }
+  }
+  return num_scheduled;
+}
+
+bool
+MultiThreadedExecutorCore::can_schedule(uint64_t id)
+{
+  std::lock_guard<std::mutex> lock(entries_mutex_);
+  auto it = entries_.find(id);
+  return entries_.end() != it && is_idle(*it->second);
+}
+
+bool
+MultiThreadedExecutorCore::schedule(uint64_t id)
+{
+  std::shared_ptr<Entry> entry;
+  {
+    std::lock_guard<std::mutex> lock(entries_mutex_);
+    auto it = entries_.find(id);
+    if (entries_.end() == it) {
+      return false;
+    }
+    entry = it->second;
+  }
+  start_workers();
+  return try_schedule(entry);
+}
+
+bool
+MultiThreadedExecutorCore::try_schedule(const std::shared_ptr<Entry> & entry)
+{
+  if (entry->removed || workers_.empty()) {
+    return false;
+  }
+  bool expected = false;
+  if (!entry->scheduled.compare_exchange_strong(expected, true)) {
+    return false;
+  }
+  if (entry->group && !entry->group->beginning_execution(get_token(*entry))) {
+    // Another entity of the group got executed first
+    entry->scheduled = false;
+    return false;
+  }
+
+  Worker & worker = *workers_[next_worker_];
+  next_worker_ = (next_worker_ + 1u) % workers_.size();
+  {
+    // Counted under the lock, so a worker can't miss it right before sleeping, and before it
+    // is queued, so a worker popping it can't count it out first
+    std::lock_guard<std::mutex> sleep_lock(sleep_mutex_);
+    ++queued_;
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    worker.queue.push_back(entry);
+  }
+  sleep_condition_.notify_one();
+  return true;
+}
+
+void
+MultiThreadedExecutorCore::end_execution(uint64_t id)
+{
+  std::shared_ptr<Entry> entry;
+  {
+    std::lock_guard<std::mutex> lock(entries_mutex_);
+    auto it = asynchronous_entries_.find(id);
+    if (asynchronous_entries_.end() == it) {
+      return;
+    }
+    entry = std::move(it->second);
+    asynchronous_entries_.erase(it);
+  }
+  finish(*entry);
+}
+
+uintptr_t
+MultiThreadedExecutorCore::get_token(const Entry & entry)
+{
+  return reinterpret_cast<uintptr_t>(&entry);
+}
+
+void
+MultiThreadedExecutorCore::release(Entry & entry)
+{
+  if (entry.group) {
+    entry.group->ending_execution(get_token(entry));
+  }
+  entry.scheduled = false;
+}
+
+void
+MultiThreadedExecutorCore::finish(Entry & entry)
+{
+  release(entry);
+  if (stopping_) {
+    // Ended after destroy() was called, e.g. by the callable, nothing is waited on anymore
+    return;
+  }
+  // The entity and the other ones of its group may be waited on again
+  try {
+    wake_gc_->trigger_guard_condition();
+  } catch (const RCLError &) {
+    // The context was shut down, so nothing waits anymore
+  }
+}
+
+std::shared_ptr<MultiThreadedExecutorCore::Entry>
+MultiThreadedExecutorCore::pop(size_t worker_index)
+{
+  std::shared_ptr<Entry> entry;
+  {
+    Worker & worker = *workers_[worker_index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (!worker.queue.empty()) {
+      entry = std::move(worker.queue.front());
+      worker.queue.pop_front();
+    }
+  }
+  // Steal from the other end of the queues of the other workers
+  for (size_t i = 1u; !entry && i < workers_.size(); ++i) {
+    Worker & victim = *workers_[(worker_index + i) % workers_.size()];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.queue.empty()) {
+      entry = std::move(victim.queue.back());
+      victim.queue.pop_back();
+    }
+  }
+  if (entry) {
+    --queued_;
+  }
+  return entry;
+}
+
+void
+MultiThreadedExecutorCore::run_worker(size_t worker_index)
+{
+  while (!stopping_) {
+    std::shared_ptr<Entry> entry = pop(worker_index);
+    if (!entry) {
+      std::unique_lock<std::mutex> lock(sleep_mutex_);
+      sleep_condition_.wait(lock, [this]() {return stopping_ || queued_ > 0u;});
+      continue;
+    }
+
+    py::gil_scoped_acquire gil_acquire;
+    bool ended = true;
+    if (!entry->removed) {
+      try {
+        ended = entry->handler().cast<bool>();
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(error_mutex_);
+        if (!error_) {
+          error_ = std::current_exception();
+        }
+      }
+    }
+    if (!ended) {
+      std::lock_guard<std::mutex> lock(entries_mutex_);
+      if (stopping_) {
+        // destroy() may be past releasing the asynchronous executions, e.g. if the callable
+        // called it
+        ended = true;
+      } else {
+        asynchronous_entries_.emplace(entry->id, entry);
+      }
+    }
+    if (ended) {
+      finish(*entry);
+    }
+    // Drop the reference to the handler while holding the GIL
+    entry.reset();
+  }
+}
+
+void
+MultiThreadedExecutorCore::destroy()
+{
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    stopping_ = true;
+  }
+  sleep_condition_.notify_all();
+  if (!threads_.empty()) {
+    // The workers need the GIL to return from the callable they are executing
+    py::gil_scoped_release gil_release;
+    for (std::thread & thread : threads_) {
+      if (thread.get_id() == std::this_thread::get_id()) {
+        // Destroyed from a callable, the worker stops once it returned, keeping the core alive
+        thread.detach();
+      } else {
+        thread.join();
+      }
+    }
+  }
+  threads_.clear();
+
+  // Executions that did not start or end are abandoned, don't keep their callback groups busy
+  std::vector<std::shared_ptr<Entry>> unfinished;
+  for (auto & worker : workers_) {
+    unfinished.insert(unfinished.end(), worker->queue.begin(), worker->queue.end());
+    worker->queue.clear();
+  }
+  waited_subscriptions_.clear();
+  waited_timers_.clear();
+  waited_guard_conditions_.clear();
+  waited_services_.clear();
+  waited_clients_.clear();
+  std::unordered_map<uint64_t, std::shared_ptr<Entry>> entries;
+  {
+    std::lock_guard<std::mutex> lock(entries_mutex_);
+    entries.swap(entries_);
+    for (auto & id_and_entry : asynchronous_entries_) {
+      unfinished.push_back(std::move(id_and_entry.second));
+    }
+    asynchronous_entries_.clear();
+  }
+  for (auto & entry : unfinished) {
+    release(*entry);
+  }
+  for (auto & id_and_entry : entries) {
+    id_and_entry.second->removed = true;
+    if (id_and_entry.second->entity) {
+      id_and_entry.second->entity->exit(py::none(), py::none(), py::none());
+    }
+  }
+  if (wake_gc_) {
+    wake_gc_->exit(py::none(), py::none(), py::none());
+    wake_gc_.reset();
+  }
+  wait_set_.reset();
+}
+
+void
+define_multi_threaded_executor_core(py::object module)
+{
+  py::class_<MultiThreadedExecutorCore, Destroyable, std::shared_ptr<MultiThreadedExecutorCore>>(
+    module, "MultiThreadedExecutorCore")
+  .def(
+    py::init<std::shared_ptr<WaitSet>, std::shared_ptr<GuardCondition>, size_t>(),
+    py::arg("wait_set"), py::arg("wake_gc"), py::arg("num_threads"))
+  .def(
+    "add_subscription", &MultiThreadedExecutorCore::add_subscription,
+    "Register a subscription and the callable executing it",
+    py::arg("subscription"), py::arg("id"), py::arg("handler"), py::arg("group"))
+  .def(
+    "add_timer", &MultiThreadedExecutorCore::add_timer,
+    "Register a timer and the callable executing it",
+    py::arg("timer"), py::arg("id"), py::arg("handler"), py::arg("group"))
+  .def(
+    "add_guard_condition", &MultiThreadedExecutorCore::add_guard_condition,
+    "Register a guard condition and the callable executing it",
+    py::arg("gc"), py::arg("id"), py::arg("handler"), py::arg("group"))
+  .def(
+    "add_service", &MultiThreadedExecutorCore::add_service,
+    "Register a service and the callable executing it",
+    py::arg("service"), py::arg("id"), py::arg("handler"), py::arg("group"))
+  .def(
+    "add_client", &MultiThreadedExecutorCore::add_client,
+    "Register a client and the callable executing it",
+    py::arg("client"), py::arg("id"), py::arg("handler"), py::arg("group"))
+  .def(
+    "add_external", &MultiThreadedExecutorCore::add_external,
+    "Register the callable executing an entity the caller waits on",
+    py::arg("id"), py::arg("handler"), py::arg("group"))
+  .def(
+    "remove", &MultiThreadedExecutorCore::remove,
+    "Forget an entity")
+  .def(
+    "prepare_wait", &MultiThreadedExecutorCore::prepare_wait,
+    "Clear the wait set and add the registered entities which may be executed to it")
+  .def(
+    "wait_and_schedule", &MultiThreadedExecutorCore::wait_and_schedule,
+    "Wait on the wait set and queue the ready entities to the workers")
+  .def(
+    "can_schedule", &MultiThreadedExecutorCore::can_schedule,
+    "Whether an entity is neither queued nor executing and its callback group is free")
+  .def(
+    "schedule", &MultiThreadedExecutorCore::schedule,
+    "Queue an entity registered with add_external() to the workers")
+  .def(
+    "end_execution", &MultiThreadedExecutorCore::end_execution,
+    "End an execution whose callable returned False");
+}
+}  // namespace rclpy
@@ -0,0 +1,311 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLPY__MULTI_THREADED_EXECUTOR_CORE_HPP_
+#define RCLPY__MULTI_THREADED_EXECUTOR_CORE_HPP_
+
+#include <pybind11/pybind11.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "callback_group.hpp"
+#include "client.hpp"
+#include "destroyable.hpp"
+#include "guard_condition.hpp"
+#include "service.hpp"
+#include "subscription.hpp"
+#include "timer.hpp"
+#include "wait_set.hpp"
+
+namespace py = pybind11;
+
+namespace rclpy
+{
+/// Execute the callbacks of ready entities in a pool of native worker threads
+/**
+ * Entities are registered with an identifier chosen by the caller, the Python callable
+ * executing them and the callback group they belong to.
+ * The thread calling wait_and_schedule() waits on a wait set holding the entities that may be
+ * executed and queues the ready ones to the workers.
+ * Each worker has its own queue, and steals from the queues of the other workers when its own
+ * is empty.
+ * Workers only hold the GIL to call the Python callables, which take the data of their entity
+ * and run its callback.
+ *
+ * An entity is left out of the wait set from when it is queued until its callable returned,
+ * and so are the entities of a mutually exclusive callback group while one of them is
+ * executing.
+ * The core claims the callback group of an entity when queuing it and releases it once the
+ * execution ended, through the same state the Python callback group uses.
+ */
+class MultiThreadedExecutorCore
+  : public Destroyable, public std::enable_shared_from_this<MultiThreadedExecutorCore>
+{
+public:
+  /// Create an executor core
+  /**
+   * The worker threads are started by the first call to wait_and_schedule() or schedule().
+   *
+   * \param[in] wait_set The wait set to wait on, entities are added to it on every wait
+   * \param[in] wake_gc Triggered by the workers when an entity may be waited on again
+   * \param[in] num_threads The number of worker threads
+   */
+  MultiThreadedExecutorCore(
+    std::shared_ptr<WaitSet> wait_set, std::shared_ptr<GuardCondition> wake_gc,
+    size_t num_threads);
+
+  ~MultiThreadedExecutorCore();
+
+  /// Register a subscription and the callable executing it
+  /**
+   * The callable is called without arguments in a worker thread.
+   * It returns True once the execution ended, or False if it goes on asynchronously, in which
+   * case end_execution() must be called when it ends.
+   *
+   * Raises InvalidHandle if the subscription is being destroyed
+   * Raises ValueError if the identifier is already used
+   *
+   * \param[in] subscription The subscription to register
+   * \param[in] id The identifier of the entity
+   * \param[in] handler The callable executing the entity
+   * \param[in] group The state of the callback group of the entity, or None to execute the
+   *   entity regardless of the other ones
+   */
+  void
+  add_subscription(
+    std::shared_ptr<Subscription> subscription, uint64_t id, py::object handler,
+    std::shared_ptr<CallbackGroupState> group);
+
+  /// Register a timer and the callable executing it
+  /**
+   * The timer is only executed if it is still ready after the wait, so canceled timers are
+   * skipped, and the callable must call it.
+   *
+   * \sa add_subscription()
+   */
+  void
+  add_timer(
+    std::shared_ptr<Timer> timer, uint64_t id, py::object handler,
+    std::shared_ptr<CallbackGroupState> group);
+
+  /// Register a guard condition and the callable executing it
+  /**
+   * If the callable is None the guard condition only wakes up the wait.
+   *
+   * \sa add_subscription()
+   */
+  void
+  add_guard_condition(
+    std::shared_ptr<GuardCondition> gc, uint64_t id, py::object handler,
+    std::shared_ptr<CallbackGroupState> group);
+
+  /// Register a service and the callable executing it
+  /**
+   * \sa add_subscription()
+   */
+  void
+  add_service(
+    std::shared_ptr<Service> service, uint64_t id, py::object handler,
+    std::shared_ptr<CallbackGroupState> group);
+
+  /// Register a client and the callable executing it
+  /**
+   * \sa add_subscription()
+   */
+  void
+  add_client(
+    std::shared_ptr<Client> client, uint64_t id, py::object handler,
+    std::shared_ptr<CallbackGroupState> group);
+
+  /// Register the callable executing an entity the caller waits on, e.g. a waitable
+  /**
+   * The entity isn't added to the wait set, the caller passes it to schedule() once ready.
+   *
+   * \sa add_subscription()
+   */
+  void
+  add_external(uint64_t id, py::object handler, std::shared_ptr<CallbackGroupState> group);
+
+  /// Forget an entity
+  /**
+   * An execution of the entity that was queued but did not start yet is skipped.
+   * Unknown identifiers are ignored.
+   *
+   * \param[in] id The identifier of the entity
+   */
+  void
+  remove(uint64_t id);
+
+  /// Clear the wait set and add the registered entities which may be executed to it
+  /**
+   * Entities of the caller, e.g. waitables, can then be added to the wait set before
+   * calling wait_and_schedule().
+   */
+  void
+  prepare_wait();
+
+  /// Wait on the wait set and queue the ready entities to the workers
+  /**
+   * The GIL is released while waiting.
+   * An exception raised by a callable in a worker since the last call is raised instead.
+   *
+   * \param[in] timeout_ns Maximum time to wait in nanoseconds, if negative wait forever
+   * \return Number of entities that were queued
+   */
+  size_t
+  wait_and_schedule(int64_t timeout_ns);
+
+  /// Whether an entity is neither queued nor executing and its callback group is free
+  bool
+  can_schedule(uint64_t id);
+
+  /// Queue an entity registered with add_external() to the workers
+  /**
+   * \return True if the entity was queued, False if it can't be executed right now
+   */
+  bool
+  schedule(uint64_t id);
+
+  /// End an execution whose callable returned False, so the entity may be executed again
+  void
+  end_execution(uint64_t id);
+
+  /// Stop and join the worker threads and forget all entities
+  /**
+   * Executions that were queued but did not start are skipped, and they release their callback
+   * groups like the asynchronous executions that did not end yet.
+   * If called by a callable, the worker executing it isn't joined: it stops once the callable
+   * returned, and keeps the core alive until then.
+   */
+  void
+  destroy() override;
+
+private:
+  enum class EntityKind
+  {
+    Subscription,
+    Timer,
+    GuardCondition,
+    Service,
+    Client,
+    External,
+  };
+
+  struct Entry
+  {
+    uint64_t id;
+    EntityKind kind;
+    /// The entity, kept in use while registered
+    std::shared_ptr<Destroyable> entity;
+    py::object handler;
+    /// Claimed from when the entity is queued until its execution ended
+    std::shared_ptr<CallbackGroupState> group;
+    /// True from when the entity is queued until its execution ended
+    std::atomic<bool> scheduled{false};
+    std::atomic<bool> removed{false};
+  };
+
+  struct Worker
+  {
+    std::mutex mutex;
+    std::deque<std::shared_ptr<Entry>> queue;
+  };
+
+  /// Register an entry for an entity that was entered
+  void
+  add_entry(
+    uint64_t id, EntityKind kind, std::shared_ptr<Destroyable> entity, py::object handler,
+    std::shared_ptr<CallbackGroupState> group);
+
+  /// Mark an entry as queued and queue it, unless it or its callback group is busy
+  bool
+  try_schedule(const std::shared_ptr<Entry> & entry);
+
+  /// Whether an entry is neither queued nor executing and its callback group is free
+  static bool
+  is_idle(const Entry & entry);
+
+  /// The token claiming the callback group of an entry
+  static uintptr_t
+  get_token(const Entry & entry);
+
+  /// Release the callback group of an entry and mark it as no longer queued
+  static void
+  release(Entry & entry);
+
+  /// Release an entry and wake up the wait, so it is waited on and executed again
+  void
+  finish(Entry & entry);
+
+  /// Pop from the front of the queue of a worker, or steal from the back of another one
+  std::shared_ptr<Entry>
+  pop(size_t worker_index);
+
+  /// Start the worker threads, unless they were started or the core was destroyed
+  void
+  start_workers();
+
+  /// Loop of a worker thread
+  void
+  run_worker(size_t worker_index);
+
+  std::shared_ptr<WaitSet> wait_set_;
+  std::shared_ptr<GuardCondition> wake_gc_;
+
+  /// Protects entries_ and asynchronous_entries_
+  std::mutex entries_mutex_;
+  std::unordered_map<uint64_t, std::shared_ptr<Entry>> entries_;
+  /// Entries whose callable returned False, until end_execution() is called
+  std::unordered_map<uint64_t, std::shared_ptr<Entry>> asynchronous_entries_;
+  /// The entries added to the wait set by prepare_wait(), by kind in the order of their index
+  std::vector<std::shared_ptr<Entry>> waited_subscriptions_;
+  std::vector<std::shared_ptr<Entry>> waited_timers_;
+  std::vector<std::shared_ptr<Entry>> waited_guard_conditions_;
+  std::vector<std::shared_ptr<Entry>> waited_services_;
+  std::vector<std::shared_ptr<Entry>> waited_clients_;
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::vector<std::thread> threads_;
+  std::once_flag start_flag_;
+  size_t next_worker_ = 0u;
+  /// Protects the sleep of idle workers
+  std::mutex sleep_mutex_;
+  std::condition_variable sleep_condition_;
+  /// Number of entries in the queues of the workers
+  std::atomic<size_t> queued_{0u};
+  std::atomic<bool> stopping_{false};
+
+  std::mutex error_mutex_;
+  /// First exception raised by a callable in a worker and not raised by the caller yet
+  std::exception_ptr error_;
+};
+
+/// Define a pybind11 wrapper for an rclpy::MultiThreadedExecutorCore
+/**
+ * \param[in] module a pybind11 module to add the definition to
+ */
+void
+define_multi_threaded_executor_core(py::object module);
+}  // namespace rclpy
+
+#endif  // RCLPY__MULTI_THREADED_EXECUTOR_CORE_HPP_
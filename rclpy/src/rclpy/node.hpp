@@ -28,6 +28,11 @@ namespace py = pybind11;
 
 namespace rclpy
 {
+/// A node of a context
+/**
+ * The node has no lock of its own: it holds no mutable state besides the rcl node, whose
+ * functions used here only read the node or query the graph, which is thread safe.
+ */
 class Node : public Destroyable, public std::enable_shared_from_this<Node>
 {
 public:
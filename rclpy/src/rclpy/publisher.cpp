@@ -15,31 +15,36 @@
 #include <pybind11/pybind11.h>
 
 #include <rcl/error_handling.h>
+#include <rcl/event.h>
 #include <rcl/publisher.h>
+#include <rosidl_runtime_c/message_initialization.h>
 #include <rosidl_runtime_c/message_type_support_struct.h>
+#include <rmw/rmw.h>
 #include <rmw/serialized_message.h>
 
+#include <cstdint>
+#include <cstring>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "exceptions.hpp"
+#include "introspection.hpp"
+#include "loaned_message.hpp"
+#include "message_pool.hpp"
 #include "node.hpp"
 #include "publisher.hpp"
+#include "type_support.hpp"
 #include "utils.hpp"
 
 namespace rclpy
 {
 Publisher::Publisher(
   Node & node, py::object pymsg_type, std::string topic,
-  py::object pyqos_profile)
-: node_(node)
+  py::object pyqos_profile, bool skip_unmatched)
+: node_(node), type_support_(pymsg_type),
+  message_pool_(std::make_shared<MessagePool>(type_support_)), skip_unmatched_(skip_unmatched)
 {
-  auto msg_type = static_cast<rosidl_message_type_support_t *>(
-    common_get_type_support(pymsg_type));
-  if (!msg_type) {
-    throw py::error_already_set();
-  }
-
   rcl_publisher_options_t publisher_ops = rcl_publisher_get_default_options();
 
   if (!pyqos_profile.is_none()) {
@@ -66,7 +71,7 @@ Publisher::Publisher(
   *rcl_publisher_ = rcl_get_zero_initialized_publisher();
 
   rcl_ret_t ret = rcl_publisher_init(
-    rcl_publisher_.get(), node_.rcl_ptr(), msg_type,
+    rcl_publisher_.get(), node_.rcl_ptr(), type_support_.type_support(),
     topic.c_str(), &publisher_ops);
   if (RCL_RET_OK != ret) {
     if (RCL_RET_TOPIC_NAME_INVALID == ret) {
@@ -77,10 +82,58 @@ Publisher::Publisher(
     }
     throw RCLError("Failed to create publisher");
   }
+
+  if (skip_unmatched_) {
+    matched_count_.store(get_subscription_count());
+    matched_event_ = std::shared_ptr<rcl_event_t>(
+      new rcl_event_t,
+      [](rcl_event_t * event)
+      {
+        // Unsetting the callback waits for a running one, which uses the publisher
+        rcl_ret_t ret = rcl_event_set_callback(event, nullptr, nullptr);
+        if (RCL_RET_OK != ret) {
+          rcl_reset_error();
+        }
+        ret = rcl_event_fini(event);
+        if (RCL_RET_OK != ret) {
+          int stack_level = 1;
+          PyErr_WarnFormat(
+            PyExc_RuntimeWarning, stack_level, "Failed to fini publisher matched event: %s",
+            rcl_get_error_string().str);
+          rcl_reset_error();
+        }
+        delete event;
+      });
+    *matched_event_ = rcl_get_zero_initialized_event();
+    ret = rcl_publisher_event_init(
+      matched_event_.get(), rcl_publisher_.get(), RCL_PUBLISHER_MATCHED);
+    if (RCL_RET_OK == ret) {
+      // The events are never taken, they only tell when to count the subscriptions again
+      ret = rcl_event_set_callback(matched_event_.get(), &Publisher::on_matched, this);
+    }
+    if (RCL_RET_UNSUPPORTED == ret) {
+      // Query the middleware instead
+      rcl_reset_error();
+      matched_event_.reset();
+    } else if (RCL_RET_OK != ret) {
+      throw RCLError("Failed to create publisher matched event");
+    } else {
+      matched_count_.store(get_subscription_count());
+    }
+  }
+}
+
+void
+Publisher::on_matched(const void * user_data, size_t number_of_events)
+{
+  (void)number_of_events;
+  // Called by the middleware, which may hold its own locks, so the count is updated later
+  static_cast<Publisher *>(const_cast<void *>(user_data))->matched_changed_.store(true);
 }
 
 void Publisher::destroy()
 {
+  matched_event_.reset();
   rcl_publisher_.reset();
   node_.destroy();
 }
@@ -108,6 +161,18 @@ Publisher::get_subscription_count()
   return count;
 }
 
+py::bytes
+Publisher::get_gid()
+{
+  rmw_gid_t gid;
+  rmw_ret_t ret = rmw_get_gid_for_publisher(
+    rcl_publisher_get_rmw_handle(rcl_publisher_.get()), &gid);
+  if (RMW_RET_OK != ret) {
+    throw RMWError("failed to get publisher gid");
+  }
+  return py::bytes(reinterpret_cast<const char *>(gid.data), RMW_GID_STORAGE_SIZE);
+}
+
 std::string
 Publisher::get_topic_name()
 {
@@ -119,13 +184,38 @@ Publisher::get_topic_name()
   return std::string(topic_name);
 }
 
+bool
+Publisher::has_matched_subscriptions()
+{
+  if (!matched_event_) {
+    return get_subscription_count() > 0u;
+  }
+  // The middleware is only queried after the matched subscriptions changed
+  if (matched_changed_.load() && matched_changed_.exchange(false)) {
+    try {
+      matched_count_.store(get_subscription_count());
+    } catch (...) {
+      matched_changed_.store(true);
+      throw;
+    }
+  }
+  return matched_count_.load() > 0u;
+}
+
+bool
+Publisher::skips_publish()
+{
+  return skip_unmatched_ && !has_matched_subscriptions();
+}
+
 void
 Publisher::publish(py::object pymsg)
 {
-  auto raw_ros_message = convert_from_py(pymsg);
-  if (!raw_ros_message) {
-    throw py::error_already_set();
+  if (skips_publish()) {
+    return;
   }
+  auto raw_ros_message = message_pool_->acquire();
+  type_support_.convert_from_py(pymsg, raw_ros_message.get());
 
   rcl_ret_t ret = rcl_publish(rcl_publisher_.get(), raw_ros_message.get(), NULL);
   if (RCL_RET_OK != ret) {
@@ -133,20 +223,232 @@ Publisher::publish(py::object pymsg)
   }
 }
 
-void
-Publisher::publish_raw(std::string msg)
+/// Publish a serialized message from the memory of a buffer
+static rcl_ret_t
+_publish_serialized_buffer(rcl_publisher_t * publisher, const BufferView & buffer)
 {
   rcl_serialized_message_t serialized_msg = rmw_get_zero_initialized_serialized_message();
-  serialized_msg.buffer_capacity = msg.size();
-  serialized_msg.buffer_length = msg.size();
-  serialized_msg.buffer = reinterpret_cast<uint8_t *>(const_cast<char *>(msg.c_str()));
+  serialized_msg.buffer_capacity = buffer.size();
+  serialized_msg.buffer_length = buffer.size();
+  serialized_msg.buffer = buffer.data();
+  return rcl_publish_serialized_message(publisher, &serialized_msg, NULL);
+}
+
+void
+Publisher::publish_raw(py::object pymsg)
+{
+  BufferView buffer(pymsg, false);
+  if (skips_publish()) {
+    return;
+  }
+  rcl_ret_t ret = _publish_serialized_buffer(rcl_publisher_.get(), buffer);
+  if (RCL_RET_OK != ret) {
+    throw RCLError("Failed to publish");
+  }
+}
+
+void
+Publisher::publish_raw_many(py::iterable pymsgs)
+{
+  // The views keep the memory of the messages valid while the GIL is released
+  std::vector<std::unique_ptr<BufferView>> buffers;
+  for (py::handle pymsg : pymsgs) {
+    buffers.push_back(std::make_unique<BufferView>(pymsg, false));
+  }
+  if (skips_publish()) {
+    return;
+  }
+
+  rcl_ret_t ret = RCL_RET_OK;
+  {
+    py::gil_scoped_release gil_release;
+    for (const auto & buffer : buffers) {
+      ret = _publish_serialized_buffer(rcl_publisher_.get(), *buffer);
+      if (RCL_RET_OK != ret) {
+        break;
+      }
+    }
+  }
+  if (RCL_RET_OK != ret) {
+    throw RCLError("Failed to publish");
+  }
+}
 
-  rcl_ret_t ret = rcl_publish_serialized_message(rcl_publisher_.get(), &serialized_msg, NULL);
+const rosidl_typesupport_introspection_c__MessageMembers *
+Publisher::get_fixed_layout_members()
+{
+  const auto * members = members_.load();
+  if (!members) {
+    members = get_message_members(type_support_.pymsg_type());
+    members_.store(members);
+  }
+  if (!has_fixed_layout(members)) {
+    throw py::value_error("message type of the publisher doesn't have a fixed layout");
+  }
+  return members;
+}
+
+/// Values of a member for all rows, copied to the member of the published message
+struct _Column
+{
+  uint8_t * field;
+  const uint8_t * values;
+  size_t size;
+};
+
+/// Fill the message from each row of the columns and publish it
+static void
+_publish_rows(
+  rcl_publisher_t * publisher, void * message, const std::vector<_Column> & columns,
+  size_t num_rows)
+{
+  rcl_ret_t ret = RCL_RET_OK;
+  {
+    py::gil_scoped_release gil_release;
+    for (size_t row = 0u; row < num_rows && RCL_RET_OK == ret; ++row) {
+      for (const _Column & column : columns) {
+        std::memcpy(column.field, column.values + row * column.size, column.size);
+      }
+      ret = rcl_publish(publisher, message, NULL);
+    }
+  }
   if (RCL_RET_OK != ret) {
     throw RCLError("Failed to publish");
   }
 }
 
+void
+Publisher::publish_array(py::object pyarray)
+{
+  const auto * members = get_fixed_layout_members();
+  BufferView rows(pyarray, false);
+  if (rows.size() % members->size_of_) {
+    throw py::value_error("array size is not a multiple of the message size");
+  }
+  if (skips_publish()) {
+    return;
+  }
+
+  auto message = message_pool_->acquire();
+  _publish_rows(
+    rcl_publisher_.get(), message.get(),
+    {{static_cast<uint8_t *>(message.get()), rows.data(), members->size_of_}},
+    rows.size() / members->size_of_);
+}
+
+void
+Publisher::publish_columns(py::dict pycolumns)
+{
+  const auto * members = get_fixed_layout_members();
+  if (pycolumns.empty()) {
+    throw py::value_error("no columns to publish");
+  }
+
+  // Start from the default values for the members without a column
+  auto message = type_support_.create();
+  // The views keep the memory of the columns valid while the GIL is released
+  std::vector<std::unique_ptr<BufferView>> buffers;
+  std::vector<_Column> columns;
+  size_t num_rows = 0u;
+  for (auto item : pycolumns) {
+    const std::string path = py::str(item.first);
+    void * field_message = message.get();
+    const auto * member = find_message_member(members, path, &field_message);
+    const size_t size = get_fixed_member_size(member);
+    buffers.push_back(std::make_unique<BufferView>(item.second, false));
+    const BufferView & values = *buffers.back();
+    if (values.size() % size) {
+      throw py::value_error("size of column '" + path + "' is not a multiple of the member size");
+    }
+    if (columns.empty()) {
+      num_rows = values.size() / size;
+    } else if (values.size() / size != num_rows) {
+      throw py::value_error("column '" + path + "' has a different number of values");
+    }
+    columns.push_back(
+      {static_cast<uint8_t *>(field_message) + member->offset_, values.data(), size});
+  }
+  if (skips_publish()) {
+    return;
+  }
+
+  _publish_rows(rcl_publisher_.get(), message.get(), columns, num_rows);
+}
+
+bool
+Publisher::can_loan_messages() const
+{
+  return rcl_publisher_can_loan_messages(rcl_publisher_.get());
+}
+
+std::shared_ptr<LoanedMessage>
+Publisher::borrow_loaned_message(py::object pymsg_type)
+{
+  type_support_.check_type(pymsg_type);
+  if (!rcl_publisher_can_loan_messages(rcl_publisher_.get())) {
+    // The middleware can't loan messages, publish_loaned() will do a regular publish instead
+    auto msg = type_support_.create();
+    destroy_ros_message_function * destroy_ros_message = msg.get_deleter();
+    return std::make_shared<LoanedMessage>(
+      msg.release(), destroy_ros_message, type_support_, false, false, rcl_publisher_.get());
+  }
+
+  const auto * members = get_message_members(pymsg_type);
+
+  void * loaned_msg = nullptr;
+  rcl_ret_t ret = rcl_borrow_loaned_message(
+    rcl_publisher_.get(), type_support_.type_support(), &loaned_msg);
+  if (RCL_RET_OK != ret) {
+    throw RCLError("failed to borrow loaned message");
+  }
+  members->init_function(loaned_msg, ROSIDL_RUNTIME_C_MSG_INIT_ALL);
+
+  // Keep the publisher alive until the loan is returned
+  auto rcl_publisher = rcl_publisher_;
+  return std::make_shared<LoanedMessage>(
+    loaned_msg,
+    [rcl_publisher, members](void * msg) {
+      members->fini_function(msg);
+      rcl_ret_t ret = rcl_return_loaned_message_from_publisher(rcl_publisher.get(), msg);
+      if (RCL_RET_OK != ret) {
+        // Warning should use line number of the current stack frame
+        int stack_level = 1;
+        PyErr_WarnFormat(
+          PyExc_RuntimeWarning, stack_level, "Failed to return loaned message: %s",
+          rcl_get_error_string().str);
+        rcl_reset_error();
+      }
+    },
+    type_support_, true, false, rcl_publisher_.get());
+}
+
+void
+Publisher::publish_loaned(LoanedMessage & message)
+{
+  if (message.source() != rcl_publisher_.get()) {
+    throw py::value_error("message was not borrowed from this publisher");
+  }
+  LoanedMessage::Message msg = message.detach();
+  if (skips_publish()) {
+    // The message is released, its loan returned, without being published
+    return;
+  }
+
+  if (!message.is_loaned()) {
+    rcl_ret_t ret = rcl_publish(rcl_publisher_.get(), msg.get(), NULL);
+    if (RCL_RET_OK != ret) {
+      throw RCLError("Failed to publish");
+    }
+    return;
+  }
+
+  // The middleware takes the loan back whether or not publishing succeeds
+  rcl_ret_t ret = rcl_publish_loaned_message(rcl_publisher_.get(), msg.release(), NULL);
+  if (RCL_RET_OK != ret) {
+    throw RCLError("Failed to publish loaned message");
+  }
+}
+
 bool
 Publisher::wait_for_all_acked(rcl_duration_t pytimeout)
 {
@@ -163,7 +465,10 @@ void
 define_publisher(py::object module)
 {
   py::class_<Publisher, Destroyable, std::shared_ptr<Publisher>>(module, "Publisher")
-  .def(py::init<Node &, py::object, std::string, py::object>())
+  .def(
+    py::init<Node &, py::object, std::string, py::object, bool>(),
+    py::arg("node"), py::arg("pymsg_type"), py::arg("topic"), py::arg("pyqos_profile"),
+    py::arg("skip_unmatched") = false)
   .def_property_readonly(
     "pointer", [](const Publisher & publisher) {
       return reinterpret_cast<size_t>(publisher.rcl_ptr());
@@ -175,6 +480,12 @@ define_publisher(py::object module)
   .def(
     "get_subscription_count", &Publisher::get_subscription_count,
     "Count subscribers from a publisher.")
+  .def(
+    "get_gid", &Publisher::get_gid,
+    "Get the global identifier of the publisher.")
+  .def(
+    "has_matched_subscriptions", &Publisher::has_matched_subscriptions,
+    "Check if any subscription is matched with the publisher")
   .def(
     "get_topic_name", &Publisher::get_topic_name,
     "Retrieve the topic name from a Publisher.")
@@ -184,6 +495,24 @@ define_publisher(py::object module)
   .def(
     "publish_raw", &Publisher::publish_raw,
     "Publish a serialized message.")
+  .def(
+    "publish_raw_many", &Publisher::publish_raw_many,
+    "Publish several serialized messages.")
+  .def(
+    "publish_array", &Publisher::publish_array,
+    "Publish the rows of an array of C messages of fixed layout")
+  .def(
+    "publish_columns", &Publisher::publish_columns,
+    "Publish messages of fixed layout whose members are given as columns")
+  .def(
+    "can_loan_messages", &Publisher::can_loan_messages,
+    "Check if the publisher can borrow messages from the middleware")
+  .def(
+    "borrow_loaned_message", &Publisher::borrow_loaned_message,
+    "Borrow a message to be filled and published with publish_loaned()")
+  .def(
+    "publish_loaned", &Publisher::publish_loaned,
+    "Publish a message borrowed from this publisher")
   .def(
     "wait_for_all_acked", &Publisher::wait_for_all_acked,
     "Wait until all published message data is acknowledged");
@@ -17,14 +17,20 @@
 
 #include <pybind11/pybind11.h>
 
+#include <rcl/event.h>
 #include <rcl/publisher.h>
 #include <rcl/time.h>
+#include <rosidl_typesupport_introspection_c/message_introspection.h>
 
+#include <atomic>
 #include <memory>
 #include <string>
 
 #include "destroyable.hpp"
+#include "loaned_message.hpp"
+#include "message_pool.hpp"
 #include "node.hpp"
+#include "type_support.hpp"
 
 namespace py = pybind11;
 
@@ -48,10 +54,12 @@ public:
    * \param[in] pymsg_type Message type associated with the publisher.
    * \param[in] topic The name of the topic to attach the publisher to.
    * \param[in] pyqos_profile rmw_qos_profile_t object for this publisher.
+   * \param[in] skip_unmatched If true, messages published while no subscription is matched
+   *   are dropped without being converted, by all the publish methods.
    */
   Publisher(
     Node & node, py::object pymsg_type, std::string topic,
-    py::object pyqos_profile);
+    py::object pyqos_profile, bool skip_unmatched);
 
   /// Get the name of the logger associated with the node of the publisher.
   /**
@@ -71,6 +79,32 @@ public:
   size_t
   get_subscription_count();
 
+  /// Get the global identifier of the publisher
+  /**
+   * It is the publisher GID found in the message info of the messages it published.
+   *
+   * Raises RMWError if the identifier cannot be determined
+   *
+   * \return the bytes of the identifier
+   */
+  py::bytes
+  get_gid();
+
+  /// Check if any subscription is matched with the publisher
+  /**
+   * If the publisher skips unmatched publishes, the count of matched subscriptions is kept
+   * and only queried from the middleware again after a publisher matched event was signaled
+   * through its callback, otherwise the middleware is queried.
+   * The events are not taken, so they are still delivered to the event handlers of the
+   * publisher.
+   *
+   * Raises RCLError if the matched subscriptions cannot be determined
+   *
+   * \return true if a subscription is matched
+   */
+  bool
+  has_matched_subscriptions();
+
   /// Retrieve the topic name from a rclpy_publisher_t
   /**
    * Raises RCLError if the name cannot be determined
@@ -82,6 +116,9 @@ public:
 
   /// Publish a message
   /**
+   * If the publisher skips unmatched publishes and no subscription is matched, the message is
+   * dropped without being converted.
+   *
    * Raises RCLError if the message cannot be published
    *
    * \param[in] pymsg Message to send.
@@ -91,12 +128,98 @@ public:
 
   /// Publish a serialized message
   /**
+   * The message is published from the memory of \p pymsg without copying it first.
+   *
+   * Raises TypeError if \p pymsg doesn't support the buffer protocol
+   * Raises BufferError if the buffer of \p pymsg is not contiguous
+   * Raises RCLError if the message cannot be published
+   *
+   * \param[in] pymsg The serialized message to send, any object supporting the buffer
+   *   protocol such as bytes, bytearray, memoryview or a NumPy array.
+   */
+  void
+  publish_raw(py::object pymsg);
+
+  /// Publish several serialized messages
+  /**
+   * The messages are published in order with the GIL released.
+   * If publishing one fails the following ones are not published.
+   *
+   * \param[in] pymsgs An iterable of serialized messages.
+   * \sa publish_raw()
+   */
+  void
+  publish_raw_many(py::iterable pymsgs);
+
+  /// Publish the rows of an array of C messages
+  /**
+   * Only messages of fixed layout are supported, see has_fixed_layout().
+   * Each row of \p pyarray, typically a NumPy array of the data type returned by
+   * get_message_dtype(), is copied into a C message which is then published, without holding
+   * the GIL.
+   * If publishing one fails the following ones are not published.
+   *
+   * Raises ValueError if the message type doesn't have a fixed layout or if the size of the
+   * array is not a multiple of the size of a message
+   * Raises BufferError if the buffer of \p pyarray is not contiguous
+   * Raises RCLError if a message cannot be published
+   *
+   * \param[in] pyarray An object exposing a buffer holding the rows
+   */
+  void
+  publish_array(py::object pyarray);
+
+  /// Publish messages whose members are given as columns
+  /**
+   * Only messages of fixed layout are supported, see has_fixed_layout().
+   * Each column holds the values of a member for all messages, members of nested messages
+   * are named by joining the names with dots, e.g. "linear.x".
+   * For each row the values of the columns are copied into a C message, whose other members
+   * keep their default values, which is then published, without holding the GIL.
+   * If publishing one fails the following ones are not published.
+   *
+   * Raises ValueError if the message type doesn't have a fixed layout, if a column doesn't
+   * match a member of the message or if the columns hold a different number of values
+   * Raises BufferError if the buffer of a column is not contiguous
+   * Raises RCLError if a message cannot be published
+   *
+   * \param[in] pycolumns A dictionary of member names to objects exposing buffers holding the
+   *   values of the member in the C representation
+   */
+  void
+  publish_columns(py::dict pycolumns);
+
+  /// Check if the publisher can borrow messages from the middleware
+  bool
+  can_loan_messages() const;
+
+  /// Borrow a message to be filled and published with publish_loaned()
+  /**
+   * If the middleware can loan messages the message lives in middleware memory, otherwise it
+   * is allocated by rclpy and publish_loaned() falls back to a regular publish.
+   * The message is initialized to its default values.
+   *
+   * Raises TypeError if \p pymsg_type is not the message type of the publisher
+   * Raises RCLError if the message cannot be borrowed
+   *
+   * \param[in] pymsg_type Message type of the publisher
+   * \return A writable LoanedMessage
+   */
+  std::shared_ptr<LoanedMessage>
+  borrow_loaned_message(py::object pymsg_type);
+
+  /// Publish a message borrowed from this publisher
+  /**
+   * The message is released whether or not publishing succeeds and can no longer be accessed.
+   *
+   * Raises ValueError if the message was released or was not borrowed from this publisher
+   * Raises BufferError if views of the message exist
    * Raises RCLError if the message cannot be published
    *
-   * \param[in] msg The serialized message to send.
+   * \param[in] message The message returned by borrow_loaned_message()
    */
   void
-  publish_raw(std::string msg);
+  publish_loaned(LoanedMessage & message);
 
   /// Get rcl_publisher_t pointer
   rcl_publisher_t *
@@ -128,8 +251,36 @@ public:
   wait_for_all_acked(rcl_duration_t pytimeout);
 
 private:
+  /// Called by the middleware when the matched subscriptions changed
+  static void
+  on_matched(const void * user_data, size_t number_of_events);
+
+  /// Check if a message published now is dropped since no subscription is matched
+  bool
+  skips_publish();
+
+  /// Get the introspection of the message type, raise ValueError if its layout is not fixed
+  const rosidl_typesupport_introspection_c__MessageMembers *
+  get_fixed_layout_members();
+
   Node node_;
+  TypeSupportHandle type_support_;
+  /// C messages reused by publishes and takes
+  std::shared_ptr<MessagePool> message_pool_;
   std::shared_ptr<rcl_publisher_t> rcl_publisher_;
+  bool skip_unmatched_;
+  /// Publisher matched event tracking the matched subscriptions, if skipping unmatched publishes
+  /**
+   * It is not set if the middleware doesn't support the event or its callback, in which case
+   * the middleware is queried instead.
+   */
+  std::shared_ptr<rcl_event_t> matched_event_;
+  /// Count of matched subscriptions, queried again when matched_changed_ is set
+  std::atomic<size_t> matched_count_{0u};
+  /// Set by the callback of the publisher matched event
+  std::atomic<bool> matched_changed_{false};
+  /// Introspection of the message type, set when first needed
+  std::atomic<const rosidl_typesupport_introspection_c__MessageMembers *> members_{nullptr};
 };
 /// Define a pybind11 wrapper for an rclpy::Service
 void define_publisher(py::object module);
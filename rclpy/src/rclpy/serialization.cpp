@@ -18,12 +18,20 @@
 #include <rcl/types.h>
 #include <rcutils/allocator.h>
 #include <rcutils/error_handling.h>
+#include <rmw/error_handling.h>
 #include <rmw/rmw.h>
 #include <rmw/serialized_message.h>
 #include <rosidl_runtime_c/message_type_support_struct.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
 #include "exceptions.hpp"
+#include "message_pool.hpp"
 #include "serialization.hpp"
+#include "type_support.hpp"
 #include "utils.hpp"
 
 namespace rclpy
@@ -50,26 +58,52 @@ SerializedMessage::~SerializedMessage()
   }
 }
 
-py::bytes
-serialize(py::object pymsg, py::object pymsg_type)
+ReusedSerializedMessage::ReusedSerializedMessage(rcutils_allocator_t allocator)
+: msg_(allocator)
+{
+}
+
+void
+ReusedSerializedMessage::prepare()
 {
-  // Get type support
-  auto ts = static_cast<rosidl_message_type_support_t *>(
-    common_get_type_support(pymsg_type));
-  if (!ts) {
-    throw py::error_already_set();
+  // Buffers smaller than this are never shrunk, it's not worth reallocating them
+  constexpr size_t min_shrink_capacity = 64u * 1024u;
+  const size_t capacity = msg_.rcl_msg.buffer_capacity;
+  if (capacity <= min_shrink_capacity || capacity / 4u <= average_length_) {
+    return;
   }
+  // Keep room for messages of twice the recent size
+  const size_t new_capacity = std::max(min_shrink_capacity, 2u * average_length_);
+  msg_.rcl_msg.buffer_length = 0u;
+  if (RCUTILS_RET_OK != rmw_serialized_message_resize(&msg_.rcl_msg, new_capacity)) {
+    throw RCUtilsError("failed to resize serialized message");
+  }
+}
 
-  auto ros_msg = convert_from_py(pymsg);
-  if (!ros_msg) {
-    throw py::error_already_set();
+void
+ReusedSerializedMessage::record_length()
+{
+  const size_t length = msg_.rcl_msg.buffer_length;
+  if (0u == average_length_) {
+    average_length_ = length;
+  } else {
+    // Exponential moving average over about the last 16 messages
+    average_length_ = average_length_ - average_length_ / 16u + length / 16u;
   }
+}
+
+py::bytes
+serialize(py::object pymsg, py::object pymsg_type)
+{
+  TypeSupportHandle type_support(pymsg_type);
+  auto ros_msg = type_support.convert_from_py(pymsg);
 
   // Create a serialized message object
   SerializedMessage serialized_msg(rcutils_get_default_allocator());
 
   // Serialize
-  rmw_ret_t rmw_ret = rmw_serialize(ros_msg.get(), ts, &serialized_msg.rcl_msg);
+  rmw_ret_t rmw_ret = rmw_serialize(
+    ros_msg.get(), type_support.type_support(), &serialized_msg.rcl_msg);
   if (RMW_RET_OK != rmw_ret) {
     throw RMWError("Failed to serialize ROS message");
   }
@@ -80,43 +114,188 @@ serialize(py::object pymsg, py::object pymsg_type)
     serialized_msg.rcl_msg.buffer_length);
 }
 
-py::object
-deserialize(py::bytes pybuffer, py::object pymsg_type)
+/// Serialize a C message into a buffer kept by the calling thread
+static const rcl_serialized_message_t &
+_serialize_into_thread_buffer(
+  const void * ros_msg, const rosidl_message_type_support_t * type_support)
 {
-  // Get type support
-  auto ts = static_cast<rosidl_message_type_support_t *>(
-    common_get_type_support(pymsg_type));
-  if (!ts) {
-    throw py::error_already_set();
+  thread_local ReusedSerializedMessage serialized_msg(rcutils_get_default_allocator());
+  serialized_msg.prepare();
+  rmw_ret_t rmw_ret = rmw_serialize(ros_msg, type_support, &serialized_msg.rcl_msg());
+  if (RMW_RET_OK != rmw_ret) {
+    throw RMWError("Failed to serialize ROS message");
   }
+  serialized_msg.record_length();
+  return serialized_msg.rcl_msg();
+}
 
-  // Create a serialized message object
-  rcl_serialized_message_t serialized_msg = rmw_get_zero_initialized_serialized_message();
-  // Just copy pointer to avoid extra allocation and copy
-  char * serialized_buffer;
-  Py_ssize_t length;
-  if (PYBIND11_BYTES_AS_STRING_AND_SIZE(pybuffer.ptr(), &serialized_buffer, &length)) {
-    throw py::error_already_set();
+static void *
+_no_allocate(size_t, void *)
+{
+  return nullptr;
+}
+
+static void *
+_no_reallocate(void *, size_t, void *)
+{
+  return nullptr;
+}
+
+static void
+_no_deallocate(void *, void *)
+{
+}
+
+static void *
+_no_zero_allocate(size_t, size_t, void *)
+{
+  return nullptr;
+}
+
+py::ssize_t
+serialize_into(py::object pymsg, py::object pymsg_type, py::object pybuffer, size_t offset)
+{
+  BufferView buffer(pybuffer, true);
+  if (offset > buffer.size()) {
+    throw py::value_error("offset is past the end of the buffer");
   }
-  if (length < 0) {
-    throw py::error_already_set();
+
+  TypeSupportHandle type_support(pymsg_type);
+  auto ros_msg = type_support.convert_from_py(pymsg);
+
+  // Serialize straight into the buffer, with an allocator that refuses to grow it
+  rcutils_allocator_t no_allocator = rcutils_get_zero_initialized_allocator();
+  no_allocator.allocate = _no_allocate;
+  no_allocator.deallocate = _no_deallocate;
+  no_allocator.reallocate = _no_reallocate;
+  no_allocator.zero_allocate = _no_zero_allocate;
+  rcl_serialized_message_t in_place = rmw_get_zero_initialized_serialized_message();
+  in_place.buffer = buffer.data() + offset;
+  in_place.buffer_capacity = buffer.size() - offset;
+  in_place.allocator = no_allocator;
+  rmw_ret_t rmw_ret = rmw_serialize(ros_msg.get(), type_support.type_support(), &in_place);
+  if (RMW_RET_OK == rmw_ret && in_place.buffer == buffer.data() + offset) {
+    return static_cast<py::ssize_t>(in_place.buffer_length);
   }
-  serialized_msg.buffer_capacity = length;
-  serialized_msg.buffer_length = length;
-  serialized_msg.buffer = reinterpret_cast<uint8_t *>(serialized_buffer);
+  // Either the message doesn't fit or the rmw implementation doesn't serialize in place
+  rmw_reset_error();
 
-  auto deserialized_ros_msg = create_from_py(pymsg_type);
-  if (!deserialized_ros_msg) {
-    throw py::error_already_set();
+  const rcl_serialized_message_t & serialized_msg = _serialize_into_thread_buffer(
+    ros_msg.get(), type_support.type_support());
+  const auto length = static_cast<py::ssize_t>(serialized_msg.buffer_length);
+  if (serialized_msg.buffer_length > buffer.size() - offset) {
+    return -length;
   }
+  std::memcpy(buffer.data() + offset, serialized_msg.buffer, serialized_msg.buffer_length);
+  return length;
+}
+
+size_t
+serialized_size(py::object pymsg, py::object pymsg_type)
+{
+  // The size is only known once serialized, the buffer of the thread saves allocating one
+  TypeSupportHandle type_support(pymsg_type);
+  auto ros_msg = type_support.convert_from_py(pymsg);
+  return _serialize_into_thread_buffer(
+    ros_msg.get(), type_support.type_support()).buffer_length;
+}
+
+py::object
+deserialize(py::object pybuffer, py::object pymsg_type)
+{
+  TypeSupportHandle type_support(pymsg_type);
+
+  // Just point to the memory of the buffer to avoid extra allocation and copy
+  BufferView buffer(pybuffer, false);
+  rcl_serialized_message_t serialized_msg = rmw_get_zero_initialized_serialized_message();
+  serialized_msg.buffer_capacity = buffer.size();
+  serialized_msg.buffer_length = buffer.size();
+  serialized_msg.buffer = buffer.data();
+
+  auto deserialized_ros_msg = type_support.create();
 
   // Deserialize
-  rmw_ret_t rmw_ret = rmw_deserialize(&serialized_msg, ts, deserialized_ros_msg.get());
+  rmw_ret_t rmw_ret = rmw_deserialize(
+    &serialized_msg, type_support.type_support(), deserialized_ros_msg.get());
 
   if (RMW_RET_OK != rmw_ret) {
     throw RMWError("failed to deserialize ROS message");
   }
 
-  return convert_to_py(deserialized_ros_msg.get(), pymsg_type);
+  return type_support.convert_to_py(deserialized_ros_msg.get());
+}
+
+py::tuple
+serialize_batch(py::iterable pymsgs, py::object pymsg_type)
+{
+  TypeSupportHandle type_support(pymsg_type);
+  // The pool empties the sequences of the message, which the conversion would leak, each time
+  // it is given back
+  auto message_pool = std::make_shared<MessagePool>(type_support);
+  SerializedMessage serialized_msg(rcutils_get_default_allocator());
+
+  std::vector<uint8_t> serialized_msgs;
+  std::vector<uint64_t> offsets{0u};
+  for (py::handle pymsg : pymsgs) {
+    auto ros_msg = message_pool->acquire();
+    type_support.convert_from_py(pymsg, ros_msg.get());
+    rmw_ret_t rmw_ret;
+    {
+      py::gil_scoped_release gil_release;
+      rmw_ret = rmw_serialize(
+        ros_msg.get(), type_support.type_support(), &serialized_msg.rcl_msg);
+      if (RMW_RET_OK == rmw_ret) {
+        serialized_msgs.insert(
+          serialized_msgs.end(), serialized_msg.rcl_msg.buffer,
+          serialized_msg.rcl_msg.buffer + serialized_msg.rcl_msg.buffer_length);
+      }
+    }
+    if (RMW_RET_OK != rmw_ret) {
+      throw RMWError("Failed to serialize ROS message");
+    }
+    offsets.push_back(serialized_msgs.size());
+  }
+
+  py::bytes pyoffsets(
+    reinterpret_cast<const char *>(offsets.data()), offsets.size() * sizeof(uint64_t));
+  return py::make_tuple(
+    py::bytes(reinterpret_cast<const char *>(serialized_msgs.data()), serialized_msgs.size()),
+    py::memoryview(pyoffsets).attr("cast")("Q"));
+}
+
+py::list
+deserialize_batch(py::object pybuffer, py::sequence pyoffsets, py::object pymsg_type)
+{
+  TypeSupportHandle type_support(pymsg_type);
+  auto ros_msg = type_support.create();
+  BufferView buffer(pybuffer, false);
+
+  std::vector<uint64_t> offsets;
+  offsets.reserve(pyoffsets.size());
+  for (py::handle pyoffset : pyoffsets) {
+    const auto offset = pyoffset.cast<uint64_t>();
+    if (offset > buffer.size() || (!offsets.empty() && offset < offsets.back())) {
+      throw py::value_error("offsets must be increasing and within the buffer");
+    }
+    offsets.push_back(offset);
+  }
+
+  py::list pymsgs;
+  for (size_t i = 1u; i < offsets.size(); ++i) {
+    rcl_serialized_message_t serialized_msg = rmw_get_zero_initialized_serialized_message();
+    serialized_msg.buffer = buffer.data() + offsets[i - 1u];
+    serialized_msg.buffer_length = offsets[i] - offsets[i - 1u];
+    serialized_msg.buffer_capacity = serialized_msg.buffer_length;
+    rmw_ret_t rmw_ret;
+    {
+      py::gil_scoped_release gil_release;
+      rmw_ret = rmw_deserialize(&serialized_msg, type_support.type_support(), ros_msg.get());
+    }
+    if (RMW_RET_OK != rmw_ret) {
+      throw RMWError("failed to deserialize ROS message");
+    }
+    pymsgs.append(type_support.convert_to_py(ros_msg.get()));
+  }
+  return pymsgs;
 }
 }  // namespace rclpy
@@ -34,6 +34,44 @@ struct SerializedMessage
   rcl_serialized_message_t rcl_msg;
 };
 
+/// A serialized message reused for every message of a stream, such as the takes of a topic
+/**
+ * The buffer grows to fit the largest message and is kept across messages, so messages of
+ * steady size don't cause any allocation.
+ * It shrinks back when it stays much larger than the recent messages, so a single large
+ * message doesn't pin its memory forever.
+ */
+class ReusedSerializedMessage
+{
+public:
+  explicit ReusedSerializedMessage(rcutils_allocator_t allocator);
+
+  /// Get the serialized message
+  rcl_serialized_message_t &
+  rcl_msg()
+  {
+    return msg_.rcl_msg;
+  }
+
+  /// Shrink the buffer if it's much larger than the recent messages
+  /**
+   * This must be called before a new message is written, the content is lost if it shrinks.
+   *
+   * Raises RCUtilsError if the buffer cannot be resized
+   */
+  void
+  prepare();
+
+  /// Record the size of the message that was written
+  void
+  record_length();
+
+private:
+  SerializedMessage msg_;
+  /// Moving average of the length of the recent messages
+  size_t average_length_ = 0u;
+};
+
 /// Serialize a ROS message
 /**
  * Raises RCUtilsError on failure to initialize a serialized message
@@ -46,16 +84,88 @@ struct SerializedMessage
 py::bytes
 serialize(py::object pymsg, py::object pymsg_type);
 
+/// Serialize a ROS message into an existing buffer
+/**
+ * The message is serialized in place if the rmw implementation supports it, otherwise it is
+ * serialized into a buffer kept by the calling thread and copied.
+ *
+ * Raises BufferError if \p pybuffer is not a writable contiguous buffer
+ * Raises ValueError if \p offset is past the end of the buffer
+ * Raises RMWError on serialization failure
+ *
+ * \param[in] pymsg an instance of a ROS message
+ * \param[in] pymsg_type the type of the ROS message
+ * \param[in] pybuffer an object exposing a writable buffer, e.g. a bytearray or memoryview
+ * \param[in] offset where to write the message in the buffer, in bytes
+ * \return the size of the serialized message, or its negated size if it doesn't fit the
+ *   buffer, in which case nothing is written
+ */
+py::ssize_t
+serialize_into(py::object pymsg, py::object pymsg_type, py::object pybuffer, size_t offset);
+
+/// Get the size of a serialized ROS message
+/**
+ * The size is only known once the message is serialized, so this converts and serializes the
+ * message into a buffer kept by the calling thread, the same one serialize_into() falls back
+ * to, and costs about as much as serializing it.
+ * Getting the size to then serialize into a buffer of that size serializes twice, calling
+ * serialize_into() directly with a buffer that is usually large enough avoids it.
+ *
+ * Raises RMWError on serialization failure
+ *
+ * \param[in] pymsg an instance of a ROS message
+ * \param[in] pymsg_type the type of the ROS message
+ * \return the size of the message once serialized, in bytes
+ */
+size_t
+serialized_size(py::object pymsg, py::object pymsg_type);
+
 /// Deserialize a ROS message
 /**
+ * Raises TypeError if \p pybuffer doesn't support the buffer protocol
+ * Raises BufferError if \p pybuffer is not a contiguous buffer
  * Raises RMWError on deserialization failure
  *
- * \param[in] pybuffer a serialized ROS message
+ * \param[in] pybuffer a serialized ROS message, any object supporting the buffer protocol
+ *   such as bytes or a memoryview of a part of a larger buffer
  * \param[in] pymsg_type the type of the ROS message to deserialize
  * \return an instance of a ROS message
  */
 py::object
-deserialize(py::bytes pybuffer, py::object pymsg_type);
+deserialize(py::object pybuffer, py::object pymsg_type);
+
+/// Serialize ROS messages of one type into a single buffer
+/**
+ * One C message is reused for all messages, its sequences are emptied between messages, and
+ * the serialization runs with the GIL released.
+ *
+ * Raises RMWError on serialization failure
+ *
+ * \param[in] pymsgs an iterable of instances of the ROS message type
+ * \param[in] pymsg_type the type of the ROS messages
+ * \return a tuple of the serialized messages concatenated in a bytes object and a memoryview
+ *   of unsigned 64-bit offsets, one per message and one for the end of the last message
+ */
+py::tuple
+serialize_batch(py::iterable pymsgs, py::object pymsg_type);
+
+/// Deserialize ROS messages of one type from a single buffer
+/**
+ * One C message is reused for all messages and the deserialization runs with the GIL
+ * released.
+ *
+ * Raises TypeError if \p pybuffer doesn't support the buffer protocol
+ * Raises ValueError if the offsets are decreasing or past the end of the buffer
+ * Raises RMWError on deserialization failure
+ *
+ * \param[in] pybuffer the serialized messages, any object supporting the buffer protocol
+ * \param[in] pyoffsets the offsets of the messages in the buffer, as returned by
+ *   serialize_batch(): message i spans from offset i to offset i + 1
+ * \param[in] pymsg_type the type of the ROS messages
+ * \return a list of instances of the ROS message type
+ */
+py::list
+deserialize_batch(py::object pybuffer, py::sequence pyoffsets, py::object pymsg_type);
 }  // namespace rclpy
 
 #endif  // RCLPY__SERIALIZATION_HPP_
@@ -15,18 +15,21 @@
 #include <pybind11/pybind11.h>
 
 #include <rcl/error_handling.h>
+#include <rcl/node.h>
 #include <rcl/service.h>
 #include <rcl/service_introspection.h>
 #include <rosidl_runtime_c/service_type_support_struct.h>
 #include <rmw/types.h>
 
 #include <memory>
+#include <mutex>
 #include <string>
 
 #include "clock.hpp"
 #include "exceptions.hpp"
 #include "node.hpp"
 #include "service.hpp"
+#include "type_support.hpp"
 #include "utils.hpp"
 
 namespace rclpy
@@ -42,7 +45,9 @@ Service::destroy()
 Service::Service(
   Node & node, py::object pysrv_type, const std::string & service_name,
   py::object pyqos_profile)
-: node_(node)
+: node_(node),
+  request_type_support_(pysrv_type.attr("Request")),
+  response_type_support_(pysrv_type.attr("Response"))
 {
   srv_type_ = static_cast<rosidl_service_type_support_t *>(
     common_get_type_support(pysrv_type));
@@ -100,12 +105,14 @@ Service::Service(
 void
 Service::service_send_response(py::object pyresponse, rmw_request_id_t * header)
 {
-  auto raw_ros_response = convert_from_py(pyresponse);
-  if (!raw_ros_response) {
-    throw py::error_already_set();
-  }
+  auto raw_ros_response = response_type_support_ ?
+    response_type_support_->convert_from_py(pyresponse) : convert_from_py(pyresponse);
 
-  rcl_ret_t ret = rcl_send_response(rcl_service_.get(), header, raw_ros_response.get());
+  rcl_ret_t ret;
+  {
+    auto lock = lock_releasing_gil(mutex_);
+    ret = rcl_send_response(rcl_service_.get(), header, raw_ros_response.get());
+  }
   if (RCL_RET_OK != ret) {
     if (RCL_RET_TIMEOUT == ret) {
       // Warning should use line number of the current stack frame
@@ -123,11 +130,20 @@ Service::service_send_response(py::object pyresponse, rmw_request_id_t * header)
 py::tuple
 Service::service_take_request(py::object pyrequest_type)
 {
-  auto taken_request = create_from_py(pyrequest_type);
+  if (request_type_support_) {
+    request_type_support_->check_type(pyrequest_type);
+  }
+  auto taken_request = request_type_support_ ?
+    request_type_support_->create() : create_from_py(pyrequest_type);
   rmw_service_info_t header;
 
   py::tuple result_tuple(2);
-  rcl_ret_t ret = rcl_take_request_with_info(rcl_service_.get(), &header, taken_request.get());
+  rcl_ret_t ret;
+  {
+    auto lock = lock_releasing_gil(mutex_);
+    py::gil_scoped_release gil_release;
+    ret = rcl_take_request_with_info(rcl_service_.get(), &header, taken_request.get());
+  }
   if (ret == RCL_RET_SERVICE_TAKE_FAILED) {
     result_tuple[0] = py::none();
     result_tuple[1] = py::none();
@@ -137,7 +153,9 @@ Service::service_take_request(py::object pyrequest_type)
   }
 
   result_tuple[1] = header;
-  result_tuple[0] = convert_to_py(taken_request.get(), pyrequest_type);
+  result_tuple[0] = request_type_support_ ?
+    request_type_support_->convert_to_py(taken_request.get()) :
+    convert_to_py(taken_request.get(), pyrequest_type);
 
   return result_tuple;
 }
@@ -148,6 +166,17 @@ Service::get_service_name()
   return rcl_service_get_service_name(rcl_service_.get());
 }
 
+const char *
+Service::get_logger_name() const
+{
+  const char * node_logger_name = rcl_node_get_logger_name(node_.rcl_ptr());
+  if (!node_logger_name) {
+    throw RCLError("Node logger name not set");
+  }
+
+  return node_logger_name;
+}
+
 py::dict
 Service::get_qos_profile()
 {
@@ -165,6 +194,7 @@ Service::configure_introspection(
     pyqos_service_event_pub.is_none() ? rcl_publisher_get_default_options().qos :
     pyqos_service_event_pub.cast<rmw_qos_profile_t>();
 
+  auto lock = lock_releasing_gil(mutex_);
   rcl_ret_t ret = rcl_service_configure_service_introspection(
     rcl_service_.get(), node_.rcl_ptr(), clock.rcl_ptr(), srv_type_, pub_opts, introspection_state);
 
@@ -22,11 +22,14 @@
 #include <rmw/types.h>
 
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 
 #include "clock.hpp"
 #include "destroyable.hpp"
 #include "node.hpp"
+#include "type_support.hpp"
 #include "utils.hpp"
 
 namespace py = pybind11;
@@ -74,6 +77,7 @@ public:
   /// Take a request from a given service
   /**
    * Raises RCLError if the take failed
+   * Raises TypeError if \p pyrequest_type is not the request type of the service
    *
    * \param[in] pyrequest_type Instance of the message type to take
    * \return [None, None] if there was nothing to take, or
@@ -95,6 +99,13 @@ public:
   const char *
   get_service_name();
 
+  /// Get the name of the logger associated with the node of the service.
+  /**
+   * Raises RCLError if the node logger name is not set
+   */
+  const char *
+  get_logger_name() const;
+
   /// Get the QoS profile for this service.
   py::dict
   get_qos_profile();
@@ -118,6 +129,15 @@ private:
   Node node_;
   std::shared_ptr<rcl_service_t> rcl_service_;
   rosidl_service_type_support_t * srv_type_;
+  /// Unset if the service was created from an existing rcl service
+  std::optional<TypeSupportHandle> request_type_support_;
+  std::optional<TypeSupportHandle> response_type_support_;
+  /// Serializes sending responses, taking requests and configuring introspection
+  /**
+   * The rcl service functions are not thread safe, and introspection configures the
+   * publisher that sending and taking use.
+   */
+  std::mutex mutex_;
 };
 
 /// Define a pybind11 wrapper for an rclpy::Service
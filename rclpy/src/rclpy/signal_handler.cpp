@@ -23,6 +23,7 @@
 
 #include <atomic>
 #include <csignal>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 #include <thread>
@@ -56,7 +57,9 @@ sem_t g_signal_handler_sem;
 
 std::thread g_deferred_signal_handling_thread;
 
-// relying on python GIL for safety
+/// Serializes installing and uninstalling the signal handlers from several Python threads
+std::mutex g_signal_handlers_mutex;
+
 std::atomic<bool> g_signal_handler_installed = false;
 
 void
@@ -395,6 +398,10 @@ register_sigterm_signal_handler()
 /// interrupts while adding or removing from the list
 std::atomic<rcl_guard_condition_t **> g_guard_conditions;
 
+/// Serializes changing the list of guard conditions and triggering them, so a list isn't freed
+/// while the deferred signal handling thread iterates over it
+std::mutex g_guard_conditions_mutex;
+
 /// Trigger all registered guard conditions
 /**
  * This triggers guard conditions when a signal is received.
@@ -404,6 +411,7 @@ std::atomic<rcl_guard_condition_t **> g_guard_conditions;
 static bool
 trigger_guard_conditions()
 {
+  std::lock_guard<std::mutex> lock(g_guard_conditions_mutex);
   rcl_guard_condition_t ** guard_conditions = g_guard_conditions.load();
   if (!guard_conditions || !guard_conditions[0]) {
     return false;
@@ -430,9 +438,8 @@ namespace rclpy
 void
 check_signal_safety()
 {
-  static bool did_warn = false;
-  if (!did_warn && !g_guard_conditions.is_lock_free()) {
-    did_warn = true;
+  static std::atomic<bool> did_warn = false;
+  if (!g_guard_conditions.is_lock_free() && !did_warn.exchange(true)) {
     const char * deadlock_msg =
       "Global guard condition list access is not lock-free on this platform."
       "The program may deadlock when receiving SIGINT.";
@@ -454,6 +461,7 @@ register_sigint_guard_condition(const GuardCondition & guard_condition)
 {
   check_signal_safety();
 
+  std::lock_guard<std::mutex> lock(g_guard_conditions_mutex);
   rcl_guard_condition_t * gc = guard_condition.rcl_ptr();
   rcl_guard_condition_t ** guard_conditions = g_guard_conditions.load();
 
@@ -498,6 +506,7 @@ register_sigint_guard_condition(const GuardCondition & guard_condition)
 void
 unregister_sigint_guard_condition(const GuardCondition & guard_condition)
 {
+  std::lock_guard<std::mutex> lock(g_guard_conditions_mutex);
   rcl_guard_condition_t * gc = guard_condition.rcl_ptr();
   rcl_guard_condition_t ** guard_conditions = g_guard_conditions.load();
 
@@ -573,6 +582,7 @@ enum class SignalHandlerOptions : int
 void
 install_signal_handlers(SignalHandlerOptions options)
 {
+  std::lock_guard<std::mutex> lock(g_signal_handlers_mutex);
   setup_deferred_signal_handler();
   switch (options) {
     case SignalHandlerOptions::No:
@@ -597,6 +607,7 @@ install_signal_handlers(SignalHandlerOptions options)
 SignalHandlerOptions
 get_current_signal_handlers_options()
 {
+  std::lock_guard<std::mutex> lock(g_signal_handlers_mutex);
   // conversion to SignalHandlerOptions value
   return SignalHandlerOptions{g_sigterm_installed * 2 + g_sigint_installed};
 }
@@ -605,6 +616,7 @@ get_current_signal_handlers_options()
 void
 uninstall_signal_handlers()
 {
+  std::lock_guard<std::mutex> lock(g_signal_handlers_mutex);
   unregister_sigint_signal_handler();
   unregister_sigterm_signal_handler();
   teardown_deferred_signal_handler();
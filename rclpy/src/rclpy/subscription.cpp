@@ -19,13 +19,26 @@
 #include <rcl/subscription.h>
 #include <rcl/types.h>
 #include <rosidl_runtime_c/message_type_support_struct.h>
+#include <rmw/error_handling.h>
+#include <rmw/message_sequence.h>
 #include <rmw/types.h>
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "exceptions.hpp"
+#include "introspection.hpp"
+#include "loaned_message.hpp"
+#include "member_buffer.hpp"
+#include "message_pool.hpp"
 #include "node.hpp"
 #include "serialization.hpp"
 #include "subscription.hpp"
@@ -38,14 +51,9 @@ namespace rclpy
 Subscription::Subscription(
   Node & node, py::object pymsg_type, std::string topic,
   py::object pyqos_profile)
-: node_(node)
+: node_(node), type_support_(pymsg_type),
+  message_pool_(std::make_shared<MessagePool>(type_support_))
 {
-  auto msg_type = static_cast<rosidl_message_type_support_t *>(
-    common_get_type_support(pymsg_type));
-  if (!msg_type) {
-    throw py::error_already_set();
-  }
-
   rcl_subscription_options_t subscription_ops = rcl_subscription_get_default_options();
 
   if (!pyqos_profile.is_none()) {
@@ -72,7 +80,7 @@ Subscription::Subscription(
   *rcl_subscription_ = rcl_get_zero_initialized_subscription();
 
   rcl_ret_t ret = rcl_subscription_init(
-    rcl_subscription_.get(), node_.rcl_ptr(), msg_type,
+    rcl_subscription_.get(), node_.rcl_ptr(), type_support_.type_support(),
     topic.c_str(), &subscription_ops);
   if (ret != RCL_RET_OK) {
     if (ret == RCL_RET_TOPIC_NAME_INVALID) {
@@ -91,15 +99,94 @@ void Subscription::destroy()
   node_.destroy();
 }
 
+/// Convert message info to the plain dictionary returned with taken messages
+static py::dict
+_convert_to_py_message_info(const rmw_message_info_t & message_info)
+{
+  py::object pub_seq_number = py::none();
+  if (message_info.publication_sequence_number != RMW_MESSAGE_INFO_SEQUENCE_NUMBER_UNSUPPORTED) {
+    pub_seq_number = py::int_(message_info.publication_sequence_number);
+  }
+  py::object rec_seq_number = py::none();
+  if (message_info.reception_sequence_number != RMW_MESSAGE_INFO_SEQUENCE_NUMBER_UNSUPPORTED) {
+    rec_seq_number = py::int_(message_info.reception_sequence_number);
+  }
+  return py::dict(
+    "source_timestamp"_a = message_info.source_timestamp,
+    "received_timestamp"_a = message_info.received_timestamp,
+    "publication_sequence_number"_a = pub_seq_number,
+    "reception_sequence_number"_a = rec_seq_number);
+}
+
+/// Take a message with rcl_take() without holding the GIL
+static rcl_ret_t
+_take(rcl_subscription_t * subscription, void * ros_message, rmw_message_info_t * message_info)
+{
+  py::gil_scoped_release gil_release;
+  return rcl_take(subscription, ros_message, message_info, NULL);
+}
+
+const rosidl_typesupport_introspection_c__MessageMembers *
+Subscription::members()
+{
+  const auto * members = members_.load();
+  if (!members) {
+    // Threads racing here look up the same introspection
+    members = get_message_members(type_support_.pymsg_type());
+    members_.store(members);
+  }
+  return members;
+}
+
 py::object
 Subscription::take_message(py::object pymsg_type, bool raw)
 {
   py::object pytaken_msg;
   rmw_message_info_t message_info;
   if (raw) {
-    SerializedMessage taken{rcutils_get_default_allocator()};
-    rcl_ret_t ret = rcl_take_serialized_message(
-      rcl_subscription_.get(), &taken.rcl_msg, &message_info, NULL);
+    auto lock = lock_releasing_gil(raw_take_mutex_);
+    if (!take_serialized()) {
+      return py::none();
+    }
+    const rcl_serialized_message_t & taken = raw_take_->message.rcl_msg();
+    pytaken_msg = py::bytes(reinterpret_cast<const char *>(taken.buffer), taken.buffer_length);
+    message_info = raw_take_->message_info;
+  } else {
+    type_support_.check_type(pymsg_type);
+    auto taken_msg = message_pool_->acquire();
+
+    do {
+      rcl_ret_t ret = _take(rcl_subscription_.get(), taken_msg.get(), &message_info);
+      if (RCL_RET_OK != ret) {
+        if (RCL_RET_BAD_ALLOC == ret) {
+          rcl_reset_error();
+          throw std::bad_alloc();
+        }
+        if (RCL_RET_SUBSCRIPTION_TAKE_FAILED == ret) {
+          return py::none();
+        }
+        throw RCLError("failed to take message from subscription");
+      }
+    } while (is_ignored(message_info));
+
+    pytaken_msg = type_support_.convert_to_py(taken_msg.get());
+  }
+  return py::make_tuple(pytaken_msg, _convert_to_py_message_info(message_info));
+}
+
+py::object
+Subscription::take_loaned_message(py::object pymsg_type)
+{
+  type_support_.check_type(pymsg_type);
+  std::shared_ptr<LoanedMessage> loaned_message;
+  rmw_message_info_t message_info;
+  if (rcl_subscription_can_loan_messages(rcl_subscription_.get())) {
+    void * loaned_msg = nullptr;
+    rcl_ret_t ret;
+    {
+      py::gil_scoped_release gil_release;
+      ret = rcl_take_loaned_message(rcl_subscription_.get(), &loaned_msg, &message_info, NULL);
+    }
     if (RCL_RET_OK != ret) {
       if (RCL_RET_BAD_ALLOC == ret) {
         rcl_reset_error();
@@ -108,16 +195,29 @@ Subscription::take_message(py::object pymsg_type, bool raw)
       if (RCL_RET_SUBSCRIPTION_TAKE_FAILED == ret) {
         return py::none();
       }
-      throw RCLError("failed to take raw message from subscription");
+      throw RCLError("failed to take loaned message from subscription");
     }
-    pytaken_msg = py::bytes(
-      reinterpret_cast<const char *>(taken.rcl_msg.buffer),
-      taken.rcl_msg.buffer_length);
+    // Keep the subscription alive until the loan is returned
+    auto rcl_subscription = rcl_subscription_;
+    loaned_message = std::make_shared<LoanedMessage>(
+      loaned_msg,
+      [rcl_subscription](void * msg) {
+        rcl_ret_t ret = rcl_return_loaned_message_from_subscription(
+          rcl_subscription.get(), msg);
+        if (RCL_RET_OK != ret) {
+          // Warning should use line number of the current stack frame
+          int stack_level = 1;
+          PyErr_WarnFormat(
+            PyExc_RuntimeWarning, stack_level, "Failed to return loaned message: %s",
+            rcl_get_error_string().str);
+          rcl_reset_error();
+        }
+      },
+      type_support_, true, true, rcl_subscription_.get());
   } else {
-    auto taken_msg = create_from_py(pymsg_type);
-
-    rcl_ret_t ret = rcl_take(
-      rcl_subscription_.get(), taken_msg.get(), &message_info, NULL);
+    // The middleware can't loan messages, take into a message owned by the view instead
+    auto taken_msg = type_support_.create();
+    rcl_ret_t ret = _take(rcl_subscription_.get(), taken_msg.get(), &message_info);
     if (RCL_RET_OK != ret) {
       if (RCL_RET_BAD_ALLOC == ret) {
         rcl_reset_error();
@@ -128,23 +228,348 @@ Subscription::take_message(py::object pymsg_type, bool raw)
       }
       throw RCLError("failed to take message from subscription");
     }
+    destroy_ros_message_function * destroy_ros_message = taken_msg.get_deleter();
+    loaned_message = std::make_shared<LoanedMessage>(
+      taken_msg.release(), destroy_ros_message, type_support_, false, true,
+      rcl_subscription_.get());
+  }
+  return py::make_tuple(loaned_message, _convert_to_py_message_info(message_info));
+}
 
-    pytaken_msg = convert_to_py(taken_msg.get(), pymsg_type);
+py::object
+Subscription::take_message_into(py::object pymsg)
+{
+  if (!pymsg.get_type().is(type_support_.pymsg_type())) {
+    throw py::type_error("message is not an instance of the type of the subscription");
   }
-  py::object pub_seq_number = py::none();
-  if (message_info.publication_sequence_number != RMW_MESSAGE_INFO_SEQUENCE_NUMBER_UNSUPPORTED) {
-    pub_seq_number = py::int_(message_info.publication_sequence_number);
+  const auto * members = this->members();
+
+  auto taken_msg = message_pool_->acquire();
+  rmw_message_info_t message_info;
+  rcl_ret_t ret = _take(rcl_subscription_.get(), taken_msg.get(), &message_info);
+  if (RCL_RET_OK != ret) {
+    if (RCL_RET_BAD_ALLOC == ret) {
+      rcl_reset_error();
+      throw std::bad_alloc();
+    }
+    if (RCL_RET_SUBSCRIPTION_TAKE_FAILED == ret) {
+      return py::none();
+    }
+    throw RCLError("failed to take message from subscription");
   }
-  py::object rec_seq_number = py::none();
-  if (message_info.reception_sequence_number != RMW_MESSAGE_INFO_SEQUENCE_NUMBER_UNSUPPORTED) {
-    rec_seq_number = py::int_(message_info.reception_sequence_number);
+
+  update_py_message(taken_msg.get(), members, pymsg);
+  return _convert_to_py_message_info(message_info);
+}
+
+py::object
+Subscription::take_message_with_array_views(py::object pymsg_type)
+{
+  type_support_.check_type(pymsg_type);
+  const auto * members = this->members();
+
+  // Not taken from the pool since the views own the message
+  std::shared_ptr<void> taken_msg = type_support_.create();
+  rmw_message_info_t message_info;
+  rcl_ret_t ret = _take(rcl_subscription_.get(), taken_msg.get(), &message_info);
+  if (RCL_RET_OK != ret) {
+    if (RCL_RET_BAD_ALLOC == ret) {
+      rcl_reset_error();
+      throw std::bad_alloc();
+    }
+    if (RCL_RET_SUBSCRIPTION_TAKE_FAILED == ret) {
+      return py::none();
+    }
+    throw RCLError("failed to take message from subscription");
   }
+
   return py::make_tuple(
-    pytaken_msg, py::dict(
-      "source_timestamp"_a = message_info.source_timestamp,
-      "received_timestamp"_a = message_info.received_timestamp,
-      "publication_sequence_number"_a = pub_seq_number,
-      "reception_sequence_number"_a = rec_seq_number));
+    convert_to_py_with_array_views(type_support_, members, taken_msg),
+    _convert_to_py_message_info(message_info));
+}
+
+size_t
+Subscription::take_messages_into_array(py::object pyarray, py::object pytimestamps)
+{
+  const auto * members = this->members();
+  if (!has_fixed_layout(members)) {
+    throw py::value_error("message type of the subscription doesn't have a fixed layout");
+  }
+
+  rcl_ret_t deferred_ret = RCL_RET_OK;
+  std::string deferred_error;
+  {
+    std::lock_guard<std::mutex> lock(deferred_array_take_mutex_);
+    std::swap(deferred_ret, deferred_array_take_ret_);
+    deferred_error.swap(deferred_array_take_error_);
+  }
+  if (RCL_RET_OK != deferred_ret) {
+    if (RCL_RET_BAD_ALLOC == deferred_ret) {
+      throw std::bad_alloc();
+    }
+    RCL_SET_ERROR_MSG(deferred_error.c_str());
+    throw RCLError("failed to take message from subscription");
+  }
+
+  BufferView rows(pyarray, true);
+  const size_t row_size = members->size_of_;
+  if (rows.size() % row_size) {
+    throw py::value_error("array size is not a multiple of the message size");
+  }
+  const size_t max_n = rows.size() / row_size;
+  std::unique_ptr<BufferView> timestamps;
+  if (!pytimestamps.is_none()) {
+    timestamps = std::make_unique<BufferView>(pytimestamps, true);
+    if (timestamps->size() < max_n * sizeof(int64_t)) {
+      throw py::value_error("timestamps buffer is smaller than the array");
+    }
+  }
+
+  // Rows are only taken into in place when they are aligned like C messages
+  std::unique_ptr<void, destroy_ros_message_function *> unaligned_msg(
+    nullptr, type_support_.destroy_function());
+  if (reinterpret_cast<uintptr_t>(rows.data()) % alignof(std::max_align_t)) {
+    unaligned_msg = type_support_.create();
+  }
+
+  size_t n = 0u;
+  rcl_ret_t ret = RCL_RET_OK;
+  {
+    py::gil_scoped_release gil_release;
+    for (; n < max_n; ++n) {
+      uint8_t * row = rows.data() + n * row_size;
+      rmw_message_info_t message_info;
+      ret = rcl_take(
+        rcl_subscription_.get(), unaligned_msg ? unaligned_msg.get() : row, &message_info, NULL);
+      if (RCL_RET_OK != ret) {
+        break;
+      }
+      if (unaligned_msg) {
+        std::memcpy(row, unaligned_msg.get(), row_size);
+      }
+      if (timestamps) {
+        std::memcpy(
+          timestamps->data() + n * sizeof(int64_t), &message_info.received_timestamp,
+          sizeof(int64_t));
+      }
+    }
+  }
+  if (RCL_RET_OK != ret && RCL_RET_SUBSCRIPTION_TAKE_FAILED != ret) {
+    if (n > 0u) {
+      // Hand out the messages already taken, they would be lost otherwise
+      std::lock_guard<std::mutex> lock(deferred_array_take_mutex_);
+      deferred_array_take_ret_ = ret;
+      deferred_array_take_error_ = rcl_get_error_string().str;
+      rcl_reset_error();
+      return n;
+    }
+    if (RCL_RET_BAD_ALLOC == ret) {
+      rcl_reset_error();
+      throw std::bad_alloc();
+    }
+    throw RCLError("failed to take message from subscription");
+  }
+  return n;
+}
+
+bool
+Subscription::take_serialized()
+{
+  if (!raw_take_) {
+    raw_take_ = std::make_shared<RawTake>(rcutils_get_default_allocator());
+  }
+  if (raw_take_->pending) {
+    raw_take_->pending = false;
+    return true;
+  }
+
+  raw_take_->message.prepare();
+  rcl_ret_t ret;
+  {
+    py::gil_scoped_release gil_release;
+    ret = rcl_take_serialized_message(
+      rcl_subscription_.get(), &raw_take_->message.rcl_msg(), &raw_take_->message_info, NULL);
+  }
+  if (RCL_RET_OK != ret) {
+    if (RCL_RET_BAD_ALLOC == ret) {
+      rcl_reset_error();
+      throw std::bad_alloc();
+    }
+    if (RCL_RET_SUBSCRIPTION_TAKE_FAILED == ret) {
+      return false;
+    }
+    throw RCLError("failed to take raw message from subscription");
+  }
+  raw_take_->message.record_length();
+  return true;
+}
+
+py::object
+Subscription::take_raw_into(py::object pybuffer)
+{
+  BufferView buffer(pybuffer, true);
+  auto lock = lock_releasing_gil(raw_take_mutex_);
+  if (!take_serialized()) {
+    return py::none();
+  }
+  const rcl_serialized_message_t & taken = raw_take_->message.rcl_msg();
+  const auto length = static_cast<py::ssize_t>(taken.buffer_length);
+  if (taken.buffer_length > buffer.size()) {
+    // Keep the message for the next take
+    raw_take_->pending = true;
+    return py::make_tuple(-length, py::none());
+  }
+  std::memcpy(buffer.data(), taken.buffer, taken.buffer_length);
+  return py::make_tuple(length, _convert_to_py_message_info(raw_take_->message_info));
+}
+
+Subscription::TakeSequence::TakeSequence(size_t capacity, MessagePool & pool)
+: messages(rmw_get_zero_initialized_message_sequence()),
+  message_infos(rmw_get_zero_initialized_message_info_sequence())
+{
+  taken_msgs.reserve(capacity);
+  for (size_t i = 0u; i < capacity; ++i) {
+    taken_msgs.push_back(pool.acquire());
+  }
+  rcutils_allocator_t allocator = rcutils_get_default_allocator();
+  if (RMW_RET_OK != rmw_message_sequence_init(&messages, capacity, &allocator)) {
+    throw RMWError("failed to initialize message sequence");
+  }
+  if (RMW_RET_OK != rmw_message_info_sequence_init(&message_infos, capacity, &allocator)) {
+    RMWError error("failed to initialize message info sequence");
+    if (RMW_RET_OK != rmw_message_sequence_fini(&messages)) {
+      rmw_reset_error();
+    }
+    throw error;
+  }
+  for (size_t i = 0u; i < capacity; ++i) {
+    messages.data[i] = taken_msgs[i].get();
+  }
+}
+
+Subscription::TakeSequence::~TakeSequence()
+{
+  if (RMW_RET_OK != rmw_message_sequence_fini(&messages)) {
+    rmw_reset_error();
+  }
+  if (RMW_RET_OK != rmw_message_info_sequence_fini(&message_infos)) {
+    rmw_reset_error();
+  }
+}
+
+/// Pack message infos into rows of source timestamp, received timestamp and sequence numbers
+static py::object
+_convert_to_py_message_infos(const std::vector<rmw_message_info_t> & message_infos)
+{
+  constexpr size_t num_columns = 4u;
+  auto buffer = py::reinterpret_steal<py::bytes>(
+    PyBytes_FromStringAndSize(
+      nullptr,
+      static_cast<Py_ssize_t>(message_infos.size() * num_columns * sizeof(int64_t))));
+  if (!buffer) {
+    throw py::error_already_set();
+  }
+  char * data = PyBytes_AS_STRING(buffer.ptr());
+  for (const rmw_message_info_t & message_info : message_infos) {
+    const int64_t row[num_columns] = {
+      message_info.source_timestamp,
+      message_info.received_timestamp,
+      static_cast<int64_t>(message_info.publication_sequence_number),
+      static_cast<int64_t>(message_info.reception_sequence_number)};
+    std::memcpy(data, row, sizeof(row));
+    data += sizeof(row);
+  }
+  py::list shape;
+  shape.append(message_infos.size());
+  shape.append(num_columns);
+  return py::memoryview(buffer).attr("cast")("q", shape);
+}
+
+py::object
+Subscription::take_messages(py::object pymsg_type, size_t max_n, bool raw)
+{
+  if (0u == max_n) {
+    throw py::value_error("max_n must be greater than zero");
+  }
+
+  py::list pytaken_msgs;
+  std::vector<rmw_message_info_t> message_infos;
+  message_infos.reserve(max_n);
+
+  if (raw) {
+    auto lock = lock_releasing_gil(raw_take_mutex_);
+    while (message_infos.size() < max_n && take_serialized()) {
+      const rcl_serialized_message_t & taken = raw_take_->message.rcl_msg();
+      pytaken_msgs.append(
+        py::bytes(reinterpret_cast<const char *>(taken.buffer), taken.buffer_length));
+      message_infos.push_back(raw_take_->message_info);
+    }
+  } else {
+    type_support_.check_type(pymsg_type);
+    bool taken_as_sequence = false;
+    if (take_sequence_supported_.load()) {
+      auto lock = lock_releasing_gil(take_sequence_mutex_);
+      if (!take_sequence_ || take_sequence_->messages.capacity < max_n) {
+        take_sequence_.reset();
+        take_sequence_ = std::make_unique<TakeSequence>(max_n, *message_pool_);
+      }
+      rmw_message_sequence_t & message_sequence = take_sequence_->messages;
+      rmw_message_info_sequence_t & message_info_sequence = take_sequence_->message_infos;
+
+      rcl_ret_t ret;
+      {
+        py::gil_scoped_release gil_release;
+        ret = rcl_take_sequence(
+          rcl_subscription_.get(), max_n, &message_sequence, &message_info_sequence, NULL);
+      }
+      if (RCL_RET_UNSUPPORTED == ret) {
+        // Don't try again, take the messages one by one from now on
+        rcl_reset_error();
+        take_sequence_supported_.store(false);
+        take_sequence_.reset();
+      } else if (RCL_RET_SUBSCRIPTION_TAKE_FAILED == ret) {
+        return py::none();
+      } else if (RCL_RET_OK != ret) {
+        if (RCL_RET_BAD_ALLOC == ret) {
+          rcl_reset_error();
+          throw std::bad_alloc();
+        }
+        throw RCLError("failed to take messages from subscription");
+      } else {
+        taken_as_sequence = true;
+        for (size_t i = 0u; i < message_sequence.size; ++i) {
+          pytaken_msgs.append(type_support_.convert_to_py(message_sequence.data[i]));
+          message_infos.push_back(message_info_sequence.data[i]);
+        }
+      }
+    }
+
+    if (!taken_as_sequence) {
+      // Every message is converted before the next one is taken into the same C message
+      auto taken_msg = message_pool_->acquire();
+      while (message_infos.size() < max_n) {
+        rmw_message_info_t message_info;
+        rcl_ret_t ret = _take(rcl_subscription_.get(), taken_msg.get(), &message_info);
+        if (RCL_RET_SUBSCRIPTION_TAKE_FAILED == ret) {
+          break;
+        }
+        if (RCL_RET_OK != ret) {
+          if (RCL_RET_BAD_ALLOC == ret) {
+            rcl_reset_error();
+            throw std::bad_alloc();
+          }
+          throw RCLError("failed to take message from subscription");
+        }
+        pytaken_msgs.append(type_support_.convert_to_py(taken_msg.get()));
+        message_infos.push_back(message_info);
+      }
+    }
+  }
+
+  if (message_infos.empty()) {
+    return py::none();
+  }
+  return py::make_tuple(pytaken_msgs, _convert_to_py_message_infos(message_infos));
 }
 
 const char *
@@ -181,11 +606,55 @@ Subscription::get_publisher_count() const
   return count;
 }
 
+Subscription::Gid
+Subscription::to_gid(py::bytes gid)
+{
+  std::string data = gid;
+  if (data.size() != RMW_GID_STORAGE_SIZE) {
+    throw py::value_error("publisher identifier has the wrong size");
+  }
+  Gid result;
+  std::memcpy(result.data(), data.data(), RMW_GID_STORAGE_SIZE);
+  return result;
+}
+
+void
+Subscription::ignore_publisher(py::bytes gid)
+{
+  Gid ignored = to_gid(gid);
+  std::lock_guard<std::mutex> lock(ignored_publishers_mutex_);
+  ignored_publishers_.push_back(ignored);
+}
+
+void
+Subscription::unignore_publisher(py::bytes gid)
+{
+  Gid ignored = to_gid(gid);
+  std::lock_guard<std::mutex> lock(ignored_publishers_mutex_);
+  auto it = std::find(ignored_publishers_.begin(), ignored_publishers_.end(), ignored);
+  if (it != ignored_publishers_.end()) {
+    ignored_publishers_.erase(it);
+  }
+}
+
+bool
+Subscription::is_ignored(const rmw_message_info_t & message_info)
+{
+  std::lock_guard<std::mutex> lock(ignored_publishers_mutex_);
+  for (const Gid & ignored : ignored_publishers_) {
+    if (0 == std::memcmp(ignored.data(), message_info.publisher_gid.data, RMW_GID_STORAGE_SIZE)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void
 define_subscription(py::object module)
 {
   py::class_<Subscription, Destroyable, std::shared_ptr<Subscription>>(module, "Subscription")
-  .def(py::init<Node &, py::object, std::string, py::object>())
+  .def(
+    py::init<Node &, py::object, std::string, py::object>())
   .def_property_readonly(
     "pointer", [](const Subscription & subscription) {
       return reinterpret_cast<size_t>(subscription.rcl_ptr());
@@ -194,6 +663,37 @@ define_subscription(py::object module)
   .def(
     "take_message", &Subscription::take_message,
     "Take a message and its metadata from a subscription")
+  .def(
+    "ignore_publisher", &Subscription::ignore_publisher,
+    "Drop the messages sent by a publisher when taking messages")
+  .def(
+    "unignore_publisher", &Subscription::unignore_publisher,
+    "Stop dropping the messages sent by a publisher")
+  .def(
+    "take_messages", &Subscription::take_messages,
+    "Take up to max_n messages and their metadata from a subscription",
+    py::arg("pymsg_type"), py::arg("max_n"), py::arg("raw") = false)
+  .def(
+    "take_loaned_message", &Subscription::take_loaned_message,
+    "Take a message loaned from the middleware and its metadata from a subscription")
+  .def(
+    "take_message_into", &Subscription::take_message_into,
+    "Take a message into an existing Python message and return its metadata")
+  .def(
+    "take_raw_into", &Subscription::take_raw_into,
+    "Take a serialized message into an existing buffer")
+  .def(
+    "take_message_with_array_views", &Subscription::take_message_with_array_views,
+    "Take a message whose primitive arrays are views of the taken C message")
+  .def(
+    "take_messages_into_array", &Subscription::take_messages_into_array,
+    "Take messages of fixed layout into the rows of an array of C messages",
+    py::arg("array"), py::arg("timestamps") = py::none())
+  .def(
+    "can_loan_messages", [](const Subscription & subscription) {
+      return rcl_subscription_can_loan_messages(subscription.rcl_ptr());
+    },
+    "Whether the middleware can loan messages to the subscription")
   .def(
     "get_logger_name", &Subscription::get_logger_name,
     "Get the name of the logger associated with the node of the subscription.")
@@ -18,12 +18,23 @@
 #include <pybind11/pybind11.h>
 
 #include <rcl/subscription.h>
+#include <rmw/message_sequence.h>
+#include <rmw/types.h>
+#include <rosidl_typesupport_introspection_c/message_introspection.h>
 
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "destroyable.hpp"
+#include "message_pool.hpp"
 #include "node.hpp"
+#include "serialization.hpp"
+#include "type_support.hpp"
 
 namespace py = pybind11;
 
@@ -53,8 +64,11 @@ public:
 
   /// Take a message and its metadata from a subscription
   /**
+   * Messages sent by an ignored publisher are dropped, see ignore_publisher().
+   *
    * Raises MemoryError if there was an error allocating memory
    * Raises RCLError if there was an error within rcl
+   * Raises TypeError if \p raw is False and \p pymsg_type is not the type of the subscription
    *
    * \param[in] pymsg_type Message type to be taken (i.e. a class).
    * \param[in] raw If True, return the message without de-serializing it.
@@ -65,6 +79,146 @@ public:
   py::object
   take_message(py::object pymsg_type, bool raw);
 
+  /// Take up to \p max_n messages and their metadata from a subscription
+  /**
+   * Messages are taken with rcl_take_sequence() if the rmw implementation supports it, into
+   * C messages kept by the subscription for the next batch takes.
+   * Otherwise they are taken one by one into a single C message, and serialized messages are
+   * always taken one by one.
+   *
+   * Raises MemoryError if there was an error allocating memory
+   * Raises RCLError if there was an error within rcl
+   * Raises ValueError if \p max_n is zero
+   * Raises TypeError if \p raw is False and \p pymsg_type is not the type of the subscription
+   *
+   * \param[in] pymsg_type Message type to be taken (i.e. a class).
+   * \param[in] max_n Maximum number of messages to take.
+   * \param[in] raw If True, return the messages without de-serializing them.
+   * \return Tuple of (messages, metadata) or None if there was no message to take.
+   *   Messages is a list of \p pymsg_type instances if \p raw is False, otherwise of byte
+   *   strings.
+   *   Metadata is a memoryview of signed 64-bit integers with one row per message and the
+   *   columns source timestamp, received timestamp, publication sequence number and reception
+   *   sequence number. Unsupported sequence numbers are 0.
+   */
+  py::object
+  take_messages(py::object pymsg_type, size_t max_n, bool raw);
+
+  /// Take a message loaned from the middleware and its metadata from a subscription
+  /**
+   * If the middleware can't loan messages to the subscription the message is taken into
+   * storage owned by the returned loaned message instead, so it's never copied twice.
+   *
+   * Raises MemoryError if there was an error allocating memory
+   * Raises RCLError if there was an error within rcl
+   * Raises RuntimeError if the message type has no introspection type support
+   * Raises TypeError if \p pymsg_type is not the type of the subscription
+   *
+   * \param[in] pymsg_type Message type to be taken (i.e. a class).
+   * \return Tuple of (message, metadata) or None if there was no message to take.
+   *   Message is a LoanedMessage, which returns the loan when it is released.
+   *   Metadata is a plain dictionary.
+   */
+  py::object
+  take_loaned_message(py::object pymsg_type);
+
+  /// Take a message into an existing Python message and return its metadata
+  /**
+   * The members of \p pymsg are updated in place, reusing the nested messages and arrays it
+   * already holds where possible.
+   *
+   * Raises MemoryError if there was an error allocating memory
+   * Raises RCLError if there was an error within rcl
+   * Raises RuntimeError if the message type has no introspection type support
+   * Raises TypeError if \p pymsg is not an instance of the type of the subscription
+   *
+   * \param[in] pymsg Instance of the message type to take the message into.
+   * \return The metadata as a plain dictionary, or None if there was no message to take, in
+   *   which case \p pymsg is left untouched.
+   */
+  py::object
+  take_message_into(py::object pymsg);
+
+  /// Take a serialized message into an existing buffer
+  /**
+   * Messages are taken into a serialized message kept by the subscription, whose buffer
+   * follows the size of the messages of the topic, and copied into \p pybuffer.
+   * If the message doesn't fit it is kept for the next raw take, so the call can be repeated
+   * with a large enough buffer.
+   *
+   * Raises MemoryError if there was an error allocating memory
+   * Raises RCLError if there was an error within rcl
+   * Raises BufferError if \p pybuffer is not a writable contiguous buffer
+   *
+   * \param[in] pybuffer An object exposing a writable buffer, e.g. a bytearray or memoryview.
+   * \return Tuple of (length, metadata) with the length of the message copied to the start of
+   *   the buffer, or of (-length, None) if the buffer is smaller than the message, or None if
+   *   there was no message to take.
+   */
+  py::object
+  take_raw_into(py::object pybuffer);
+
+  /// Take a message whose primitive arrays are views of the taken C message
+  /**
+   * Arrays and sequences of primitive types, including the ones of nested messages, are
+   * read-only memoryviews over the C message instead of converted copies.
+   * Each message is taken into its own C message, which is kept alive by the views.
+   *
+   * Raises TypeError if \p pymsg_type is not the message type of the subscription
+   * Raises MemoryError if there was an error allocating memory
+   * Raises RCLError if there was an error within rcl
+   *
+   * \param[in] pymsg_type Message type to be taken
+   * \return Tuple of (message, metadata) or None if there was no message to take.
+   */
+  py::object
+  take_message_with_array_views(py::object pymsg_type);
+
+  /// Take messages into the rows of an array of C messages
+  /**
+   * Only messages of fixed layout are supported, see has_fixed_layout().
+   * Each row of \p pyarray, typically a NumPy array of the data type returned by
+   * get_message_dtype(), is a C message which is taken into in place.
+   * Messages are taken until there is no message left or all rows were filled, without
+   * holding the GIL.
+   * If taking fails after some messages were taken, these are returned and the error is
+   * raised by the next call instead.
+   *
+   * Raises ValueError if the message type doesn't have a fixed layout, if the size of the
+   * array is not a multiple of the size of a message or if \p pytimestamps is too small
+   * Raises MemoryError if there was an error allocating memory
+   * Raises RCLError if there was an error within rcl
+   * Raises BufferError if a buffer is not writable and contiguous
+   *
+   * \param[in] pyarray An object exposing a writable buffer holding the rows
+   * \param[in] pytimestamps An object exposing a writable buffer of a signed 64 bit integer
+   *   per row, set to the time the message of the row was received at in nanoseconds, or None
+   * \return Number of messages taken, they are in the first rows
+   */
+  size_t
+  take_messages_into_array(py::object pyarray, py::object pytimestamps);
+
+  /// Drop the messages sent by a publisher when taking messages with take_message()
+  /**
+   * It is used for publishers already delivering their messages to the subscription within
+   * the process, which also send them through the middleware for remote subscriptions.
+   *
+   * Raises ValueError if \p gid is not the size of a publisher identifier
+   *
+   * \param[in] gid Global identifier of the publisher, see Publisher::get_gid().
+   */
+  void
+  ignore_publisher(py::bytes gid);
+
+  /// Stop dropping the messages sent by a publisher, see ignore_publisher()
+  /**
+   * Raises ValueError if \p gid is not the size of a publisher identifier
+   *
+   * \param[in] gid Global identifier of the publisher.
+   */
+  void
+  unignore_publisher(py::bytes gid);
+
   /// Get the name of the logger associated with the node of the subscription.
   /**
    *
@@ -107,7 +261,86 @@ public:
 
 private:
   Node node_;
+  TypeSupportHandle type_support_;
+  /// C messages reused by publishes and takes
+  std::shared_ptr<MessagePool> message_pool_;
   std::shared_ptr<rcl_subscription_t> rcl_subscription_;
+  /// Cleared once rcl_take_sequence() turned out to be unsupported by the rmw implementation
+  std::atomic<bool> take_sequence_supported_{true};
+  /// Introspection of the message type, looked up on the first take into a Python message
+  std::atomic<const rosidl_typesupport_introspection_c__MessageMembers *> members_{nullptr};
+
+  using Gid = std::array<uint8_t, RMW_GID_STORAGE_SIZE>;
+  /// Identifiers of the publishers whose messages are dropped by take_message()
+  std::vector<Gid> ignored_publishers_;
+  std::mutex ignored_publishers_mutex_;
+
+  /// Convert the bytes of a publisher identifier
+  static Gid
+  to_gid(py::bytes gid);
+
+  /// Check if a message was sent by an ignored publisher
+  bool
+  is_ignored(const rmw_message_info_t & message_info);
+
+  /// Get the introspection of the message type, looking it up if needed
+  const rosidl_typesupport_introspection_c__MessageMembers *
+  members();
+
+  /// Serialized message raw messages are taken into
+  struct RawTake
+  {
+    explicit RawTake(rcutils_allocator_t allocator)
+    : message(allocator) {}
+
+    ReusedSerializedMessage message;
+    rmw_message_info_t message_info;
+    /// Whether the message was taken but not handed out yet
+    bool pending = false;
+  };
+
+  /// Take a serialized message into raw_take_, return false if there was no message
+  /**
+   * raw_take_mutex_ must be held until the taken message is handed out.
+   */
+  bool
+  take_serialized();
+
+  /// Serializes raw takes from several threads
+  std::mutex raw_take_mutex_;
+  /// Created on the first raw take
+  std::shared_ptr<RawTake> raw_take_;
+
+  /// Sequences messages are taken into by rcl_take_sequence()
+  struct TakeSequence
+  {
+    /// Initialize sequences of a capacity pointing to messages acquired from a pool
+    /**
+     * Raises RMWError if the sequences could not be initialized
+     */
+    TakeSequence(size_t capacity, MessagePool & pool);
+
+    ~TakeSequence();
+
+    TakeSequence(const TakeSequence &) = delete;
+    TakeSequence & operator=(const TakeSequence &) = delete;
+
+    rmw_message_sequence_t messages;
+    rmw_message_info_sequence_t message_infos;
+    /// The messages the message sequence points to, given back to the pool with the sequences
+    std::vector<MessagePool::Message> taken_msgs;
+  };
+
+  /// Serializes batch takes into take_sequence_ from several threads
+  std::mutex take_sequence_mutex_;
+  /// Created on the first batch take, and again when a batch take needs more capacity
+  std::unique_ptr<TakeSequence> take_sequence_;
+
+  /// Guards the deferred error, takes into arrays may run in several threads
+  std::mutex deferred_array_take_mutex_;
+  /// Error of a take into an array that already took messages, raised by the next such take
+  rcl_ret_t deferred_array_take_ret_ = RCL_RET_OK;
+  std::string deferred_array_take_error_;
 };
 /// Define a pybind11 wrapper for an rclpy::Service
 void define_subscription(py::object module);
@@ -32,6 +32,11 @@ namespace py = pybind11;
 namespace rclpy
 {
 
+/// A timer of a context, driven by a clock
+/**
+ * The timer has no lock of its own: the rcl timer functions it uses are thread safe, the
+ * state of the timer being kept in atomics.
+ */
 class Timer : public Destroyable, public std::enable_shared_from_this<Timer>
 {
 public:
@@ -0,0 +1,103 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <pybind11/pybind11.h>
+
+#include <rosidl_runtime_c/message_type_support_struct.h>
+
+#include <memory>
+#include <string>
+
+#include "type_support.hpp"
+
+namespace rclpy
+{
+namespace
+{
+template<typename FunctionT>
+FunctionT *
+get_capsule_function(py::handle pymetaclass, const char * name)
+{
+  py::object value = pymetaclass.attr(name);
+  if (value.is_none()) {
+    std::string error_text{"type support of message type was not imported, missing "};
+    error_text += name;
+    throw py::value_error(error_text);
+  }
+  return reinterpret_cast<FunctionT *>(static_cast<void *>(value.cast<py::capsule>()));
+}
+}  // namespace
+
+TypeSupportHandle::TypeSupportHandle(py::object pymsg_type)
+: pymsg_type_(pymsg_type)
+{
+  py::object pymetaclass = pymsg_type.attr("__class__");
+  type_support_ = get_capsule_function<const rosidl_message_type_support_t>(
+    pymetaclass, "_TYPE_SUPPORT");
+  create_ros_message_ = get_capsule_function<create_ros_message_function>(
+    pymetaclass, "_CREATE_ROS_MESSAGE");
+  destroy_ros_message_ = get_capsule_function<destroy_ros_message_function>(
+    pymetaclass, "_DESTROY_ROS_MESSAGE");
+  convert_from_py_ = get_capsule_function<convert_from_py_function>(
+    pymetaclass, "_CONVERT_FROM_PY");
+  convert_to_py_ = get_capsule_function<convert_to_py_function>(
+    pymetaclass, "_CONVERT_TO_PY");
+}
+
+void
+TypeSupportHandle::check_type(py::handle pymsg_type) const
+{
+  if (!pymsg_type.is(pymsg_type_)) {
+    throw py::type_error(
+            "expected message type " + py::str(pymsg_type_).cast<std::string>() + ", got " +
+            py::str(pymsg_type).cast<std::string>());
+  }
+}
+
+std::unique_ptr<void, destroy_ros_message_function *>
+TypeSupportHandle::create() const
+{
+  void * message = create_ros_message_();
+  if (!message) {
+    throw std::bad_alloc();
+  }
+  return std::unique_ptr<void, destroy_ros_message_function *>(message, destroy_ros_message_);
+}
+
+std::unique_ptr<void, destroy_ros_message_function *>
+TypeSupportHandle::convert_from_py(py::handle pymsg) const
+{
+  auto message = create();
+  convert_from_py(pymsg, message.get());
+  return message;
+}
+
+void
+TypeSupportHandle::convert_from_py(py::handle pymsg, void * message) const
+{
+  if (!convert_from_py_(pymsg.ptr(), message)) {
+    throw py::error_already_set();
+  }
+}
+
+py::object
+TypeSupportHandle::convert_to_py(void * message) const
+{
+  PyObject * pymsg = convert_to_py_(message);
+  if (!pymsg) {
+    throw py::error_already_set();
+  }
+  return py::reinterpret_steal<py::object>(pymsg);
+}
+}  // namespace rclpy
@@ -0,0 +1,140 @@
+// Copyright 2026 Open Source Robotics Foundation, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef RCLPY__TYPE_SUPPORT_HPP_
+#define RCLPY__TYPE_SUPPORT_HPP_
+
+#include <pybind11/pybind11.h>
+
+#include <rosidl_runtime_c/message_type_support_struct.h>
+
+#include <memory>
+
+namespace py = pybind11;
+
+namespace rclpy
+{
+typedef void * create_ros_message_function (void);
+typedef void destroy_ros_message_function (void *);
+
+/// Type support of a ROS message Python type, resolved once
+/**
+ * The generated Python message types expose their type support and the functions to create,
+ * destroy and convert C messages as capsules on their metaclass.
+ * Looking them up costs several attribute lookups and capsule casts, so entities resolve them
+ * once when they are created instead of for every message.
+ */
+class TypeSupportHandle
+{
+public:
+  /// Resolve the type support of a message type
+  /**
+   * Raises AttributeError if \p pymsg_type is missing a required attribute
+   * Raises ValueError if the type support of \p pymsg_type was not imported
+   *
+   * \param[in] pymsg_type ROS message Python type
+   */
+  explicit TypeSupportHandle(py::object pymsg_type);
+
+  /// Get the message type the handle was resolved from
+  py::object
+  pymsg_type() const
+  {
+    return pymsg_type_;
+  }
+
+  /// Get the type support structure of the message type
+  const rosidl_message_type_support_t *
+  type_support() const
+  {
+    return type_support_;
+  }
+
+  /// Check that a message type is the one the handle was resolved from
+  /**
+   * Raises TypeError if it is another type
+   *
+   * \param[in] pymsg_type ROS message Python type
+   */
+  void
+  check_type(py::handle pymsg_type) const;
+
+  /// Get the function creating a C message of the message type
+  create_ros_message_function *
+  create_function() const
+  {
+    return create_ros_message_;
+  }
+
+  /// Get the function destroying a C message of the message type
+  destroy_ros_message_function *
+  destroy_function() const
+  {
+    return destroy_ros_message_;
+  }
+
+  /// Create a C message initialized to its default values
+  /**
+   * Raises MemoryError if the message cannot be allocated
+   */
+  std::unique_ptr<void, destroy_ros_message_function *>
+  create() const;
+
+  /// Convert a Python message to a new C message
+  /**
+   * Raises any exception raised by the conversion
+   *
+   * \param[in] pymsg An instance of the message type
+   */
+  std::unique_ptr<void, destroy_ros_message_function *>
+  convert_from_py(py::handle pymsg) const;
+
+  /// Convert a Python message into an existing C message
+  /**
+   * Every member of the C message is overwritten.
+   * Sequences are initialized without being finalized first, so the sequences of the C
+   * message, including the ones of its nested messages, must be empty or their storage leaks.
+   *
+   * Raises any exception raised by the conversion
+   *
+   * \param[in] pymsg An instance of the message type
+   * \param[out] message A C message of the message type
+   */
+  void
+  convert_from_py(py::handle pymsg, void * message) const;
+
+  /// Convert a C message to a new Python message
+  /**
+   * Raises any exception raised by the conversion
+   *
+   * \param[in] message A C message of the message type
+   * \return an instance of the message type
+   */
+  py::object
+  convert_to_py(void * message) const;
+
+private:
+  typedef bool convert_from_py_function (PyObject *, void *);
+  typedef PyObject * convert_to_py_function (void *);
+
+  py::object pymsg_type_;
+  const rosidl_message_type_support_t * type_support_;
+  create_ros_message_function * create_ros_message_;
+  destroy_ros_message_function * destroy_ros_message_;
+  convert_from_py_function * convert_from_py_;
+  convert_to_py_function * convert_to_py_;
+};
+}  // namespace rclpy
+
+#endif  // RCLPY__TYPE_SUPPORT_HPP_
@@ -139,6 +139,22 @@ convert_to_py(void * message, py::object pyclass)
   return py::reinterpret_steal<py::object>(convert(message));
 }
 
+BufferView::BufferView(py::handle pyobject, bool writable)
+{
+  int flags = PyBUF_C_CONTIGUOUS;
+  if (writable) {
+    flags |= PyBUF_WRITABLE;
+  }
+  if (PyObject_GetBuffer(pyobject.ptr(), &view_, flags) != 0) {
+    throw py::error_already_set();
+  }
+}
+
+BufferView::~BufferView()
+{
+  PyBuffer_Release(&view_);
+}
+
 const char *
 get_rmw_implementation_identifier()
 {
@@ -22,17 +22,18 @@
 #include <rmw/topic_endpoint_info.h>
 #include <rmw/types.h>
 
+#include <cstdint>
 #include <memory>
+#include <mutex>
 
 #include "publisher.hpp"
+#include "type_support.hpp"
 
 namespace py = pybind11;
 
 namespace rclpy
 {
 
-typedef void destroy_ros_message_function (void *);
-
 /// Convert a C rcl_names_and_types_t into a Python list.
 /**
  * \param[in] topic_names_and_types The names and types struct to convert.
@@ -81,6 +82,46 @@ convert_from_py(py::object pyclass);
 py::object
 convert_to_py(void * message, py::object pyclass);
 
+/// A view of the contiguous memory of an object supporting the buffer protocol
+/**
+ * The memory is valid and the object can't be resized as long as the view exists.
+ */
+class BufferView
+{
+public:
+  /// Get a view of the memory of an object
+  /**
+   * Raises BufferError or TypeError if the object doesn't expose contiguous memory, or
+   * writable memory if \p writable is True
+   *
+   * \param[in] pyobject An object supporting the buffer protocol
+   * \param[in] writable Whether the memory is written to
+   */
+  BufferView(py::handle pyobject, bool writable);
+
+  ~BufferView();
+
+  BufferView(const BufferView &) = delete;
+  BufferView & operator=(const BufferView &) = delete;
+
+  /// Get the start of the memory
+  uint8_t *
+  data() const
+  {
+    return static_cast<uint8_t *>(view_.buf);
+  }
+
+  /// Get the size of the memory in bytes
+  size_t
+  size() const
+  {
+    return static_cast<size_t>(view_.len);
+  }
+
+private:
+  Py_buffer view_;
+};
+
 /// Return the identifier of the current rmw_implementation
 /**
  * \return string containing the identifier of the current rmw_implementation
@@ -157,6 +198,31 @@ convert_to_qos_dict(const rmw_qos_profile_t * qos_profile);
  */
 py::dict
 convert_to_type_hash_dict(const rosidl_type_hash_t * type_hash);
+
+/// Lock a mutex, releasing the GIL while blocked on it
+/**
+ * Blocking on the mutex while holding the GIL would deadlock with a thread holding the mutex
+ * and waiting for the GIL.
+ * Without a GIL, detaching from the interpreter lets it stop the world meanwhile.
+ *
+ * \param[in] mutex The mutex to lock
+ * \return The lock owning the mutex
+ */
+template<typename MutexT>
+std::unique_lock<MutexT>
+lock_releasing_gil(MutexT & mutex)
+{
+  std::unique_lock<MutexT> lock(mutex, std::try_to_lock);
+  if (!lock.owns_lock()) {
+    if (PyGILState_Check()) {
+      py::gil_scoped_release gil_release;
+      lock.lock();
+    } else {
+      lock.lock();
+    }
+  }
+  return lock;
+}
 }  // namespace rclpy
 
 #endif  // RCLPY__UTILS_HPP_
@@ -18,12 +18,16 @@
 #include <rcl/types.h>
 #include <rcl/wait.h>
 
+#include <algorithm>
+#include <cstdint>
 #include <cstring>
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include "exceptions.hpp"
+#include "utils.hpp"
 #include "wait_set.hpp"
 
 namespace rclpy
@@ -71,9 +75,27 @@ WaitSet::WaitSet(
   }
 }
 
+WaitSet::~WaitSet()
+{
+  release_attached_entities();
+}
+
+std::unique_lock<std::recursive_mutex>
+WaitSet::lock_not_waiting()
+{
+  auto lock = lock_releasing_gil(mutex_);
+  if (waiting_) {
+    py::gil_scoped_release gil_release;
+    wait_done_.wait(lock, [this]() {return !waiting_;});
+  }
+  return lock;
+}
+
 void
 WaitSet::destroy()
 {
+  auto lock = lock_not_waiting();
+  release_attached_entities();
   rcl_wait_set_.reset();
   context_.destroy();
 }
@@ -81,6 +103,7 @@ WaitSet::destroy()
 void
 WaitSet::clear_entities()
 {
+  auto lock = lock_not_waiting();
   rcl_ret_t ret = rcl_wait_set_clear(rcl_wait_set_.get());
   if (ret != RCL_RET_OK) {
     throw RCLError("failed to clear wait set");
@@ -90,6 +113,7 @@ WaitSet::clear_entities()
 size_t
 WaitSet::add_service(const Service & service)
 {
+  auto lock = lock_not_waiting();
   size_t index;
   rcl_ret_t ret = rcl_wait_set_add_service(rcl_wait_set_.get(), service.rcl_ptr(), &index);
   if (RCL_RET_OK != ret) {
@@ -101,6 +125,7 @@ WaitSet::add_service(const Service & service)
 size_t
 WaitSet::add_subscription(const Subscription & subscription)
 {
+  auto lock = lock_not_waiting();
   size_t index;
   rcl_ret_t ret = rcl_wait_set_add_subscription(
     rcl_wait_set_.get(), subscription.rcl_ptr(), &index);
@@ -113,6 +138,7 @@ WaitSet::add_subscription(const Subscription & subscription)
 size_t
 WaitSet::add_timer(const Timer & timer)
 {
+  auto lock = lock_not_waiting();
   size_t index;
   rcl_ret_t ret = rcl_wait_set_add_timer(rcl_wait_set_.get(), timer.rcl_ptr(), &index);
   if (RCL_RET_OK != ret) {
@@ -124,6 +150,7 @@ WaitSet::add_timer(const Timer & timer)
 size_t
 WaitSet::add_guard_condition(const GuardCondition & gc)
 {
+  auto lock = lock_not_waiting();
   size_t index;
   rcl_ret_t ret = rcl_wait_set_add_guard_condition(rcl_wait_set_.get(), gc.rcl_ptr(), &index);
   if (RCL_RET_OK != ret) {
@@ -135,6 +162,7 @@ WaitSet::add_guard_condition(const GuardCondition & gc)
 size_t
 WaitSet::add_client(const Client & client)
 {
+  auto lock = lock_not_waiting();
   size_t index;
   rcl_ret_t ret = rcl_wait_set_add_client(rcl_wait_set_.get(), client.rcl_ptr(), &index);
   if (RCL_RET_OK != ret) {
@@ -146,6 +174,7 @@ WaitSet::add_client(const Client & client)
 size_t
 WaitSet::add_event(const EventHandle & event)
 {
+  auto lock = lock_not_waiting();
   size_t index;
   rcl_ret_t ret = rcl_wait_set_add_event(rcl_wait_set_.get(), event.rcl_ptr(), &index);
   if (RCL_RET_OK != ret) {
@@ -154,9 +183,214 @@ WaitSet::add_event(const EventHandle & event)
   return index;
 }
 
+void
+WaitSet::resize(
+  size_t number_of_subscriptions,
+  size_t number_of_guard_conditions,
+  size_t number_of_timers,
+  size_t number_of_clients,
+  size_t number_of_services,
+  size_t number_of_events)
+{
+  auto lock = lock_not_waiting();
+  if (number_of_subscriptions == rcl_wait_set_->size_of_subscriptions &&
+    number_of_guard_conditions == rcl_wait_set_->size_of_guard_conditions &&
+    number_of_timers == rcl_wait_set_->size_of_timers &&
+    number_of_clients == rcl_wait_set_->size_of_clients &&
+    number_of_services == rcl_wait_set_->size_of_services &&
+    number_of_events == rcl_wait_set_->size_of_events)
+  {
+    // Capacity didn't change, so there is no need to reallocate anything
+    return;
+  }
+
+  rcl_ret_t ret = rcl_wait_set_resize(
+    rcl_wait_set_.get(),
+    number_of_subscriptions,
+    number_of_guard_conditions,
+    number_of_timers,
+    number_of_clients,
+    number_of_services,
+    number_of_events);
+  if (RCL_RET_OK != ret) {
+    throw RCLError("failed to resize wait set");
+  }
+}
+
+template<typename EntityT>
+size_t
+_attach_entity(
+  std::vector<std::shared_ptr<EntityT>> & attached, std::shared_ptr<EntityT> entity)
+{
+  // Block destruction of the entity for as long as it is part of the wait set
+  entity->enter();
+  attached.push_back(std::move(entity));
+  return attached.size() - 1u;
+}
+
+template<typename EntityT>
+void
+_detach_entity(
+  std::vector<std::shared_ptr<EntityT>> & attached, const std::shared_ptr<EntityT> & entity,
+  bool waiting, std::vector<std::shared_ptr<Destroyable>> & detached_while_waiting)
+{
+  auto it = std::find(attached.begin(), attached.end(), entity);
+  if (attached.end() == it) {
+    throw py::value_error("entity is not attached to the wait set");
+  }
+  attached.erase(it);
+  if (waiting) {
+    // The wait in progress may still use the entity
+    detached_while_waiting.push_back(entity);
+    return;
+  }
+  entity->exit(py::none(), py::none(), py::none());
+}
+
+size_t
+WaitSet::attach(std::shared_ptr<Subscription> subscription)
+{
+  auto lock = lock_releasing_gil(mutex_);
+  return _attach_entity(attached_subscriptions_, std::move(subscription));
+}
+
+size_t
+WaitSet::attach(std::shared_ptr<GuardCondition> gc)
+{
+  auto lock = lock_releasing_gil(mutex_);
+  return _attach_entity(attached_guard_conditions_, std::move(gc));
+}
+
+size_t
+WaitSet::attach(std::shared_ptr<Timer> timer)
+{
+  auto lock = lock_releasing_gil(mutex_);
+  return _attach_entity(attached_timers_, std::move(timer));
+}
+
+size_t
+WaitSet::attach(std::shared_ptr<Client> client)
+{
+  auto lock = lock_releasing_gil(mutex_);
+  return _attach_entity(attached_clients_, std::move(client));
+}
+
+size_t
+WaitSet::attach(std::shared_ptr<Service> service)
+{
+  auto lock = lock_releasing_gil(mutex_);
+  return _attach_entity(attached_services_, std::move(service));
+}
+
+size_t
+WaitSet::attach(std::shared_ptr<EventHandle> event)
+{
+  auto lock = lock_releasing_gil(mutex_);
+  return _attach_entity(attached_events_, std::move(event));
+}
+
+void
+WaitSet::detach(std::shared_ptr<Subscription> subscription)
+{
+  auto lock = lock_releasing_gil(mutex_);
+  _detach_entity(attached_subscriptions_, subscription, waiting_, detached_while_waiting_);
+}
+
+void
+WaitSet::detach(std::shared_ptr<GuardCondition> gc)
+{
+  auto lock = lock_releasing_gil(mutex_);
+  _detach_entity(attached_guard_conditions_, gc, waiting_, detached_while_waiting_);
+}
+
+void
+WaitSet::detach(std::shared_ptr<Timer> timer)
+{
+  auto lock = lock_releasing_gil(mutex_);
+  _detach_entity(attached_timers_, timer, waiting_, detached_while_waiting_);
+}
+
+void
+WaitSet::detach(std::shared_ptr<Client> client)
+{
+  auto lock = lock_releasing_gil(mutex_);
+  _detach_entity(attached_clients_, client, waiting_, detached_while_waiting_);
+}
+
+void
+WaitSet::detach(std::shared_ptr<Service> service)
+{
+  auto lock = lock_releasing_gil(mutex_);
+  _detach_entity(attached_services_, service, waiting_, detached_while_waiting_);
+}
+
+void
+WaitSet::detach(std::shared_ptr<EventHandle> event)
+{
+  auto lock = lock_releasing_gil(mutex_);
+  _detach_entity(attached_events_, event, waiting_, detached_while_waiting_);
+}
+
+template<typename EntityT>
+void
+_release_entities(std::vector<std::shared_ptr<EntityT>> & attached)
+{
+  // Swap first so the wait set never refers to an entity that has been destroyed by exit()
+  std::vector<std::shared_ptr<EntityT>> entities;
+  entities.swap(attached);
+  for (auto & entity : entities) {
+    entity->exit(py::none(), py::none(), py::none());
+  }
+}
+
+void
+WaitSet::release_attached_entities()
+{
+  _release_entities(attached_subscriptions_);
+  _release_entities(attached_guard_conditions_);
+  _release_entities(attached_timers_);
+  _release_entities(attached_clients_);
+  _release_entities(attached_services_);
+  _release_entities(attached_events_);
+}
+
+void
+WaitSet::rebuild()
+{
+  auto lock = lock_not_waiting();
+  resize(
+    std::max(rcl_wait_set_->size_of_subscriptions, attached_subscriptions_.size()),
+    std::max(rcl_wait_set_->size_of_guard_conditions, attached_guard_conditions_.size()),
+    std::max(rcl_wait_set_->size_of_timers, attached_timers_.size()),
+    std::max(rcl_wait_set_->size_of_clients, attached_clients_.size()),
+    std::max(rcl_wait_set_->size_of_services, attached_services_.size()),
+    std::max(rcl_wait_set_->size_of_events, attached_events_.size()));
+
+  clear_entities();
+  for (const auto & subscription : attached_subscriptions_) {
+    add_subscription(*subscription);
+  }
+  for (const auto & gc : attached_guard_conditions_) {
+    add_guard_condition(*gc);
+  }
+  for (const auto & timer : attached_timers_) {
+    add_timer(*timer);
+  }
+  for (const auto & client : attached_clients_) {
+    add_client(*client);
+  }
+  for (const auto & service : attached_services_) {
+    add_service(*service);
+  }
+  for (const auto & event : attached_events_) {
+    add_event(*event);
+  }
+}
+
 bool
 WaitSet::is_ready(const std::string & entity_type, size_t index)
 {
+  auto lock = lock_not_waiting();
   const void ** entities = NULL;
   size_t num_entities = 0;
   if ("subscription" == entity_type) {
@@ -213,6 +447,7 @@ _get_ready_entities(const EntityArray ** entities, const size_t num_entities)
 py::list
 WaitSet::get_ready_entities(const std::string & entity_type)
 {
+  auto lock = lock_not_waiting();
   if ("subscription" == entity_type) {
     return _get_ready_entities(
       rcl_wait_set_->subscriptions, rcl_wait_set_->size_of_subscriptions);
@@ -236,9 +471,55 @@ WaitSet::get_ready_entities(const std::string & entity_type)
   throw std::runtime_error(error_text);
 }
 
+template<typename EntityArray>
+py::object
+_get_ready_indices(const EntityArray ** entities, const size_t num_entities)
+{
+  size_t num_ready = 0u;
+  for (size_t i = 0u; i < num_entities; ++i) {
+    if (entities[i]) {
+      ++num_ready;
+    }
+  }
+
+  // Fill a bytes object in place and expose it as an array of indices
+  auto buffer = py::reinterpret_steal<py::bytes>(
+    PyBytes_FromStringAndSize(nullptr, static_cast<Py_ssize_t>(num_ready * sizeof(uint64_t))));
+  if (!buffer) {
+    throw py::error_already_set();
+  }
+  char * data = PyBytes_AS_STRING(buffer.ptr());
+  for (size_t i = 0u; i < num_entities; ++i) {
+    if (entities[i]) {
+      const uint64_t index = i;
+      std::memcpy(data, &index, sizeof(index));
+      data += sizeof(index);
+    }
+  }
+  return py::memoryview(buffer).attr("cast")("Q");
+}
+
+py::tuple
+WaitSet::get_ready_indices()
+{
+  auto lock = lock_not_waiting();
+  return py::make_tuple(
+    _get_ready_indices(rcl_wait_set_->subscriptions, rcl_wait_set_->size_of_subscriptions),
+    _get_ready_indices(
+      rcl_wait_set_->guard_conditions, rcl_wait_set_->size_of_guard_conditions),
+    _get_ready_indices(rcl_wait_set_->timers, rcl_wait_set_->size_of_timers),
+    _get_ready_indices(rcl_wait_set_->clients, rcl_wait_set_->size_of_clients),
+    _get_ready_indices(rcl_wait_set_->services, rcl_wait_set_->size_of_services),
+    _get_ready_indices(rcl_wait_set_->events, rcl_wait_set_->size_of_events));
+}
+
 void
 WaitSet::wait(int64_t timeout)
 {
+  auto lock = lock_not_waiting();
+  waiting_ = true;
+  // Entities can be attached and detached during the wait
+  lock.unlock();
   rcl_ret_t ret;
 
   // Could be a long wait, release the GIL
@@ -247,6 +528,16 @@ WaitSet::wait(int64_t timeout)
     ret = rcl_wait(rcl_wait_set_.get(), timeout);
   }
 
+  std::vector<std::shared_ptr<Destroyable>> detached;
+  lock = lock_releasing_gil(mutex_);
+  waiting_ = false;
+  detached.swap(detached_while_waiting_);
+  lock.unlock();
+  wait_done_.notify_all();
+  for (auto & entity : detached) {
+    entity->exit(py::none(), py::none(), py::none());
+  }
+
   if (RCL_RET_OK != ret && RCL_RET_TIMEOUT != ret) {
     throw RCLError("failed to wait on wait set");
   }
@@ -282,12 +573,57 @@ void define_waitset(py::object module)
   .def(
     "add_event", &WaitSet::add_event,
     "Add an event to the wait set structure")
+  .def(
+    "resize", &WaitSet::resize,
+    "Resize the wait set if the capacity changed")
+  .def(
+    "attach", py::overload_cast<std::shared_ptr<Subscription>>(&WaitSet::attach),
+    "Attach a subscription to the wait set until it is detached")
+  .def(
+    "attach", py::overload_cast<std::shared_ptr<GuardCondition>>(&WaitSet::attach),
+    "Attach a guard condition to the wait set until it is detached")
+  .def(
+    "attach", py::overload_cast<std::shared_ptr<Timer>>(&WaitSet::attach),
+    "Attach a timer to the wait set until it is detached")
+  .def(
+    "attach", py::overload_cast<std::shared_ptr<Client>>(&WaitSet::attach),
+    "Attach a client to the wait set until it is detached")
+  .def(
+    "attach", py::overload_cast<std::shared_ptr<Service>>(&WaitSet::attach),
+    "Attach a service to the wait set until it is detached")
+  .def(
+    "attach", py::overload_cast<std::shared_ptr<EventHandle>>(&WaitSet::attach),
+    "Attach an event to the wait set until it is detached")
+  .def(
+    "detach", py::overload_cast<std::shared_ptr<Subscription>>(&WaitSet::detach),
+    "Detach a subscription from the wait set")
+  .def(
+    "detach", py::overload_cast<std::shared_ptr<GuardCondition>>(&WaitSet::detach),
+    "Detach a guard condition from the wait set")
+  .def(
+    "detach", py::overload_cast<std::shared_ptr<Timer>>(&WaitSet::detach),
+    "Detach a timer from the wait set")
+  .def(
+    "detach", py::overload_cast<std::shared_ptr<Client>>(&WaitSet::detach),
+    "Detach a client from the wait set")
+  .def(
+    "detach", py::overload_cast<std::shared_ptr<Service>>(&WaitSet::detach),
+    "Detach a service from the wait set")
+  .def(
+    "detach", py::overload_cast<std::shared_ptr<EventHandle>>(&WaitSet::detach),
+    "Detach an event from the wait set")
+  .def(
+    "rebuild", &WaitSet::rebuild,
+    "Clear the wait set and add all attached entities back to it")
   .def(
     "is_ready", &WaitSet::is_ready,
     "Check if an entity in the wait set is ready by its index")
   .def(
     "get_ready_entities", &WaitSet::get_ready_entities,
     "Get list of entities ready by entity type")
+  .def(
+    "get_ready_indices", &WaitSet::get_ready_indices,
+    "Get the indices of the ready entities of every kind at once")
   .def(
     "wait", &WaitSet::wait,
     "Wait until timeout is reached or event happened");
@@ -19,8 +19,11 @@
 
 #include <rcl/wait.h>
 
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "client.hpp"
 #include "context.hpp"
@@ -35,6 +38,12 @@ namespace py = pybind11;
 
 namespace rclpy
 {
+/// A wait set which may be used from several threads
+/**
+ * Its methods are serialized.
+ * The lock is released while waiting, so entities can be attached and detached meanwhile,
+ * while the methods using the rcl wait set block until the wait returns.
+ */
 class WaitSet : public Destroyable, public std::enable_shared_from_this<WaitSet>
 {
 public:
@@ -62,6 +71,9 @@ public:
     size_t number_of_events,
     Context & context);
 
+  /// Detach all attached entities and destroy the wait set
+  ~WaitSet();
+
   /// Clear all the pointers in the wait set
   /**
    * Raises RCLError if any rcl error occurs
@@ -129,6 +141,136 @@ public:
   size_t
   add_event(const EventHandle & event);
 
+  /// Resize the wait set
+  /**
+   * Storage is only reallocated when the requested sizes differ from the current ones.
+   * Resizing clears all the pointers in the wait set.
+   *
+   * Raises RCLError if the wait set could not be resized
+   *
+   * \param[in] number_of_subscriptions a positive number or zero
+   * \param[in] number_of_guard_conditions int
+   * \param[in] number_of_timers int
+   * \param[in] number_of_clients int
+   * \param[in] number_of_services int
+   * \param[in] number_of_events int
+   */
+  void
+  resize(
+    size_t number_of_subscriptions,
+    size_t number_of_guard_conditions,
+    size_t number_of_timers,
+    size_t number_of_clients,
+    size_t number_of_services,
+    size_t number_of_events);
+
+  /// Attach a subscription to the wait set until it is detached
+  /**
+   * Attached entities are kept in use, so they can't be destroyed while they are part of the
+   * wait set, and they are added back to the wait set every time rebuild() is called.
+   *
+   * Raises InvalidHandle if the subscription is being destroyed
+   *
+   * \param[in] subscription A subscription to attach to the wait set
+   * \return Index the subscription will have in the wait set after rebuild()
+   */
+  size_t
+  attach(std::shared_ptr<Subscription> subscription);
+
+  /// Attach a guard condition to the wait set until it is detached
+  /**
+   * \sa attach(std::shared_ptr<Subscription>)
+   */
+  size_t
+  attach(std::shared_ptr<GuardCondition> gc);
+
+  /// Attach a timer to the wait set until it is detached
+  /**
+   * \sa attach(std::shared_ptr<Subscription>)
+   */
+  size_t
+  attach(std::shared_ptr<Timer> timer);
+
+  /// Attach a client to the wait set until it is detached
+  /**
+   * \sa attach(std::shared_ptr<Subscription>)
+   */
+  size_t
+  attach(std::shared_ptr<Client> client);
+
+  /// Attach a service to the wait set until it is detached
+  /**
+   * \sa attach(std::shared_ptr<Subscription>)
+   */
+  size_t
+  attach(std::shared_ptr<Service> service);
+
+  /// Attach an event to the wait set until it is detached
+  /**
+   * \sa attach(std::shared_ptr<Subscription>)
+   */
+  size_t
+  attach(std::shared_ptr<EventHandle> event);
+
+  /// Detach a subscription that was previously attached
+  /**
+   * Entities attached after this one move down by one index.
+   * If destruction of the subscription was requested while attached, it happens now, or when
+   * the wait in progress returns.
+   *
+   * Raises ValueError if the subscription is not attached
+   *
+   * \param[in] subscription A subscription to detach from the wait set
+   */
+  void
+  detach(std::shared_ptr<Subscription> subscription);
+
+  /// Detach a guard condition that was previously attached
+  /**
+   * \sa detach(std::shared_ptr<Subscription>)
+   */
+  void
+  detach(std::shared_ptr<GuardCondition> gc);
+
+  /// Detach a timer that was previously attached
+  /**
+   * \sa detach(std::shared_ptr<Subscription>)
+   */
+  void
+  detach(std::shared_ptr<Timer> timer);
+
+  /// Detach a client that was previously attached
+  /**
+   * \sa detach(std::shared_ptr<Subscription>)
+   */
+  void
+  detach(std::shared_ptr<Client> client);
+
+  /// Detach a service that was previously attached
+  /**
+   * \sa detach(std::shared_ptr<Subscription>)
+   */
+  void
+  detach(std::shared_ptr<Service> service);
+
+  /// Detach an event that was previously attached
+  /**
+   * \sa detach(std::shared_ptr<Subscription>)
+   */
+  void
+  detach(std::shared_ptr<EventHandle> event);
+
+  /// Clear the wait set and add all attached entities back to it
+  /**
+   * Entities are added in the order they were attached, so their indices in the wait set
+   * are the ones returned by attach().
+   * The wait set only grows if it is too small to hold the attached entities.
+   *
+   * Raises RCLError if any lower level error occurs
+   */
+  void
+  rebuild();
+
   /// Check if an entity in the wait set is ready by its index
   /**
    * This must be called after waiting on the wait set.
@@ -152,6 +294,18 @@ public:
   py::list
   get_ready_entities(const std::string & entity_type);
 
+  /// Get the indices of the ready entities of every kind at once
+  /**
+   * This must be called after waiting on the wait set.
+   * The indices are the ones returned when the entities were added to the wait set.
+   *
+   * \return Tuple of read-only memoryviews of unsigned 64-bit integers holding the indices
+   *   of the ready subscriptions, guard conditions, timers, clients, services and events,
+   *   in that order
+   */
+  py::tuple
+  get_ready_indices();
+
   /// Wait until timeout is reached or event happened
   /**
    * Raises RCLError if there was an error while waiting
@@ -173,8 +327,35 @@ public:
   void destroy() override;
 
 private:
+  /// Detach all attached entities
+  void
+  release_attached_entities();
+
+  /// Lock the mutex once no wait is in progress, for methods using the rcl wait set
+  /**
+   * Must not be called with the mutex already locked, waiting for the end of the wait
+   * unlocks it once only.
+   */
+  std::unique_lock<std::recursive_mutex>
+  lock_not_waiting();
+
   Context context_;
+  /// Serializes the methods, recursive since rebuild() calls the other ones
+  std::recursive_mutex mutex_;
+  /// Set while rcl_wait() runs without the mutex, the rcl wait set must not be used meanwhile
+  bool waiting_ = false;
+  /// Notified when waiting_ is cleared
+  std::condition_variable_any wait_done_;
+  /// Entities detached during the wait, kept in use until it returns
+  std::vector<std::shared_ptr<Destroyable>> detached_while_waiting_;
   std::shared_ptr<rcl_wait_set_t> rcl_wait_set_;
+
+  std::vector<std::shared_ptr<Subscription>> attached_subscriptions_;
+  std::vector<std::shared_ptr<GuardCondition>> attached_guard_conditions_;
+  std::vector<std::shared_ptr<Timer>> attached_timers_;
+  std::vector<std::shared_ptr<Client>> attached_clients_;
+  std::vector<std::shared_ptr<Service>> attached_services_;
+  std::vector<std::shared_ptr<EventHandle>> attached_events_;
 };
 
 /// Define a pybind11 wrapper for an rclpy::Service
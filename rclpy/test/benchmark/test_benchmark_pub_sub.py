@@ -0,0 +1,76 @@
+# Copyright 2026 Open Source Robotics Foundation, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""
+Micro-benchmarks of the per-message overhead of publishing and taking small messages.
+
+They use the ``benchmark`` fixture of pytest-benchmark and are skipped if it is not installed.
+They are not part of the regular tests, configure with ``-DRCLPY_BENCHMARKS=ON`` to add them
+or run them directly, e.g. ``python3 -m pytest test/benchmark``.
+"""
+
+import time
+
+import pytest
+
+import rclpy
+from rclpy.qos import QoSProfile
+from rclpy.qos import QoSReliabilityPolicy
+
+from test_msgs.msg import BasicTypes
+from test_msgs.msg import Empty
+
+pytest.importorskip('pytest_benchmark')
+
+
+@pytest.fixture
+def node():
+    context = rclpy.context.Context()
+    rclpy.init(context=context)
+    node = rclpy.create_node('benchmark_pub_sub', context=context)
+    yield node
+    node.destroy_node()
+    rclpy.shutdown(context=context)
+
+
+@pytest.mark.parametrize('msg_type', [Empty, BasicTypes])
+def test_publish(benchmark, node, msg_type):
+    pub = node.create_publisher(msg_type, 'benchmark_publish', 10)
+    msg = msg_type()
+
+    benchmark(pub.publish, msg)
+    pub.destroy()
+
+
+@pytest.mark.parametrize('msg_type', [Empty, BasicTypes])
+def test_publish_and_take(benchmark, node, msg_type):
+    qos = QoSProfile(depth=10, reliability=QoSReliabilityPolicy.RELIABLE)
+    pub = node.create_publisher(msg_type, 'benchmark_publish_and_take', qos)
+    sub = node.create_subscription(msg_type, 'benchmark_publish_and_take', lambda msg: None, qos)
+    msg = msg_type()
+
+    end_time = time.monotonic() + 5
+    while pub.get_subscription_count() != 1:
+        time.sleep(0.05)
+        assert time.monotonic() <= end_time  # timeout waiting for pub/sub to discover each other
+
+    def publish_and_take():
+        pub.publish(msg)
+        end_time = time.monotonic() + 5
+        while sub.handle.take_message(msg_type, False) is None:
+            assert time.monotonic() <= end_time  # timeout waiting for the message
+
+    benchmark(publish_and_take)
+    pub.destroy()
+    sub.destroy()
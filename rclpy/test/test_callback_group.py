@@ -12,6 +12,7 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import threading
 import time
 import unittest
 
@@ -146,6 +147,45 @@ class TestCallbackGroup(unittest.TestCase):
         self.assertTrue(group.can_execute(t2))
         self.assertTrue(group.beginning_execution(t2))
 
+    def test_mutually_exclusive_group_ending_other_entity(self):
+        group = MutuallyExclusiveCallbackGroup()
+        t1 = self.node.create_timer(1.0, lambda: None, callback_group=group)
+        t2 = self.node.create_timer(1.0, lambda: None, callback_group=group)
+
+        self.assertTrue(group.beginning_execution(t1))
+        with self.assertRaises(RuntimeError):
+            group.ending_execution(t2)
+        # The group is still claimed by the first entity
+        self.assertFalse(group.can_execute(t2))
+        group.ending_execution(t1)
+        self.assertTrue(group.can_execute(t2))
+
+    def test_mutually_exclusive_group_concurrent_beginning(self):
+        group = MutuallyExclusiveCallbackGroup()
+        timers = [
+            self.node.create_timer(1.0, lambda: None, callback_group=group) for _ in range(4)]
+        barrier = threading.Barrier(len(timers))
+        active = []
+        overlaps = []
+
+        def execute(timer):
+            barrier.wait()
+            for _ in range(1000):
+                if group.beginning_execution(timer):
+                    active.append(timer)
+                    if len(active) > 1:
+                        overlaps.append(len(active))
+                    active.remove(timer)
+                    group.ending_execution(timer)
+
+        threads = [threading.Thread(target=execute, args=(timer,)) for timer in timers]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+        self.assertEqual(overlaps, [])
+        self.assertTrue(group.can_execute(timers[0]))
+
     def test_create_timer_with_group(self):
         tmr1 = self.node.create_timer(1.0, lambda: None)
         group = ReentrantCallbackGroup()
@@ -20,12 +20,24 @@ import unittest
 import warnings
 
 import rclpy
+from rclpy.callback_groups import MutuallyExclusiveCallbackGroup
+from rclpy.callback_groups import ReentrantCallbackGroup
+from rclpy.event_handler import SubscriptionEventCallbacks
+from rclpy.executors import EventsExecutor
 from rclpy.executors import Executor
+from rclpy.executors import ExternalShutdownException
 from rclpy.executors import MultiThreadedExecutor
+from rclpy.executors import NativeMultiThreadedExecutor
+from rclpy.executors import NativeSingleThreadedExecutor
+from rclpy.executors import ShardedExecutor
 from rclpy.executors import ShutdownException
 from rclpy.executors import SingleThreadedExecutor
+from rclpy.executors import StaticSingleThreadedExecutor
 from rclpy.task import Future
 
+from test_msgs.msg import BasicTypes
+from test_msgs.srv import Empty
+
 
 class TestExecutor(unittest.TestCase):
 
@@ -94,7 +106,10 @@ class TestExecutor(unittest.TestCase):
 
     def test_shutdown_executor_before_waiting_for_callbacks(self):
         self.assertIsNotNone(self.node.handle)
-        for cls in [SingleThreadedExecutor, MultiThreadedExecutor]:
+        for cls in [
+                SingleThreadedExecutor, MultiThreadedExecutor, StaticSingleThreadedExecutor,
+                NativeSingleThreadedExecutor, NativeMultiThreadedExecutor, EventsExecutor,
+                ShardedExecutor]:
             executor = cls(context=self.context)
             executor.shutdown()
             with self.assertRaises(ShutdownException):
@@ -102,7 +117,10 @@ class TestExecutor(unittest.TestCase):
 
     def test_shutdown_exception_from_callback_generator(self):
         self.assertIsNotNone(self.node.handle)
-        for cls in [SingleThreadedExecutor, MultiThreadedExecutor]:
+        for cls in [
+                SingleThreadedExecutor, MultiThreadedExecutor, StaticSingleThreadedExecutor,
+                NativeSingleThreadedExecutor, NativeMultiThreadedExecutor, EventsExecutor,
+                ShardedExecutor]:
             executor = cls(context=self.context)
             cb_generator = executor._wait_for_ready_callbacks()
             executor.shutdown()
@@ -166,6 +184,492 @@ class TestExecutor(unittest.TestCase):
         finally:
             executor.shutdown()
 
+    def test_static_single_threaded_executor_executes(self):
+        self.assertIsNotNone(self.node.handle)
+        executor = StaticSingleThreadedExecutor(context=self.context)
+        try:
+            self.assertTrue(self.func_execution(executor))
+        finally:
+            executor.shutdown()
+
+    def test_static_single_threaded_executor_entity_changes(self):
+        self.assertIsNotNone(self.node.handle)
+        executor = StaticSingleThreadedExecutor(context=self.context)
+        try:
+            executor.add_node(self.node)
+            executor.spin_once(timeout_sec=0)
+
+            calls = 0
+
+            def timer_callback():
+                nonlocal calls
+                calls += 1
+
+            # A timer created after the first spin gets attached to the wait set
+            tmr = self.node.create_timer(0.01, timer_callback)
+            executor.spin_once(timeout_sec=1)
+            self.assertEqual(1, calls)
+            executor.spin_once(timeout_sec=1)
+            self.assertEqual(2, calls)
+
+            # A destroyed timer gets detached from the wait set
+            self.node.destroy_timer(tmr)
+            executor.spin_once(timeout_sec=0.1)
+            self.assertEqual(2, calls)
+            self.assertEqual(0, tmr.handle.pointer)
+        finally:
+            executor.shutdown()
+
+    def test_static_single_threaded_executor_busy_group(self):
+        self.assertIsNotNone(self.node.handle)
+        for cls in [StaticSingleThreadedExecutor, NativeSingleThreadedExecutor]:
+            executor = cls(context=self.context)
+            group = MutuallyExclusiveCallbackGroup()
+            future = Future()
+            coroutine_calls = 0
+            timer_calls = 0
+            num_dispatches = 0
+
+            async def coroutine_callback():
+                nonlocal coroutine_calls
+                coroutine_calls += 1
+                await future
+
+            def timer_callback():
+                nonlocal timer_calls
+                timer_calls += 1
+
+            wait_and_dispatch = executor._wait_and_dispatch
+
+            def counting_wait_and_dispatch(timeout_nsec):
+                nonlocal num_dispatches
+                num_dispatches += 1
+                return wait_and_dispatch(timeout_nsec)
+
+            executor._wait_and_dispatch = counting_wait_and_dispatch
+            coroutine_tmr = self.node.create_timer(0.01, coroutine_callback, group)
+            tmr = self.node.create_timer(0.01, timer_callback, group)
+            try:
+                executor.add_node(self.node)
+                end_time = time.monotonic() + 5
+                while coroutine_calls == 0:
+                    self.assertLess(time.monotonic(), end_time)
+                    executor.spin_once(timeout_sec=0.1)
+
+                # The entities of the group aren't waited on while the coroutine holds it
+                executor.spin_once(timeout_sec=0)
+                timer_calls_before = timer_calls
+                num_dispatches = 0
+                executor.spin_once(timeout_sec=0.5)
+                self.assertEqual(timer_calls_before, timer_calls)
+                self.assertLess(num_dispatches, 5)
+
+                future.set_result(None)
+                while timer_calls == timer_calls_before:
+                    self.assertLess(time.monotonic(), end_time)
+                    executor.spin_once(timeout_sec=0.1)
+            finally:
+                self.node.destroy_timer(coroutine_tmr)
+                self.node.destroy_timer(tmr)
+                executor.shutdown()
+
+    def test_static_single_threaded_executor_external_shutdown(self):
+        self.assertIsNotNone(self.node.handle)
+        for cls in [
+                StaticSingleThreadedExecutor, NativeSingleThreadedExecutor,
+                NativeMultiThreadedExecutor, EventsExecutor, ShardedExecutor]:
+            context = rclpy.context.Context()
+            rclpy.init(context=context)
+            node = rclpy.create_node('TestExternalShutdown', namespace='/rclpy', context=context)
+            executor = cls(context=context)
+            executor.add_node(node)
+
+            def spin():
+                try:
+                    executor.spin()
+                except ExternalShutdownException:
+                    pass
+
+            thread = threading.Thread(target=spin, daemon=True)
+            try:
+                thread.start()
+                # Let spin() block in its wait before the context is shut down
+                time.sleep(0.1)
+                rclpy.shutdown(context=context)
+                thread.join(timeout=5)
+                self.assertFalse(thread.is_alive(), cls.__name__)
+            finally:
+                executor.shutdown()
+                node.destroy_node()
+                if context.ok():
+                    rclpy.shutdown(context=context)
+                context.destroy()
+
+    def test_native_single_threaded_executor_executes(self):
+        self.assertIsNotNone(self.node.handle)
+        executor = NativeSingleThreadedExecutor(context=self.context)
+        try:
+            self.assertTrue(self.func_execution(executor))
+        finally:
+            executor.shutdown()
+
+    def test_native_single_threaded_executor_coroutine(self):
+        self.assertIsNotNone(self.node.handle)
+        executor = NativeSingleThreadedExecutor(context=self.context)
+        future = Future(executor=executor)
+        did_callback = False
+        did_return = False
+
+        async def timer_callback():
+            nonlocal did_callback, did_return
+            did_callback = True
+            await future
+            did_return = True
+
+        tmr = self.node.create_timer(0.1, timer_callback)
+        try:
+            executor.add_node(self.node)
+            executor.spin_once(timeout_sec=1)
+            self.assertTrue(did_callback)
+            self.assertFalse(did_return)
+
+            tmr.cancel()
+            future.set_result(True)
+            executor.spin_once(timeout_sec=1)
+            self.assertTrue(did_return)
+        finally:
+            self.node.destroy_timer(tmr)
+            executor.shutdown()
+
+    def test_native_single_threaded_executor_service(self):
+        self.assertIsNotNone(self.node.handle)
+        executor = NativeSingleThreadedExecutor(context=self.context)
+        num_requests = 0
+
+        def service_callback(request, response):
+            nonlocal num_requests
+            num_requests += 1
+            # The response to the first request is missing, which is logged
+            return response if num_requests > 1 else None
+
+        srv = self.node.create_service(Empty, 'native_executor_service', service_callback)
+        cli = self.node.create_client(Empty, 'native_executor_service')
+        try:
+            executor.add_node(self.node)
+            self.assertTrue(cli.wait_for_service(timeout_sec=5))
+            future = cli.call_async(Empty.Request())
+            executor.spin_until_future_complete(future, timeout_sec=0.5)
+            self.assertEqual(1, num_requests)
+            self.assertFalse(future.done())
+
+            future = cli.call_async(Empty.Request())
+            executor.spin_until_future_complete(future, timeout_sec=5)
+            self.assertEqual(2, num_requests)
+            self.assertTrue(future.done())
+            self.assertIsInstance(future.result(), Empty.Response)
+        finally:
+            self.node.destroy_client(cli)
+            self.node.destroy_service(srv)
+            executor.shutdown()
+
+    def test_native_multi_threaded_executor_executes(self):
+        self.assertIsNotNone(self.node.handle)
+        executor = NativeMultiThreadedExecutor(context=self.context)
+        try:
+            self.assertTrue(self.func_execution(executor))
+        finally:
+            executor.shutdown()
+
+    def test_native_multi_threaded_executor_callback_groups(self):
+        self.assertIsNotNone(self.node.handle)
+        executor = NativeMultiThreadedExecutor(num_threads=4, context=self.context)
+        # Only passed if both timers of the reentrant group execute at the same time
+        barrier = threading.Barrier(2, timeout=5)
+        reentrant_calls = 0
+        lock = threading.Lock()
+        executing = 0
+        max_executing = 0
+        exclusive_calls = 0
+
+        def reentrant_callback():
+            nonlocal reentrant_calls
+            barrier.wait()
+            with lock:
+                reentrant_calls += 1
+
+        def exclusive_callback():
+            nonlocal executing, max_executing, exclusive_calls
+            with lock:
+                executing += 1
+                max_executing = max(max_executing, executing)
+            time.sleep(0.01)
+            with lock:
+                executing -= 1
+                exclusive_calls += 1
+
+        reentrant_group = ReentrantCallbackGroup()
+        exclusive_group = MutuallyExclusiveCallbackGroup()
+        timers = [
+            self.node.create_timer(0.1, reentrant_callback, reentrant_group),
+            self.node.create_timer(0.1, reentrant_callback, reentrant_group),
+            self.node.create_timer(0.01, exclusive_callback, exclusive_group),
+            self.node.create_timer(0.01, exclusive_callback, exclusive_group),
+        ]
+        try:
+            executor.add_node(self.node)
+            end_time = time.monotonic() + 5
+            while reentrant_calls < 2 or exclusive_calls < 10:
+                self.assertLess(time.monotonic(), end_time)
+                executor.spin_once(timeout_sec=0.1)
+            self.assertFalse(barrier.broken)
+            self.assertEqual(1, max_executing)
+        finally:
+            for tmr in timers:
+                self.node.destroy_timer(tmr)
+            executor.shutdown()
+
+    def test_native_multi_threaded_executor_shutdown_from_callback(self):
+        self.assertIsNotNone(self.node.handle)
+        executor = NativeMultiThreadedExecutor(num_threads=2, context=self.context)
+        called = threading.Event()
+        released = threading.Event()
+        shut_down = threading.Event()
+
+        def timer_callback():
+            if called.is_set():
+                return
+            called.set()
+            # Once nothing spins, the core is destroyed by the worker executing this callback
+            released.wait(timeout=5)
+            if executor.shutdown():
+                shut_down.set()
+
+        tmr = self.node.create_timer(0.01, timer_callback)
+        try:
+            executor.add_node(self.node)
+            end_time = time.monotonic() + 5
+            while not called.is_set():
+                self.assertLess(time.monotonic(), end_time)
+                executor.spin_once(timeout_sec=0.1)
+            released.set()
+            self.assertTrue(shut_down.wait(timeout=5))
+            # The worker that destroyed the core returns from the callback after it was released
+            time.sleep(0.1)
+        finally:
+            self.node.destroy_timer(tmr)
+            executor.shutdown()
+
+    def test_events_executor_executes(self):
+        self.assertIsNotNone(self.node.handle)
+        executor = EventsExecutor(context=self.context)
+        try:
+            self.assertTrue(self.func_execution(executor))
+        finally:
+            executor.shutdown()
+
+    def test_events_executor_releases_event_handlers(self):
+        self.assertIsNotNone(self.node.handle)
+        sub = self.node.create_subscription(
+            BasicTypes, 'events_executor_event_handlers_topic', lambda msg: None, 10,
+            event_callbacks=SubscriptionEventCallbacks(deadline=lambda event: None))
+        try:
+            self.assertEqual(1, len(sub.event_handlers))
+            handler = sub.event_handlers[0]
+            executor = EventsExecutor(context=self.context)
+            executor.add_node(self.node)
+            executor.spin_once(timeout_sec=0)
+            self.assertTrue(handler._in_events_queue)
+
+            # Removed handlers only take events when a wait set finds them ready
+            executor.remove_node(self.node)
+            executor.spin_once(timeout_sec=0)
+            self.assertFalse(handler._in_events_queue)
+
+            executor.add_node(self.node)
+            executor.spin_once(timeout_sec=0)
+            self.assertTrue(handler._in_events_queue)
+            executor.shutdown()
+            self.assertFalse(handler._in_events_queue)
+        finally:
+            self.node.destroy_subscription(sub)
+
+    def test_events_executor_entities(self):
+        self.assertIsNotNone(self.node.handle)
+        executor = EventsExecutor(context=self.context)
+        received = []
+        got_request = False
+        gc_calls = 0
+
+        def service_callback(request, response):
+            nonlocal got_request
+            got_request = True
+            return response
+
+        def gc_callback():
+            nonlocal gc_calls
+            gc_calls += 1
+
+        sub = self.node.create_subscription(
+            BasicTypes, 'events_executor_topic', lambda msg: received.append(msg), 10)
+        pub = self.node.create_publisher(BasicTypes, 'events_executor_topic', 10)
+        srv = self.node.create_service(Empty, 'events_executor_service', service_callback)
+        cli = self.node.create_client(Empty, 'events_executor_service')
+        gc = self.node.create_guard_condition(gc_callback)
+        try:
+            executor.add_node(self.node)
+            executor.spin_once(timeout_sec=0)
+
+            # The executor is woken up by a guard condition triggered through rclpy
+            gc.trigger()
+            executor.spin_once(timeout_sec=5)
+            self.assertEqual(1, gc_calls)
+
+            # Every message received gets a callback
+            end_time = time.time() + 5
+            while pub.get_subscription_count() == 0:
+                self.assertLess(time.time(), end_time)
+                time.sleep(0.05)
+            for i in range(3):
+                pub.publish(BasicTypes(int32_value=i))
+            while len(received) < 3:
+                self.assertLess(time.time(), end_time)
+                executor.spin_once(timeout_sec=0.1)
+            self.assertEqual([0, 1, 2], [msg.int32_value for msg in received])
+
+            self.assertTrue(cli.wait_for_service(timeout_sec=5))
+            future = cli.call_async(Empty.Request())
+            executor.spin_until_future_complete(future, timeout_sec=5)
+            self.assertTrue(got_request)
+            self.assertIsInstance(future.result(), Empty.Response)
+
+            # A destroyed subscription is removed from the events queue
+            self.node.destroy_subscription(sub)
+            executor.spin_once(timeout_sec=0)
+            self.assertEqual(0, sub.handle.pointer)
+        finally:
+            self.node.destroy_guard_condition(gc)
+            self.node.destroy_client(cli)
+            self.node.destroy_service(srv)
+            self.node.destroy_publisher(pub)
+            executor.shutdown()
+
+    def test_sharded_executor_executes(self):
+        self.assertIsNotNone(self.node.handle)
+        executor = ShardedExecutor(context=self.context)
+        try:
+            self.assertTrue(self.func_execution(executor))
+        finally:
+            executor.shutdown()
+
+    def test_sharded_executor_isolates_nodes(self):
+        self.assertIsNotNone(self.node.handle)
+        other_node = rclpy.create_node(
+            'TestExecutorOther', namespace='/rclpy', context=self.context)
+        executor = ShardedExecutor(2, context=self.context)
+        other_called = threading.Event()
+        blocked_result = []
+        thread_names = set()
+
+        def blocking_callback():
+            thread_names.add(threading.current_thread().name)
+            # Only returns early if the other shard runs while this one is blocked
+            blocked_result.append(other_called.wait(timeout=5))
+
+        def other_callback():
+            thread_names.add(threading.current_thread().name)
+            other_called.set()
+
+        tmr = self.node.create_timer(0.1, blocking_callback)
+        other_tmr = other_node.create_timer(0.1, other_callback)
+        try:
+            self.assertTrue(executor.add_node(self.node, shard=0))
+            self.assertTrue(executor.add_node(other_node, shard=1))
+            self.assertEqual(0, executor.get_node_shard(self.node))
+            self.assertEqual(1, executor.get_node_shard(other_node))
+            self.assertIsNot(self.node.executor, other_node.executor)
+            end_time = time.monotonic() + 10
+            while not blocked_result:
+                self.assertLess(time.monotonic(), end_time)
+                executor.spin_once(timeout_sec=0.1)
+            self.assertTrue(blocked_result[0])
+            self.assertEqual(2, len(thread_names))
+        finally:
+            self.node.destroy_timer(tmr)
+            other_node.destroy_timer(other_tmr)
+            executor.shutdown()
+            other_node.destroy_node()
+
+    def test_sharded_executor_shutdown_timeout(self):
+        self.assertIsNotNone(self.node.handle)
+        executor = ShardedExecutor(context=self.context)
+        started = threading.Event()
+        release = threading.Event()
+
+        def blocking_callback():
+            started.set()
+            release.wait(timeout=10)
+
+        tmr = self.node.create_timer(0.1, blocking_callback)
+        try:
+            executor.add_node(self.node)
+            end_time = time.monotonic() + 10
+            while not started.is_set():
+                self.assertLess(time.monotonic(), end_time)
+                executor.spin_once(timeout_sec=0.1)
+
+            # The shard thread is still running the callback when the timeout expires
+            start = time.monotonic()
+            self.assertFalse(executor.shutdown(timeout_sec=0.1))
+            self.assertLess(time.monotonic() - start, 5)
+            release.set()
+            self.assertTrue(executor.shutdown(timeout_sec=10))
+        finally:
+            release.set()
+            self.node.destroy_timer(tmr)
+            executor.shutdown()
+
+    def test_sharded_executor_balances_nodes(self):
+        nodes = [
+            rclpy.create_node(
+                f'TestExecutorShard{i}', namespace='/rclpy', context=self.context,
+                start_parameter_services=False)
+            for i in range(4)]
+        for num_timers, node in zip([3, 1, 1, 5], nodes):
+            for _ in range(num_timers):
+                node.create_timer(1.0, lambda: None)
+        executor = ShardedExecutor(2, context=self.context)
+        try:
+            self.assertEqual(2, executor.num_shards)
+            for node in nodes[:3]:
+                self.assertTrue(executor.add_node(node))
+            # The heaviest node is alone in its shard
+            self.assertNotEqual(
+                executor.get_node_shard(nodes[0]), executor.get_node_shard(nodes[1]))
+            self.assertEqual(
+                executor.get_node_shard(nodes[1]), executor.get_node_shard(nodes[2]))
+            self.assertEqual(set(nodes[:3]), set(executor.get_nodes()))
+
+            # Removing it moves one of the other nodes to the empty shard
+            executor.remove_node(nodes[0])
+            self.assertIsNone(executor.get_node_shard(nodes[0]))
+            self.assertNotEqual(
+                executor.get_node_shard(nodes[1]), executor.get_node_shard(nodes[2]))
+
+            # A pinned node stays in its shard, the other nodes are moved away from it
+            pinned_shard = executor.get_node_shard(nodes[1])
+            self.assertTrue(executor.add_node(nodes[3], shard=pinned_shard))
+            self.assertEqual(pinned_shard, executor.get_node_shard(nodes[3]))
+            self.assertNotEqual(pinned_shard, executor.get_node_shard(nodes[1]))
+            executor.rebalance()
+            self.assertEqual(pinned_shard, executor.get_node_shard(nodes[3]))
+
+            with self.assertRaises(ValueError):
+                executor.add_node(self.node, shard=2)
+        finally:
+            executor.shutdown()
+            for node in nodes:
+                node.destroy_node()
+
     def test_add_node_to_executor(self):
         self.assertIsNotNone(self.node.handle)
         executor = SingleThreadedExecutor(context=self.context)
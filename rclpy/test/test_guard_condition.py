@@ -16,6 +16,7 @@ import unittest
 
 import rclpy
 from rclpy.executors import SingleThreadedExecutor
+from rclpy.impl.implementation_singleton import rclpy_implementation as _rclpy
 
 
 class TestGuardCondition(unittest.TestCase):
@@ -88,6 +89,24 @@ class TestGuardCondition(unittest.TestCase):
         self.node.destroy_guard_condition(gc1)
         self.node.destroy_guard_condition(gc2)
 
+    def test_wait_set_ready_indices(self):
+        gc1 = self.node.create_guard_condition(lambda: None)
+        gc2 = self.node.create_guard_condition(lambda: None)
+
+        with self.context.handle, gc1.handle, gc2.handle:
+            wait_set = _rclpy.WaitSet(0, 2, 0, 0, 0, 0, self.context.handle)
+            wait_set.add_guard_condition(gc1.handle)
+            wait_set.add_guard_condition(gc2.handle)
+            gc2.trigger()
+            wait_set.wait(0)
+            subs, guards, timers, clients, services, events = wait_set.get_ready_indices()
+            self.assertEqual([1], list(guards))
+            for indices in (subs, timers, clients, services, events):
+                self.assertEqual(0, len(indices))
+
+        self.node.destroy_guard_condition(gc1)
+        self.node.destroy_guard_condition(gc2)
+
 
 if __name__ == '__main__':
     unittest.main()
@@ -0,0 +1,240 @@
+# Copyright 2026 Open Source Robotics Foundation, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import time
+
+import pytest
+
+import rclpy
+from rclpy.executors import NativeSingleThreadedExecutor
+from rclpy.executors import SingleThreadedExecutor
+from rclpy.node import Node
+from rclpy.qos import DurabilityPolicy
+from rclpy.qos import QoSProfile
+from rclpy.serialization import serialize_message
+
+from test_msgs.msg import BasicTypes
+
+
+@pytest.fixture(scope='session', autouse=True)
+def setup_ros():
+    rclpy.init()
+
+
+def spin_until(executor, condition):
+    end_time = time.time() + 5
+    while not condition():
+        executor.spin_once(timeout_sec=0.1)
+        assert time.time() <= end_time  # timeout waiting for the messages
+
+
+@pytest.mark.parametrize('executor_type', [SingleThreadedExecutor, NativeSingleThreadedExecutor])
+def test_intra_process_delivery(executor_type):
+    topic_name = 'test_intra_process/test_intra_process_delivery/topic'
+    node = Node('test_node', use_intra_process_comms=True)
+    received1 = []
+    received2 = []
+    node.create_subscription(
+        BasicTypes, topic_name, lambda msg: received1.append(msg), 10)
+    node.create_subscription(
+        BasicTypes, topic_name, lambda msg, info: received2.append((msg, info)), 10)
+    pub = node.create_publisher(BasicTypes, topic_name, 10)
+
+    msg = BasicTypes()
+    msg.int32_value = 42
+    pub.publish(msg)
+
+    executor = executor_type()
+    executor.add_node(node)
+    spin_until(executor, lambda: received1 and received2)
+
+    # Every subscription gets its own copy of the published message
+    assert received1 == [msg]
+    assert received1[0] is not msg
+    taken, info = received2[0]
+    assert taken == msg
+    assert taken is not msg
+    assert taken is not received1[0]
+    assert info['source_timestamp'] > 0
+    assert info['publication_sequence_number'] is None
+
+    # Local subscriptions ignore the messages published through rmw
+    executor.spin_once(timeout_sec=0.1)
+    assert len(received1) == 1
+    assert len(received2) == 1
+
+    # A destroyed publisher is removed from the intra-process manager
+    intra_process_manager = node.context.intra_process_manager
+    assert intra_process_manager.has_matches(pub)
+    assert node.destroy_publisher(pub)
+    assert not intra_process_manager.has_matches(pub)
+
+    executor.shutdown()
+    node.destroy_node()
+
+
+def test_intra_process_publish_modified_message():
+    topic_name = 'test_intra_process/test_intra_process_publish_modified_message/topic'
+    node = Node('test_node', use_intra_process_comms=True)
+    received = []
+    node.create_subscription(
+        BasicTypes, topic_name, lambda msg: received.append(msg.int32_value), 10)
+    pub = node.create_publisher(BasicTypes, topic_name, 10)
+
+    # The same message object is modified and published again before being received
+    msg = BasicTypes()
+    msg.int32_value = 1
+    pub.publish(msg)
+    msg.int32_value = 2
+    pub.publish(msg)
+
+    executor = SingleThreadedExecutor()
+    executor.add_node(node)
+    spin_until(executor, lambda: len(received) == 2)
+    assert received == [1, 2]
+
+    executor.shutdown()
+    node.destroy_node()
+
+
+def test_intra_process_depth():
+    topic_name = 'test_intra_process/test_intra_process_depth/topic'
+    node = Node('test_node')
+    received = []
+    node.create_subscription(
+        BasicTypes, topic_name, lambda msg: received.append(msg.int32_value), 2,
+        use_intra_process_comms=True)
+    pub = node.create_publisher(BasicTypes, topic_name, 10, use_intra_process_comms=True)
+
+    for i in range(5):
+        pub.publish(BasicTypes(int32_value=i))
+
+    executor = SingleThreadedExecutor()
+    executor.add_node(node)
+    spin_until(executor, lambda: len(received) == 2)
+    executor.spin_once(timeout_sec=0.1)
+    assert received == [3, 4]
+
+    executor.shutdown()
+    node.destroy_node()
+
+
+def test_intra_process_remote_subscription():
+    topic_name = 'test_intra_process/test_intra_process_remote_subscription/topic'
+    node = Node('test_node')
+    local = []
+    remote = []
+    node.create_subscription(
+        BasicTypes, topic_name, lambda msg: local.append(msg), 10,
+        use_intra_process_comms=True)
+    sub = node.create_subscription(BasicTypes, topic_name, lambda msg: remote.append(msg), 10)
+    pub = node.create_publisher(BasicTypes, topic_name, 10, use_intra_process_comms=True)
+
+    end_time = time.time() + 5
+    while pub.get_subscription_count() != 2 or sub.get_publisher_count() != 1:
+        time.sleep(0.05)
+        assert time.time() <= end_time  # timeout waiting for pub/sub to discover each other
+
+    msg = BasicTypes(int32_value=7)
+    pub.publish(msg)
+
+    executor = SingleThreadedExecutor()
+    executor.add_node(node)
+    spin_until(executor, lambda: local and remote)
+    assert local[0] is msg
+    assert remote[0] == msg
+    assert remote[0] is not msg
+
+    executor.shutdown()
+    node.destroy_node()
+
+
+def test_intra_process_rmw_publisher():
+    topic_name = 'test_intra_process/test_intra_process_rmw_publisher/topic'
+    node = Node('test_node')
+    received = []
+    sub = node.create_subscription(
+        BasicTypes, topic_name, lambda msg: received.append(msg.int32_value), 10,
+        use_intra_process_comms=True)
+    # The intra-process publisher publishes through rmw as well for the other subscription
+    node.create_subscription(BasicTypes, topic_name, lambda msg: None, 10)
+    intra_pub = node.create_publisher(
+        BasicTypes, topic_name, 10, use_intra_process_comms=True)
+    rmw_pub = node.create_publisher(BasicTypes, topic_name, 10)
+
+    end_time = time.time() + 5
+    while sub.get_publisher_count() != 2 or intra_pub.get_subscription_count() != 2:
+        time.sleep(0.05)
+        assert time.time() <= end_time  # timeout waiting for pub/sub to discover each other
+
+    # Only the rmw messages of the intra-process publisher are ignored
+    intra_pub.publish(BasicTypes(int32_value=1))
+    rmw_pub.publish(BasicTypes(int32_value=2))
+
+    executor = SingleThreadedExecutor()
+    executor.add_node(node)
+    spin_until(executor, lambda: len(received) == 2)
+    executor.spin_once(timeout_sec=0.1)
+    assert sorted(received) == [1, 2]
+
+    executor.shutdown()
+    node.destroy_node()
+
+
+def test_intra_process_serialized_publish():
+    topic_name = 'test_intra_process/test_intra_process_serialized_publish/topic'
+    node = Node('test_node', use_intra_process_comms=True)
+    received = []
+    node.create_subscription(
+        BasicTypes, topic_name, lambda msg: received.append(msg.int32_value), 10)
+    pub = node.create_publisher(BasicTypes, topic_name, 10)
+
+    pub.publish(serialize_message(BasicTypes(int32_value=1)))
+    pub.publish_raw_many(
+        [serialize_message(BasicTypes(int32_value=i)) for i in (2, 3)])
+    loaned = pub.borrow_loaned_message()
+    with loaned.get_member_view('int32_value') as view:
+        view[0] = 4
+    pub.publish_loaned(loaned)
+    with pytest.raises(ValueError):
+        pub.publish_columns({'int32_value': [5]})
+
+    executor = SingleThreadedExecutor()
+    executor.add_node(node)
+    spin_until(executor, lambda: len(received) == 4)
+    executor.spin_once(timeout_sec=0.1)
+    assert received == [1, 2, 3, 4]
+
+    executor.shutdown()
+    node.destroy_node()
+
+
+def test_intra_process_invalid_options():
+    topic_name = 'test_intra_process/test_intra_process_invalid_options/topic'
+    node = Node('test_node', use_intra_process_comms=True)
+
+    qos_profile = QoSProfile(depth=10, durability=DurabilityPolicy.TRANSIENT_LOCAL)
+    with pytest.raises(ValueError):
+        node.create_publisher(BasicTypes, topic_name, qos_profile)
+    with pytest.raises(ValueError):
+        node.create_subscription(BasicTypes, topic_name, lambda msg: None, qos_profile)
+    with pytest.raises(ValueError):
+        node.create_subscription(BasicTypes, topic_name, lambda msg: None, 10, raw=True)
+
+    # Intra-process communication can be disabled per entity
+    sub = node.create_subscription(
+        BasicTypes, topic_name, lambda msg: None, qos_profile, use_intra_process_comms=False)
+    assert node.destroy_subscription(sub)
+
+    node.destroy_node()
@@ -17,8 +17,17 @@ import unittest
 
 import rclpy
 from rclpy.duration import Duration
+from rclpy.event_handler import PublisherEventCallbacks
+from rclpy.qos import DurabilityPolicy
+from rclpy.qos import QoSProfile
+from rclpy.serialization import serialize_message
+from rclpy.type_support import get_message_dtype
 
+from test_msgs.msg import Arrays
 from test_msgs.msg import BasicTypes
+from test_msgs.msg import Builtins
+from test_msgs.msg import Defaults
+from test_msgs.msg import UnboundedSequences
 
 TEST_NODE_NAMESPACE = 'test_node_ns'
 
@@ -125,6 +134,213 @@ class TestPublisher(unittest.TestCase):
         pub.destroy()
         sub.destroy()
 
+    def test_publish_sequences_reuses_messages(self):
+        pub = self.node.create_publisher(UnboundedSequences, TEST_TOPIC + '_reuse', 10)
+        received = []
+        sub = self.node.create_subscription(
+            UnboundedSequences, TEST_TOPIC + '_reuse', received.append, 10)
+
+        end_time = time.time() + 5
+        while pub.get_subscription_count() != 1:
+            time.sleep(0.05)
+            assert time.time() <= end_time  # timeout waiting for pub/sub to discover each other
+
+        # Each message is converted into the C message the previous one was converted into
+        msgs = [
+            UnboundedSequences(uint8_values=bytes(range(100)), string_values=['a', 'b', 'c']),
+            UnboundedSequences(uint8_values=b'\x01', string_values=['d']),
+            UnboundedSequences(),
+        ]
+        for msg in msgs:
+            pub.publish(msg)
+
+        end_time = time.time() + 5
+        while len(received) < len(msgs) and time.time() < end_time:
+            rclpy.spin_once(self.node, timeout_sec=0.1)
+        assert [bytes(msg.uint8_values) for msg in received] == [
+            bytes(range(100)), b'\x01', b'']
+        assert [msg.string_values for msg in received] == [['a', 'b', 'c'], ['d'], []]
+
+        pub.destroy()
+        sub.destroy()
+
+    def test_publish_raw(self):
+        pub = self.node.create_publisher(BasicTypes, TEST_TOPIC, 10)
+        received = []
+        sub = self.node.create_subscription(
+            BasicTypes, TEST_TOPIC, received.append, 10, raw=True)
+
+        end_time = time.time() + 5
+        while pub.get_subscription_count() != 1:
+            time.sleep(0.05)
+            assert time.time() <= end_time  # timeout waiting for pub/sub to discover each other
+
+        serialized = serialize_message(BasicTypes(int32_value=42))
+        pub.publish(serialized)
+        pub.publish(bytearray(serialized))
+        pub.publish(memoryview(b'\0' * 8 + serialized)[8:])
+        pub.publish_raw_many([serialized, bytearray(serialized)])
+        with self.assertRaises(TypeError):
+            pub.publish('not a buffer')
+        with self.assertRaises(TypeError):
+            pub.publish_raw_many([serialized, 'not a buffer'])
+
+        end_time = time.time() + 5
+        while len(received) < 5 and time.time() < end_time:
+            rclpy.spin_once(self.node, timeout_sec=0.1)
+        assert received == [serialized] * 5
+
+        pub.destroy()
+        sub.destroy()
+
+    def test_publish_columns(self):
+        import numpy
+        pub = self.node.create_publisher(Defaults, TEST_TOPIC, 10)
+        received = []
+        sub = self.node.create_subscription(Defaults, TEST_TOPIC, received.append, 10)
+
+        end_time = time.time() + 5
+        while pub.get_subscription_count() != 1:
+            time.sleep(0.05)
+            assert time.time() <= end_time  # timeout waiting for pub/sub to discover each other
+
+        # Fields without a column keep their default values
+        pub.publish_columns({'int32_value': [1, 2, 3], 'float64_value': numpy.full(3, 0.5)})
+        rows = numpy.zeros(2, get_message_dtype(Defaults))
+        rows['int32_value'] = [4, 5]
+        pub.publish_columns(rows)
+        with self.assertRaises(ValueError):
+            pub.publish_columns({'no_such_field': [1]})
+        with self.assertRaises(ValueError):
+            pub.publish_columns({'int32_value': [1, 2], 'float64_value': [0.5]})
+        with self.assertRaises(TypeError):
+            pub.publish_columns(numpy.zeros(2, get_message_dtype(Builtins)))
+
+        end_time = time.time() + 5
+        while len(received) < 5 and time.time() < end_time:
+            rclpy.spin_once(self.node, timeout_sec=0.1)
+        assert received[:3] == [Defaults(int32_value=i, float64_value=0.5) for i in (1, 2, 3)]
+        assert [msg.int32_value for msg in received[3:]] == [4, 5]
+        assert not received[3].bool_value
+
+        arrays_pub = self.node.create_publisher(Arrays, TEST_TOPIC + '_arrays', 10)
+        with self.assertRaises(ValueError):
+            arrays_pub.publish_columns({'int32_values': [[1, 2, 3]]})
+
+        arrays_pub.destroy()
+        pub.destroy()
+        sub.destroy()
+
+    def test_publish_skip_unmatched(self):
+        pub = self.node.create_publisher(
+            BasicTypes, TEST_TOPIC + '_skip_unmatched', 10, skip_unmatched=True)
+        built = []
+
+        def build_message():
+            built.append(BasicTypes(int32_value=len(built)))
+            return built[-1]
+
+        # Nothing is built nor converted while nobody listens
+        assert not pub.publish_lazy(build_message)
+        assert not built
+        pub.publish(BasicTypes())
+        pub.publish(serialize_message(BasicTypes()))
+        pub.publish_raw_many([serialize_message(BasicTypes())])
+
+        received = []
+        sub = self.node.create_subscription(
+            BasicTypes, TEST_TOPIC + '_skip_unmatched', received.append, 10)
+        end_time = time.time() + 5
+        while pub.get_subscription_count() != 1 or sub.get_publisher_count() != 1:
+            time.sleep(0.05)
+            assert time.time() <= end_time  # timeout waiting for pub/sub to discover each other
+        assert pub.publish_lazy(build_message)
+        assert len(built) == 1
+
+        end_time = time.time() + 5
+        while not received and time.time() < end_time:
+            rclpy.spin_once(self.node, timeout_sec=0.1)
+        assert received == built
+
+        with self.assertRaises(ValueError):
+            self.node.create_publisher(
+                BasicTypes, TEST_TOPIC + '_skip_unmatched',
+                QoSProfile(depth=10, durability=DurabilityPolicy.TRANSIENT_LOCAL),
+                skip_unmatched=True)
+        with self.assertRaises(ValueError):
+            self.node.create_publisher(
+                BasicTypes, TEST_TOPIC + '_skip_unmatched', 10,
+                event_callbacks=PublisherEventCallbacks(matched=lambda info: None),
+                skip_unmatched=True)
+
+        pub.destroy()
+        sub.destroy()
+
+    def test_publish_loaned(self):
+        pub = self.node.create_publisher(Arrays, TEST_TOPIC, 10)
+        received = []
+        sub = self.node.create_subscription(Arrays, TEST_TOPIC, received.append, 10)
+
+        msg = pub.borrow_loaned_message()
+        assert msg.is_loaned == pub.can_loan_messages
+        view = msg.get_member_view('int32_values')
+        assert view.format == 'i'
+        assert not view.readonly
+        view[:] = memoryview(bytes(view.nbytes)).cast('i')
+        view[1] = 42
+        msg.get_member_view('float64_values')[2] = 1.5
+        assert list(msg.message.int32_values) == [0, 42, 0]
+        with self.assertRaises(ValueError):
+            msg.get_member_view('string_values')
+        with self.assertRaises(ValueError):
+            msg.get_member_view('no_such_member')
+        # The message can't go away while views of it exist
+        with self.assertRaises(BufferError):
+            pub.publish_loaned(msg)
+        with self.assertRaises(BufferError):
+            msg.release()
+        assert not msg.released
+        view.release()
+        pub.publish_loaned(msg)
+        assert msg.released
+        with self.assertRaises(ValueError):
+            pub.publish_loaned(msg)
+
+        end_time = time.time() + 5
+        while not received and time.time() < end_time:
+            rclpy.spin_once(self.node, timeout_sec=0.1)
+        assert len(received) == 1
+        assert list(received[0].int32_values) == [0, 42, 0]
+        assert received[0].float64_values[2] == 1.5
+
+        other_pub = self.node.create_publisher(Arrays, TEST_TOPIC, 10)
+        with pub.borrow_loaned_message() as msg:
+            with self.assertRaises(ValueError):
+                other_pub.publish_loaned(msg)
+        assert msg.released
+
+        other_pub.destroy()
+        pub.destroy()
+        sub.destroy()
+
+    def test_publish_loaned_resize(self):
+        pub = self.node.create_publisher(UnboundedSequences, TEST_TOPIC, 10)
+        with pub.borrow_loaned_message() as msg:
+            if msg.is_loaned:
+                with self.assertRaises(ValueError):
+                    msg.resize_member('uint8_values', 4)
+                return
+            assert len(msg.get_member_view('uint8_values')) == 0
+            msg.resize_member('uint8_values', 4)
+            with msg.get_member_view('uint8_values') as view:
+                view[:] = b'\x01\x02\x03\x04'
+                with self.assertRaises(BufferError):
+                    msg.resize_member('uint8_values', 8)
+            assert bytes(msg.message.uint8_values) == b'\x01\x02\x03\x04'
+            with self.assertRaises(ValueError):
+                msg.resize_member('alignment_check', 4)
+        pub.destroy()
+
 
 if __name__ == '__main__':
     unittest.main()
@@ -29,6 +29,7 @@ from rclpy.event_handler import QoSRequestedIncompatibleQoSInfo
 from rclpy.event_handler import QoSSubscriptionEventType
 from rclpy.event_handler import QoSSubscriptionMatchedInfo
 from rclpy.event_handler import SubscriptionEventCallbacks
+from rclpy.exceptions import InvalidHandle
 from rclpy.impl.implementation_singleton import rclpy_implementation as _rclpy
 from rclpy.qos import QoSDurabilityPolicy
 from rclpy.qos import QoSPolicyKind
@@ -228,6 +229,18 @@ class TestQoSEvent(unittest.TestCase):
             subscription, QoSSubscriptionEventType.RCL_SUBSCRIPTION_MATCHED)
         self.node.destroy_subscription(subscription)
 
+    def test_event_dropped_without_destroy(self):
+        publisher = self.node.create_publisher(EmptyMsg, self.topic_name, 10)
+        handle = self._create_event_handle(
+            publisher, QoSPublisherEventType.RCL_PUBLISHER_MATCHED)
+        # Dropping the handle releases the publisher it kept in use
+        del handle
+        gc.collect()
+        self.node.destroy_publisher(publisher)
+        with self.assertRaises(InvalidHandle):
+            with publisher.handle:
+                pass
+
     def test_call_publisher_rclpy_event_apis(self):
         # Go through the exposed apis and ensure that things don't explode when called
         # Make no assumptions about being able to actually receive the events
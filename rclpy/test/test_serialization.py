@@ -12,10 +12,18 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import array
+import sys
+
 import pytest
 
+from rclpy.impl.implementation_singleton import rclpy_implementation as _rclpy
 from rclpy.serialization import deserialize_message
+from rclpy.serialization import deserialize_messages
 from rclpy.serialization import serialize_message
+from rclpy.serialization import serialize_message_into
+from rclpy.serialization import serialize_messages
+from rclpy.serialization import serialized_message_size
 
 from test_msgs.message_fixtures import get_test_msg
 from test_msgs.msg import Arrays
@@ -56,6 +64,121 @@ def test_serialize_deserialize(msgs, msg_type):
         assert msg == msg_deserialized
 
 
+@pytest.mark.parametrize('msgs,msg_type', test_msgs)
+def test_serialize_into_deserialize_buffer(msgs, msg_type):
+    """Test message serialization into and deserialization from existing buffers."""
+    for msg in msgs:
+        msg_serialized = serialize_message(msg)
+        size = serialized_message_size(msg)
+        assert size == len(msg_serialized)
+
+        buffer = bytearray(size + 8)
+        assert serialize_message_into(msg, buffer, 8) == size
+        assert buffer[8:] == msg_serialized
+        assert serialize_message_into(msg, memoryview(buffer)[:size]) == size
+        assert buffer[:size] == msg_serialized
+
+        # Nothing is written if the message does not fit
+        small_buffer = bytearray(size - 1)
+        assert serialize_message_into(msg, small_buffer) == -size
+        assert small_buffer == bytearray(size - 1)
+
+        assert deserialize_message(bytearray(msg_serialized), msg_type) == msg
+        assert deserialize_message(memoryview(buffer)[:size], msg_type) == msg
+
+    with pytest.raises(ValueError):
+        serialize_message_into(msgs[0], bytearray(1), 2)
+    with pytest.raises(BufferError):
+        serialize_message_into(msgs[0], b'read-only')
+
+
+@pytest.mark.parametrize('msgs,msg_type', test_msgs)
+def test_serialize_deserialize_batch(msgs, msg_type):
+    """Test serialization/deserialization of several messages at once."""
+    buffer, offsets = serialize_messages(msgs, msg_type)
+    assert len(offsets) == len(msgs) + 1
+    assert offsets[-1] == len(buffer)
+    for i, msg in enumerate(msgs):
+        assert buffer[offsets[i]:offsets[i + 1]] == serialize_message(msg)
+    assert deserialize_messages(buffer, offsets, msg_type) == msgs
+    assert deserialize_messages(memoryview(buffer), list(offsets), msg_type) == msgs
+
+    buffer, offsets = serialize_messages([], msg_type)
+    assert buffer == b''
+    assert list(offsets) == [0]
+    assert deserialize_messages(buffer, offsets, msg_type) == []
+
+    with pytest.raises(ValueError):
+        deserialize_messages(b'', [0, 1], msg_type)
+
+
+@pytest.mark.skipif(sys.platform == 'win32', reason='resource is not available on Windows')
+def test_serialize_batch_does_not_leak():
+    import resource
+    # A leaked message would grow the memory by at least 1 MiB per message
+    msg = UnboundedSequences(uint8_values=bytes(1 << 20), string_values=['x'] * 1000)
+    serialize_messages([msg] * 10, UnboundedSequences)
+    max_rss_kib = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    for _ in range(20):
+        serialize_messages([msg] * 10, UnboundedSequences)
+    growth_kib = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss - max_rss_kib
+    assert growth_kib < 50 * 1024
+
+
+def _assert_lazy_message_equal(view, msg, reverse=False):
+    names = list(msg.get_fields_and_field_types())
+    for name in reversed(names) if reverse else names:
+        value = getattr(view, name)
+        expected = getattr(msg, name)
+        if isinstance(value, _rclpy.LazyMessage):
+            _assert_lazy_message_equal(value, expected)
+        elif isinstance(value, list) and value and isinstance(value[0], _rclpy.LazyMessage):
+            assert len(value) == len(expected)
+            for item, expected_item in zip(value, expected):
+                _assert_lazy_message_equal(item, expected_item)
+        elif hasattr(value, 'tolist'):
+            # NumPy arrays are viewing the serialized message
+            assert not value.flags.writeable
+            assert value.tolist() == list(expected)
+        elif isinstance(expected, array.array):
+            assert value == list(expected)
+        else:
+            assert value == expected
+
+
+@pytest.mark.parametrize('msgs,msg_type', test_msgs)
+def test_lazy_message(msgs, msg_type):
+    """Test decoding the fields of serialized messages on access."""
+    for msg in msgs:
+        msg_serialized = serialize_message(msg)
+        view = _rclpy.LazyMessage(msg_serialized, msg_type)
+        assert view._buffer is msg_serialized
+        assert set(msg.get_fields_and_field_types()) <= set(dir(view))
+        _assert_lazy_message_equal(view, msg)
+        assert view._deserialize() == msg
+
+        # Fields are accessible in any order
+        view = _rclpy.LazyMessage(msg_serialized, msg_type)
+        _assert_lazy_message_equal(view, msg, reverse=True)
+
+    view = _rclpy.LazyMessage(serialize_message(msgs[0]), msg_type)
+    with pytest.raises(AttributeError):
+        view.not_a_field
+    with pytest.raises(ValueError):
+        _rclpy.LazyMessage(b'', msg_type)
+
+
+def test_lazy_message_truncated():
+    """Test decoding fields of a truncated serialized message."""
+    msg = Strings(string_value='a' * 32)
+    # Header, length and characters of the first string
+    msg_serialized = serialize_message(msg)[:4 + 4 + 33]
+    view = _rclpy.LazyMessage(msg_serialized, Strings)
+    assert view.string_value == msg.string_value
+    with pytest.raises(ValueError):
+        getattr(view, list(Strings.get_fields_and_field_types())[1])
+
+
 def test_set_float32():
     """Test message serialization/deserialization of float32 type."""
     # During (de)serialization we convert to a C float before converting to a PyObject.
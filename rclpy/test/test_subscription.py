@@ -12,15 +12,27 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import itertools
 import time
 
+import numpy
 import pytest
 
 import rclpy
+from rclpy.event_handler import SubscriptionEventCallbacks
+from rclpy.executors import NativeSingleThreadedExecutor
+from rclpy.executors import SingleThreadedExecutor
 from rclpy.node import Node
+from rclpy.serialization import deserialize_message
 from rclpy.subscription import Subscription
 
+from test_msgs.msg import Arrays
+from test_msgs.msg import BasicTypes
 from test_msgs.msg import Empty
+from test_msgs.msg import UnboundedSequences
+
+
+MAX_SECONDS_TO_WAIT = 5
 
 
 @pytest.fixture(scope='session', autouse=True)
@@ -28,6 +40,33 @@ def setup_ros():
     rclpy.init()
 
 
+def wait_for_discovery(sub):
+    """Wait until the subscription matched one publisher."""
+    end_time = time.time() + MAX_SECONDS_TO_WAIT
+    while sub.get_publisher_count() != 1:
+        time.sleep(0.05)
+        assert time.time() <= end_time  # timeout waiting for pub/sub to discover each other
+
+
+def take_until(take):
+    """Call a take function until it takes something, and return what it took."""
+    end_time = time.time() + MAX_SECONDS_TO_WAIT
+    while True:
+        taken = take()
+        if taken is not None:
+            return taken
+        time.sleep(0.05)
+        assert time.time() <= end_time  # timeout waiting for the message
+
+
+def spin_until(executor, predicate):
+    """Spin the executor until the predicate is true."""
+    end_time = time.time() + MAX_SECONDS_TO_WAIT
+    while not predicate():
+        executor.spin_once(timeout_sec=0.1)
+        assert time.time() <= end_time  # timeout waiting for the messages
+
+
 @pytest.mark.parametrize('topic_name, namespace, expected', [
     # No namespaces
     ('topic', None, '/topic'),
@@ -120,11 +159,7 @@ def test_subscription_publisher_count():
 
     pub = node.create_publisher(Empty, topic_name, 10)
 
-    max_seconds_to_wait = 5
-    end_time = time.time() + max_seconds_to_wait
-    while sub.get_publisher_count() != 1:
-        time.sleep(0.05)
-        assert time.time() <= end_time  # timeout waiting for pub/sub to discover each other
+    wait_for_discovery(sub)
 
     assert sub.get_publisher_count() == 1
 
@@ -132,3 +167,651 @@ def test_subscription_publisher_count():
     sub.destroy()
 
     node.destroy_node()
+
+
+def test_subscription_take_messages():
+    topic_name = 'test_subscription/test_subscription_take_messages/topic'
+    node = Node('test_node', namespace='test_subscription/test_subscription_take_messages')
+    sub = node.create_subscription(
+        msg_type=Empty,
+        topic=topic_name,
+        qos_profile=10,
+        callback=lambda _: None)
+    pub = node.create_publisher(Empty, topic_name, 10)
+
+    wait_for_discovery(sub)
+
+    with pytest.raises(ValueError):
+        sub.handle.take_messages(Empty, 0)
+    with pytest.raises(TypeError):
+        sub.handle.take_messages(BasicTypes, 3)
+
+    for _ in range(5):
+        pub.publish(Empty())
+
+    msgs = []
+    infos = []
+    while len(msgs) < 5:
+        taken = take_until(lambda: sub.handle.take_messages(Empty, 3))
+        assert len(taken[0]) <= 3
+        assert taken[1].shape == (len(taken[0]), 4)
+        msgs += taken[0]
+        infos += taken[1].tolist()
+
+    assert all(isinstance(msg, Empty) for msg in msgs)
+    # Rows of source timestamp, received timestamp and sequence numbers
+    assert all(info[0] > 0 for info in infos)
+    assert sub.handle.take_messages(Empty, 3) is None
+
+    # Batches larger than the previous ones grow the storage kept for them
+    for _ in range(6):
+        pub.publish(Empty())
+    num_taken = 0
+    for max_n in itertools.cycle([1, 5]):
+        if num_taken == 6:
+            break
+        taken = take_until(lambda: sub.handle.take_messages(Empty, max_n))
+        assert len(taken[0]) <= max_n
+        num_taken += len(taken[0])
+    assert sub.handle.take_messages(Empty, 5) is None
+
+    pub.destroy()
+    sub.destroy()
+
+    node.destroy_node()
+
+
+def test_subscription_reused_messages():
+    # Publishers and subscriptions reuse their C messages, nothing must leak between messages
+    topic_name = 'test_subscription/test_subscription_reused_messages/topic'
+    node = Node('test_node', namespace='test_subscription/test_subscription_reused_messages')
+    sub = node.create_subscription(
+        msg_type=UnboundedSequences,
+        topic=topic_name,
+        qos_profile=10,
+        callback=lambda _: None)
+    pub = node.create_publisher(UnboundedSequences, topic_name, 10)
+
+    wait_for_discovery(sub)
+
+    sizes = [5, 1, 0, 3]
+    for size in sizes:
+        msg = UnboundedSequences()
+        msg.int32_values = list(range(size))
+        msg.string_values = [str(i) * (size - i) for i in range(size)]
+        pub.publish(msg)
+
+    taken_msgs = []
+    while len(taken_msgs) < len(sizes):
+        taken = take_until(lambda: sub.handle.take_message(UnboundedSequences, False))
+        taken_msgs.append(taken[0])
+
+    for size, msg in zip(sizes, taken_msgs):
+        assert list(msg.int32_values) == list(range(size))
+        assert msg.string_values == [str(i) * (size - i) for i in range(size)]
+
+    pub.destroy()
+    sub.destroy()
+
+    node.destroy_node()
+
+
+def test_subscription_take_message_into_every_member():
+    topic_name = 'test_subscription/test_subscription_take_message_into_every_member/topic'
+    node = Node(
+        'test_node',
+        namespace='test_subscription/test_subscription_take_message_into_every_member')
+    sub = node.create_subscription(
+        msg_type=UnboundedSequences,
+        topic=topic_name,
+        qos_profile=10,
+        callback=lambda _: None)
+    pub = node.create_publisher(UnboundedSequences, topic_name, 10)
+
+    wait_for_discovery(sub)
+
+    sizes = [2, 3, 0, 1]
+    published = []
+    for size in sizes:
+        msg = UnboundedSequences()
+        msg.bool_values = [i % 2 == 0 for i in range(size)]
+        msg.byte_values = [bytes([i]) for i in range(size)]
+        msg.int32_values = list(range(size))
+        msg.string_values = [str(i) for i in range(size)]
+        msg.basic_types_values = [BasicTypes(int32_value=i) for i in range(size)]
+        pub.publish(msg)
+        published.append(msg)
+
+    # Every member, including lists of strings and nested messages, is updated in place
+    reused_msg = UnboundedSequences()
+    nested_values = reused_msg.basic_types_values
+    for msg in published:
+        take_until(lambda: sub.handle.take_message_into(reused_msg))
+        assert reused_msg == msg
+        assert reused_msg.basic_types_values is nested_values
+
+    pub.destroy()
+    sub.destroy()
+
+    node.destroy_node()
+
+
+def test_subscription_take_raw_into():
+    topic_name = 'test_subscription/test_subscription_take_raw_into/topic'
+    node = Node('test_node', namespace='test_subscription/test_subscription_take_raw_into')
+    sub = node.create_subscription(
+        msg_type=BasicTypes,
+        topic=topic_name,
+        qos_profile=10,
+        callback=lambda _: None,
+        raw=True)
+    pub = node.create_publisher(BasicTypes, topic_name, 10)
+
+    wait_for_discovery(sub)
+
+    buffer = bytearray(1)
+    assert sub.handle.take_raw_into(buffer) is None
+    with pytest.raises(BufferError):
+        sub.handle.take_raw_into(b'read-only')
+
+    msg = BasicTypes(int32_value=42)
+    pub.publish(msg)
+    taken = take_until(lambda: sub.handle.take_raw_into(buffer))
+
+    # The buffer is too small, the message is kept for the next take
+    length, info = taken
+    assert length < 0
+    assert info is None
+    buffer = bytearray(-length + 16)
+    length, info = sub.handle.take_raw_into(memoryview(buffer)[8:])
+    assert length == len(buffer) - 16
+    assert 'source_timestamp' in info
+    assert deserialize_message(bytes(buffer[8:8 + length]), BasicTypes) == msg
+    assert sub.handle.take_raw_into(buffer) is None
+
+    pub.destroy()
+    sub.destroy()
+
+    node.destroy_node()
+
+
+def test_subscription_take_message_into():
+    topic_name = 'test_subscription/test_subscription_take_message_into/topic'
+    node = Node('test_node', namespace='test_subscription/test_subscription_take_message_into')
+    sub = node.create_subscription(
+        msg_type=Arrays,
+        topic=topic_name,
+        qos_profile=10,
+        callback=lambda _: None)
+    pub = node.create_publisher(Arrays, topic_name, 10)
+
+    wait_for_discovery(sub)
+
+    msg = Arrays()
+    int32_values = msg.int32_values
+    assert sub.handle.take_message_into(msg) is None
+    with pytest.raises(TypeError):
+        sub.handle.take_message_into(Empty())
+
+    for i in range(2):
+        sent = Arrays()
+        sent.int32_values = [i, i + 1, i + 2]
+        sent.string_values = [str(i)] * 3
+        sent.basic_types_values[1].float64_value = float(i)
+        pub.publish(sent)
+
+        info = take_until(lambda: sub.handle.take_message_into(msg))
+
+        assert 'source_timestamp' in info
+        assert msg == sent
+        # Arrays of primitive types are updated in place
+        assert msg.int32_values is int32_values
+
+    pub.destroy()
+    sub.destroy()
+
+    node.destroy_node()
+
+
+@pytest.mark.parametrize('executor_type', [SingleThreadedExecutor, NativeSingleThreadedExecutor])
+def test_subscription_reuse_message(executor_type):
+    topic_name = 'test_subscription/test_subscription_reuse_message/topic'
+    node = Node('test_node', namespace='test_subscription/test_subscription_reuse_message')
+    received = []
+    sub = node.create_subscription(
+        msg_type=BasicTypes,
+        topic=topic_name,
+        qos_profile=10,
+        callback=lambda msg: received.append((msg, msg.int32_value)),
+        reuse_message=True)
+    pub = node.create_publisher(BasicTypes, topic_name, 10)
+
+    wait_for_discovery(sub)
+
+    for i in range(3):
+        pub.publish(BasicTypes(int32_value=i))
+
+    executor = executor_type()
+    executor.add_node(node)
+    spin_until(executor, lambda: len(received) == 3)
+
+    assert all(msg is sub.reused_message for msg, _ in received)
+    assert [value for _, value in received] == [0, 1, 2]
+
+    with pytest.raises(ValueError):
+        node.create_subscription(
+            msg_type=BasicTypes, topic=topic_name, qos_profile=10,
+            callback=lambda msg: None, raw=True, reuse_message=True)
+
+    executor.shutdown()
+    pub.destroy()
+    sub.destroy()
+
+    node.destroy_node()
+
+
+@pytest.mark.parametrize('executor_type', [SingleThreadedExecutor, NativeSingleThreadedExecutor])
+def test_subscription_max_batch_size(executor_type):
+    topic_name = 'test_subscription/test_subscription_max_batch_size/topic'
+    node = Node('test_node', namespace='test_subscription/test_subscription_max_batch_size')
+    batches = []
+    sub = node.create_subscription(
+        msg_type=Empty,
+        topic=topic_name,
+        qos_profile=10,
+        callback=lambda msgs: batches.append(msgs),
+        max_batch_size=10)
+    pub = node.create_publisher(Empty, topic_name, 10)
+
+    wait_for_discovery(sub)
+
+    for _ in range(3):
+        pub.publish(Empty())
+
+    executor = executor_type()
+    executor.add_node(node)
+    spin_until(executor, lambda: sum(len(batch) for batch in batches) == 3)
+
+    assert all(isinstance(batch, list) for batch in batches)
+    assert all(isinstance(msg, Empty) for batch in batches for msg in batch)
+
+    with pytest.raises(ValueError):
+        node.create_subscription(
+            msg_type=Empty, topic=topic_name, qos_profile=10,
+            callback=lambda msgs: None, max_batch_size=0)
+
+    executor.shutdown()
+    pub.destroy()
+    sub.destroy()
+
+    node.destroy_node()
+
+
+@pytest.mark.parametrize('executor_type', [SingleThreadedExecutor, NativeSingleThreadedExecutor])
+def test_subscription_loaned_messages(executor_type):
+    topic_name = 'test_subscription/test_subscription_loaned_messages/topic'
+    node = Node('test_node', namespace='test_subscription/test_subscription_loaned_messages')
+    received = []
+
+    def callback(loaned_msg):
+        assert not loaned_msg.released
+        assert isinstance(loaned_msg.message, Empty)
+        received.append(loaned_msg)
+
+    sub = node.create_subscription(
+        msg_type=Empty,
+        topic=topic_name,
+        qos_profile=10,
+        callback=callback,
+        loaned_messages=True)
+    pub = node.create_publisher(Empty, topic_name, 10)
+
+    wait_for_discovery(sub)
+
+    pub.publish(Empty())
+    taken = take_until(lambda: sub.handle.take_loaned_message(Empty))
+
+    loaned_msg, info = taken
+    assert loaned_msg.is_loaned == sub.handle.can_loan_messages()
+    assert isinstance(loaned_msg.message, Empty)
+    assert 'source_timestamp' in info
+    with loaned_msg:
+        pass
+    assert loaned_msg.released
+    with pytest.raises(ValueError):
+        loaned_msg.message
+    # Releasing twice is fine
+    loaned_msg.release()
+
+    pub.publish(Empty())
+    executor = executor_type()
+    executor.add_node(node)
+    spin_until(executor, lambda: received)
+    # The loan is returned once the callback is done
+    assert received[0].released
+
+    with pytest.raises(ValueError):
+        node.create_subscription(
+            msg_type=Empty, topic=topic_name, qos_profile=10,
+            callback=lambda msg: None, raw=True, loaned_messages=True)
+
+    executor.shutdown()
+    pub.destroy()
+    sub.destroy()
+
+    node.destroy_node()
+
+
+def test_subscription_loaned_message_views():
+    topic_name = 'test_subscription/test_subscription_loaned_message_views/topic'
+    node = Node('test_node', namespace='test_subscription/test_subscription_loaned_message_views')
+    sub = node.create_subscription(
+        msg_type=UnboundedSequences, topic=topic_name, qos_profile=10,
+        callback=lambda msg: None, loaned_messages=True)
+    pub = node.create_publisher(UnboundedSequences, topic_name, 10)
+
+    wait_for_discovery(sub)
+
+    pub.publish(UnboundedSequences(int32_values=[1, 2, 3], float64_values=[0.5]))
+    taken = take_until(lambda: sub.handle.take_loaned_message(UnboundedSequences))
+
+    loaned_msg, _ = taken
+    view = loaned_msg.get_member_view('int32_values')
+    assert view.readonly
+    assert view.tolist() == [1, 2, 3]
+    msg = loaned_msg.message
+    assert isinstance(msg.float64_values, memoryview)
+    assert msg.float64_values.tolist() == [0.5]
+    with pytest.raises(ValueError):
+        loaned_msg.get_member_view('string_values')
+
+    # The views keep the loan until they are gone
+    loaned_msg.release()
+    assert loaned_msg.released
+    with pytest.raises(ValueError):
+        loaned_msg.get_member_view('int32_values')
+    assert view.tolist() == [1, 2, 3]
+    assert msg.float64_values.tolist() == [0.5]
+    del view
+    del msg
+
+    pub.destroy()
+    sub.destroy()
+    node.destroy_node()
+
+
+@pytest.mark.parametrize('executor_type', [SingleThreadedExecutor, NativeSingleThreadedExecutor])
+def test_subscription_lazy(executor_type):
+    topic_name = 'test_subscription/test_subscription_lazy/topic'
+    node = Node('test_node', namespace='test_subscription/test_subscription_lazy')
+    received = []
+    sub = node.create_subscription(
+        msg_type=Arrays,
+        topic=topic_name,
+        qos_profile=10,
+        callback=lambda msg: received.append(msg),
+        lazy=True)
+    pub = node.create_publisher(Arrays, topic_name, 10)
+
+    wait_for_discovery(sub)
+
+    msg = Arrays()
+    msg.int32_values = [1, 2, 3]
+    msg.string_values = ['a', 'b', 'c']
+    msg.basic_types_values[1].float64_value = 2.5
+    pub.publish(msg)
+
+    executor = executor_type()
+    executor.add_node(node)
+    spin_until(executor, lambda: received)
+
+    view = received[0]
+    assert view.string_values == ['a', 'b', 'c']
+    assert view.int32_values.tolist() == [1, 2, 3]
+    assert view.basic_types_values[1].float64_value == 2.5
+    assert view._deserialize() == msg
+
+    with pytest.raises(ValueError):
+        node.create_subscription(
+            msg_type=Arrays, topic=topic_name, qos_profile=10,
+            callback=lambda msg: None, raw=True, lazy=True)
+
+    executor.shutdown()
+    pub.destroy()
+    sub.destroy()
+
+    node.destroy_node()
+
+
+@pytest.mark.parametrize('executor_type', [SingleThreadedExecutor, NativeSingleThreadedExecutor])
+def test_subscription_columnar(executor_type):
+    topic_name = 'test_subscription/test_subscription_columnar/topic'
+    node = Node('test_node', namespace='test_subscription/test_subscription_columnar')
+    received = []
+    sub = node.create_subscription(
+        msg_type=BasicTypes,
+        topic=topic_name,
+        qos_profile=10,
+        callback=lambda rows, timestamps: received.extend(
+            zip(rows['int32_value'].tolist(), timestamps.tolist())),
+        max_batch_size=10,
+        columnar=True)
+    pub = node.create_publisher(BasicTypes, topic_name, 10)
+
+    wait_for_discovery(sub)
+
+    for i in range(3):
+        pub.publish(BasicTypes(int32_value=i, float64_value=0.5))
+
+    executor = executor_type()
+    executor.add_node(node)
+    spin_until(executor, lambda: len(received) == 3)
+
+    assert [value for value, _ in received] == [0, 1, 2]
+    assert all(timestamp > 0 for _, timestamp in received)
+    rows, _ = sub.columns
+    assert rows['float64_value'][0] == 0.5
+
+    # Nothing left to take
+    assert sub.handle.take_messages_into_array(rows) == 0
+    with pytest.raises(ValueError):
+        sub.handle.take_messages_into_array(bytearray(rows.itemsize + 1))
+
+    with pytest.raises(ValueError):
+        node.create_subscription(
+            msg_type=BasicTypes, topic=topic_name, qos_profile=10,
+            callback=lambda rows: None, columnar=True)
+    with pytest.raises(ValueError):
+        node.create_subscription(
+            msg_type=Arrays, topic=topic_name + '_arrays', qos_profile=10,
+            callback=lambda rows: None, max_batch_size=10, columnar=True)
+
+    executor.shutdown()
+    pub.destroy()
+    sub.destroy()
+
+    node.destroy_node()
+
+
+@pytest.mark.parametrize('executor_type', [SingleThreadedExecutor, NativeSingleThreadedExecutor])
+def test_subscription_array_views(executor_type):
+    topic_name = 'test_subscription/test_subscription_array_views/topic'
+    node = Node('test_node', namespace='test_subscription/test_subscription_array_views')
+    received = []
+    sub = node.create_subscription(
+        msg_type=UnboundedSequences,
+        topic=topic_name,
+        qos_profile=10,
+        callback=lambda msg: received.append(msg),
+        array_views=True)
+    pub = node.create_publisher(UnboundedSequences, topic_name, 10)
+
+    wait_for_discovery(sub)
+
+    msg = UnboundedSequences()
+    msg.int32_values = [1, 2, 3]
+    msg.uint8_values = list(range(100))
+    msg.string_values = ['a', 'b']
+    pub.publish(msg)
+
+    executor = executor_type()
+    executor.add_node(node)
+    spin_until(executor, lambda: received)
+
+    taken = received.pop()
+    assert isinstance(taken.int32_values, memoryview)
+    assert taken.int32_values.readonly
+    assert taken.int32_values.tolist() == [1, 2, 3]
+    assert taken.float64_values.tolist() == []
+    assert taken.string_values == ['a', 'b']
+
+    # The views keep the message alive
+    view = taken.uint8_values
+    del taken
+    assert bytes(view) == bytes(range(100))
+
+    with pytest.raises(ValueError):
+        node.create_subscription(
+            msg_type=UnboundedSequences, topic=topic_name, qos_profile=10,
+            callback=lambda msg: None, raw=True, array_views=True)
+
+    executor.shutdown()
+    pub.destroy()
+    sub.destroy()
+
+    node.destroy_node()
+
+
+def test_subscription_fixed_array_views():
+    topic_name = 'test_subscription/test_subscription_fixed_array_views/topic'
+    node = Node('test_node', namespace='test_subscription/test_subscription_fixed_array_views')
+    received = []
+    sub = node.create_subscription(
+        msg_type=Arrays,
+        topic=topic_name,
+        qos_profile=10,
+        callback=lambda msg: received.append(msg),
+        array_views=True)
+    pub = node.create_publisher(Arrays, topic_name, 10)
+
+    wait_for_discovery(sub)
+
+    msg = Arrays()
+    msg.bool_values = [True, False, True]
+    msg.float64_values = [1.5, 2.5, 3.5]
+    msg.int32_values = [-1, 0, 1]
+    msg.uint8_values = [7, 8, 9]
+    msg.basic_types_values[1].int16_value = 3
+    pub.publish(msg)
+
+    executor = SingleThreadedExecutor()
+    executor.add_node(node)
+    spin_until(executor, lambda: received)
+
+    taken = received.pop()
+    assert isinstance(taken.float64_values, numpy.ndarray)
+    assert not taken.float64_values.flags.writeable
+    assert taken.int32_values.tolist() == [-1, 0, 1]
+    assert taken.bool_values == [True, False, True]
+    assert taken == msg
+
+    # Fixed size arrays over the taken message can be published again
+    pub.publish(taken)
+    spin_until(executor, lambda: received)
+    assert received.pop() == msg
+
+    executor.shutdown()
+    pub.destroy()
+    sub.destroy()
+
+    node.destroy_node()
+
+
+@pytest.mark.parametrize('executor_type', [SingleThreadedExecutor, NativeSingleThreadedExecutor])
+def test_subscription_shared(executor_type):
+    topic_name = 'test_subscription/test_subscription_shared/topic'
+    node1 = Node('test_node1', namespace='test_subscription/test_subscription_shared')
+    node2 = Node('test_node2', namespace='test_subscription/test_subscription_shared')
+    received1 = []
+    received2 = []
+    sub1 = node1.create_subscription(
+        msg_type=BasicTypes, topic=topic_name, qos_profile=10,
+        callback=lambda msg: received1.append(msg), shared=True)
+    sub2 = node2.create_subscription(
+        msg_type=BasicTypes, topic=topic_name, qos_profile=10,
+        callback=lambda msg, info: received2.append((msg, info)), shared=True)
+    assert sub1.shared
+    assert sub1.handle is sub2.handle
+    pub = node1.create_publisher(BasicTypes, topic_name, 10)
+
+    # A single reader receives the messages of both subscriptions
+    wait_for_discovery(sub1)
+    assert pub.get_subscription_count() == 1
+
+    executor = executor_type()
+    executor.add_node(node1)
+    executor.add_node(node2)
+    pub.publish(BasicTypes(int32_value=1))
+    spin_until(executor, lambda: received1 and received2)
+    assert received1[0].int32_value == 1
+    # The message is converted once for both subscriptions
+    assert received2[0][0] is received1[0]
+    assert received2[0][1]['source_timestamp'] > 0
+
+    # The reader is kept by the remaining subscription
+    assert node1.destroy_subscription(sub1)
+    pub.publish(BasicTypes(int32_value=2))
+    spin_until(executor, lambda: len(received2) == 2)
+    assert received2[1][0].int32_value == 2
+    assert len(received1) == 1
+
+    with pytest.raises(ValueError):
+        node1.create_subscription(
+            msg_type=BasicTypes, topic=topic_name, qos_profile=10,
+            callback=lambda msg: None, raw=True, shared=True)
+
+    executor.shutdown()
+    pub.destroy()
+    node2.destroy_subscription(sub2)
+
+    node1.destroy_node()
+    node2.destroy_node()
+
+
+def test_subscription_shared_spun_by_any_node():
+    topic_name = 'test_subscription/test_subscription_shared_spun_by_any_node/topic'
+    namespace = 'test_subscription/test_subscription_shared_spun_by_any_node'
+    node1 = Node('test_node1', namespace=namespace)
+    node2 = Node('test_node2', namespace=namespace)
+    received = []
+    sub1 = node1.create_subscription(
+        msg_type=BasicTypes, topic=topic_name, qos_profile=10,
+        callback=lambda msg: None, shared=True)
+    # The event handlers are created once, for the group
+    with pytest.raises(ValueError):
+        node2.create_subscription(
+            msg_type=BasicTypes, topic=topic_name, qos_profile=10,
+            callback=lambda msg: None, shared=True,
+            event_callbacks=SubscriptionEventCallbacks())
+    sub2 = node2.create_subscription(
+        msg_type=BasicTypes, topic=topic_name, qos_profile=10,
+        callback=lambda msg: received.append(msg), shared=True)
+    assert sub1.event_handlers == []
+    assert sub2.event_handlers == []
+    pub = node2.create_publisher(BasicTypes, topic_name, 10)
+
+    wait_for_discovery(sub2)
+
+    # The group is waited on by the node of every subscription, not only the oldest one
+    executor = SingleThreadedExecutor()
+    executor.add_node(node2)
+    pub.publish(BasicTypes(int32_value=1))
+    spin_until(executor, lambda: received)
+    assert received[0].int32_value == 1
+
+    executor.shutdown()
+    pub.destroy()
+    node1.destroy_subscription(sub1)
+    node2.destroy_subscription(sub2)
+    node1.destroy_node()
+    node2.destroy_node()
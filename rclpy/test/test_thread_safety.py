@@ -0,0 +1,284 @@
+# Copyright 2026 Open Source Robotics Foundation, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+# These tests hammer the extension from several threads, which only run in parallel on
+# free-threaded Python builds, but they must pass with the GIL as well.
+
+import threading
+import time
+
+import pytest
+
+import rclpy
+from rclpy.exceptions import InvalidHandle
+from rclpy.impl.implementation_singleton import rclpy_implementation as _rclpy
+from rclpy.node import Node
+from rclpy.qos import QoSProfile
+from rclpy.qos import ReliabilityPolicy
+from rclpy.serialization import deserialize_message
+
+from test_msgs.msg import BasicTypes
+from test_msgs.srv import BasicTypes as BasicTypesSrv
+
+NUM_THREADS = 4
+NUM_MESSAGES = 100
+
+
+@pytest.fixture(scope='session', autouse=True)
+def setup_ros():
+    rclpy.init()
+    yield
+    rclpy.shutdown()
+
+
+@pytest.fixture
+def node():
+    node = Node('test_node', namespace='test_thread_safety')
+    yield node
+    node.destroy_node()
+
+
+def run_threads(target, num_threads=NUM_THREADS):
+    errors = []
+
+    def run(index):
+        try:
+            target(index)
+        except Exception as e:
+            errors.append(e)
+
+    threads = [threading.Thread(target=run, args=(i,)) for i in range(num_threads)]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join(timeout=30)
+        assert not thread.is_alive()
+    assert not errors, errors
+
+
+def test_concurrent_publish_and_take(node):
+    topic_name = 'test_concurrent_publish_and_take'
+    qos_profile = QoSProfile(depth=NUM_THREADS * NUM_MESSAGES)
+    qos_profile.reliability = ReliabilityPolicy.RELIABLE
+    sub = node.create_subscription(BasicTypes, topic_name, lambda _: None, qos_profile)
+    pub = node.create_publisher(BasicTypes, topic_name, qos_profile)
+
+    end_time = time.time() + 5
+    while pub.get_subscription_count() != 1:
+        time.sleep(0.05)
+        assert time.time() <= end_time  # timeout waiting for pub/sub to discover each other
+
+    published = threading.Event()
+    taken = []
+    lock = threading.Lock()
+
+    def publish_or_take(index):
+        if index % 2 == 0:
+            for i in range(NUM_MESSAGES):
+                msg = BasicTypes()
+                msg.int32_value = index * NUM_MESSAGES + i
+                pub.publish(msg)
+            if index == 0:
+                # Give the middleware time to deliver everything before the takers stop
+                time.sleep(1.0)
+                published.set()
+            return
+        # Alternate between converted and raw takes, which share the subscription
+        raw = index % 4 == 3
+        end_time = time.time() + 10
+        while time.time() <= end_time:
+            with sub.handle:
+                result = sub.handle.take_message(BasicTypes, raw)
+            if result is not None:
+                with lock:
+                    taken.append(result[0])
+            elif published.is_set():
+                return
+
+    run_threads(publish_or_take)
+
+    values = []
+    for msg in taken:
+        if isinstance(msg, bytes):
+            msg = deserialize_message(msg, BasicTypes)
+        values.append(msg.int32_value)
+    # Every message was taken exactly once
+    assert values
+    assert len(values) == len(set(values))
+    assert len(values) <= NUM_THREADS // 2 * NUM_MESSAGES
+
+
+def test_concurrent_requests_and_responses(node):
+    srv_name = 'test_concurrent_requests_and_responses'
+    num_requests = NUM_THREADS // 2 * NUM_MESSAGES
+    qos_profile = QoSProfile(depth=num_requests)
+    qos_profile.reliability = ReliabilityPolicy.RELIABLE
+    cli = node.create_client(BasicTypesSrv, srv_name, qos_profile=qos_profile)
+    srv = node.create_service(
+        BasicTypesSrv, srv_name, lambda request, response: response, qos_profile=qos_profile)
+    assert cli.wait_for_service(timeout_sec=5.0)
+
+    sent = []
+    answered = []
+    lock = threading.Lock()
+
+    def request_or_respond(index):
+        end_time = time.time() + 10
+        if index % 2 == 0:
+            # Send requests and take responses, which share the client
+            for i in range(NUM_MESSAGES):
+                with cli.handle:
+                    sequence_number = cli.handle.send_request(BasicTypesSrv.Request())
+                    header, _ = cli.handle.take_response(BasicTypesSrv.Response)
+                with lock:
+                    sent.append(sequence_number)
+                    if header is not None:
+                        answered.append(header.request_id.sequence_number)
+        while time.time() <= end_time:
+            with lock:
+                if len(answered) == num_requests:
+                    return
+            if index % 2 == 0:
+                with cli.handle:
+                    header, _ = cli.handle.take_response(BasicTypesSrv.Response)
+                if header is not None:
+                    with lock:
+                        answered.append(header.request_id.sequence_number)
+            else:
+                with srv.handle:
+                    request, header = srv.handle.service_take_request(BasicTypesSrv.Request)
+                if header is not None:
+                    srv.send_response(BasicTypesSrv.Response(), header)
+
+    run_threads(request_or_respond)
+
+    # Every request was sent with its own sequence number and answered exactly once
+    assert len(set(sent)) == num_requests
+    assert sorted(answered) == sorted(sent)
+
+
+def test_destroy_while_taking(node):
+    topic_name = 'test_destroy_while_taking'
+    sub = node.create_subscription(BasicTypes, topic_name, lambda _: None, 10)
+    pub = node.create_publisher(BasicTypes, topic_name, 10)
+    started = threading.Barrier(NUM_THREADS + 1)
+    num_takes = [0] * NUM_THREADS
+
+    def take(index):
+        started.wait()
+        while True:
+            try:
+                with sub.handle:
+                    sub.handle.take_message(BasicTypes, index % 2 == 1)
+                    pub.publish(BasicTypes())
+            except InvalidHandle:
+                return
+            num_takes[index] += 1
+
+    thread = threading.Thread(target=run_threads, args=(take,))
+    thread.start()
+    started.wait()
+    time.sleep(0.1)
+    sub.handle.destroy_when_not_in_use()
+    thread.join(timeout=30)
+    assert not thread.is_alive()
+    assert all(num_takes)
+
+    with pytest.raises(InvalidHandle):
+        with sub.handle:
+            pass
+
+
+def test_concurrent_enter_exit():
+    context = rclpy.get_default_context()
+    with context.handle:
+        gc = _rclpy.GuardCondition(context.handle)
+
+    def enter_exit(_):
+        for _ in range(10000):
+            with gc:
+                gc.trigger_guard_condition()
+
+    run_threads(enter_exit)
+
+    # Every exit balanced its enter, so destruction happens right away
+    gc.destroy_when_not_in_use()
+    with pytest.raises(InvalidHandle):
+        with gc:
+            pass
+
+
+def test_concurrent_wait_and_trigger():
+    context = rclpy.get_default_context()
+    with context.handle:
+        gc = _rclpy.GuardCondition(context.handle)
+        wait_set = _rclpy.WaitSet(0, 1, 0, 0, 0, 0, context.handle)
+    stop = threading.Event()
+
+    def wait_or_trigger(index):
+        for _ in range(1000):
+            if index == 0:
+                with wait_set:
+                    wait_set.clear_entities()
+                    wait_set.add_guard_condition(gc)
+                    wait_set.wait(10 * 1000 * 1000)
+                    wait_set.get_ready_entities('guard_condition')
+            elif stop.is_set():
+                return
+            else:
+                with gc:
+                    gc.trigger_guard_condition()
+        stop.set()
+
+    run_threads(wait_or_trigger)
+
+    wait_set.destroy_when_not_in_use()
+    gc.destroy_when_not_in_use()
+
+
+def test_attach_during_wait():
+    context = rclpy.get_default_context()
+    with context.handle:
+        wake_gc = _rclpy.GuardCondition(context.handle)
+        gc = _rclpy.GuardCondition(context.handle)
+        wait_set = _rclpy.WaitSet(0, 0, 0, 0, 0, 0, context.handle)
+    wait_set.attach(wake_gc)
+    wait_set.rebuild()
+    waiting = threading.Event()
+
+    def wait():
+        with wait_set:
+            waiting.set()
+            wait_set.wait(10 * 1000 * 1000 * 1000)
+
+    thread = threading.Thread(target=wait)
+    thread.start()
+    waiting.wait()
+    time.sleep(0.1)
+
+    # Attaching and detaching don't wait for the end of the wait
+    start = time.monotonic()
+    wait_set.attach(gc)
+    wait_set.detach(gc)
+    assert time.monotonic() - start < 5
+    assert thread.is_alive()
+
+    with wake_gc:
+        wake_gc.trigger_guard_condition()
+    thread.join(timeout=30)
+    assert not thread.is_alive()
+
+    wait_set.destroy_when_not_in_use()
+    wake_gc.destroy_when_not_in_use()
+    gc.destroy_when_not_in_use()
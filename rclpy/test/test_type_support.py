@@ -17,6 +17,9 @@ import pytest
 from rclpy import type_support
 from rclpy.exceptions import NoTypeSupportImportedException
 
+from test_msgs.msg import Arrays
+from test_msgs.msg import BasicTypes
+from test_msgs.msg import Builtins
 from test_msgs.msg import Strings
 from test_msgs.srv import Empty
 
@@ -52,3 +55,19 @@ def test_check_valid_srv_type():
     type_support.check_is_valid_srv_type(Empty)
     with pytest.raises(RuntimeError):
         type_support.check_is_valid_srv_type(Strings)
+
+
+def test_get_message_dtype():
+    dtype = type_support.get_message_dtype(BasicTypes)
+    assert list(dtype.names) == list(BasicTypes.get_fields_and_field_types())
+    assert dtype['float64_value'].kind == 'f'
+    assert dtype['uint64_value'].itemsize == 8
+
+    dtype = type_support.get_message_dtype(Builtins)
+    assert list(dtype['time_value'].names) == ['sec', 'nanosec']
+
+    with pytest.raises(ValueError):
+        type_support.get_message_dtype(Strings)
+    # Arrays of strings don't have a fixed size
+    with pytest.raises(ValueError):
+        type_support.get_message_dtype(Arrays)